@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Benchmarks of reading and converting synthetic mrc files.
+ *
+ * Prints one JSON object per line to stdout: a "meta" record describing the run,
+ * then one "case" record per file layout. Two such outputs are compared with --compare.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "mrc/mrcfile.h"
+#include "syntheticmrc.h"
+#include "util/parallel.h"
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+//! Header parses are repeated for at least this long to time them.
+constexpr double headerSeconds_c = 0.05;
+
+struct BenchOptions
+{
+    BenchOptions() : converter(MRCBENCH_CONVERTER), directory("/tmp"), sizes {{64, 128, 256, 512}}, variantSize(128),
+                     repeat(3), cold(false), keep(false) {}
+    std::string         converter;   //!< the mrctoinviwo executable
+    std::string         directory;   //!< where the synthetic files are written
+    std::vector<size_t> sizes;       //!< edge lengths of the float32 volumes of the size sweep
+    size_t              variantSize; //!< edge length of the volumes that vary mode, byte order, extended header and axis order
+    size_t              repeat;      //!< repetitions of each timing, the best is reported
+    bool                cold;        //!< evict the file from the page cache before each read
+    bool                keep;        //!< keep the synthetic files
+};
+
+double seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//! Drop the cached pages of a file, so the next read comes from disk.
+void evict_from_cache(const std::string & filename)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+//! Median time in microseconds to open a file and parse its header.
+double header_parse_us(const std::string & filename)
+{
+    std::vector<double> times;
+    const Clock::time_point begin = Clock::now();
+    while (times.size() < 5 || seconds_since(begin) < headerSeconds_c)
+    {
+        const Clock::time_point start = Clock::now();
+        const MrcFileView       view(filename, MrcFileView::DataAccess::HeaderOnly);
+        times.push_back(seconds_since(start) * 1e6);
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+//! Best throughput in GB/s of reading the voxel data, touching every byte of a mapped view.
+double read_gbps(const std::string & filename, MrcFileView::DataAccess access, const BenchOptions &options, bool * mapped)
+{
+    double best = 0;
+    for (size_t run = 0; run < options.repeat; ++run)
+    {
+        if (options.cold)
+        {
+            evict_from_cache(filename);
+        }
+        const Clock::time_point start = Clock::now();
+        const MrcFileView       view(filename, access);
+        const char *            data  = view.bytes().data();
+        const size_t            size  = view.bytes().size();
+        uint64_t                check = 0;
+        for (size_t i = 0; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            check += word;
+        }
+        const double elapsed = seconds_since(start);
+        // keeps the loop from being optimized away
+        if (check == 1)
+        {
+            fprintf(stderr, " ");
+        }
+        *mapped = view.isMapped();
+        best    = std::max(best, elapsed > 0 ? double(size) / elapsed / 1e9 : 0);
+    }
+    return best;
+}
+
+struct ProcessCost
+{
+    double   seconds;
+    long     maxRssKb;
+};
+
+//! Best wall time and the peak resident set size of converting a file with the converter executable.
+ProcessCost run_converter(const std::string & filename, const std::vector<std::string> &arguments, const BenchOptions &options)
+{
+    ProcessCost best = { std::numeric_limits<double>::infinity(), 0 };
+    for (size_t run = 0; run < options.repeat; ++run)
+    {
+        if (options.cold)
+        {
+            evict_from_cache(filename);
+        }
+        std::vector<std::string> argv { options.converter };
+        argv.insert(argv.end(), arguments.begin(), arguments.end());
+        argv.push_back(filename);
+        std::vector<char *> args;
+        for (std::string &argument : argv)
+        {
+            args.push_back(&argument[0]);
+        }
+        args.push_back(nullptr);
+
+        const Clock::time_point start = Clock::now();
+        const pid_t             child = fork();
+        if (child == 0)
+        {
+            const int null = open("/dev/null", O_WRONLY);
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+            execv(args[0], args.data());
+            _exit(127);
+        }
+        if (child < 0)
+        {
+            throw std::runtime_error("Cannot start \"" + options.converter + "\".");
+        }
+        int           status;
+        struct rusage usage;
+        if (wait4(child, &status, 0, &usage) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            throw std::runtime_error("\"" + options.converter + "\" failed to convert \"" + filename + "\".");
+        }
+        const double elapsed = seconds_since(start);
+        best.seconds  = std::min(best.seconds, elapsed);
+        best.maxRssKb = std::max(best.maxRssKb, long(usage.ru_maxrss));
+    }
+    std::remove((filename + ".raw").c_str());
+    std::remove((filename + ".dat").c_str());
+    return best;
+}
+
+std::string json_number(double value)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+void bench_case(const SyntheticMrc &layout, const std::string & group, const BenchOptions &options)
+{
+    const std::string filename = options.directory + "/mrcbench-" + layout.name() + ".mrc";
+    fprintf(stderr, "%s\n", layout.name().c_str());
+    writeSyntheticMrc(filename, layout);
+
+    bool         mapped     = false;
+    bool         decoded    = false;
+    const double headerUs   = header_parse_us(filename);
+    const double decodeGbps = read_gbps(filename, MrcFileView::DataAccess::Decode, options, &decoded);
+    const double mapGbps    = read_gbps(filename, MrcFileView::DataAccess::MapIfPossible, options, &mapped);
+    const ProcessCost convert = run_converter(filename, {}, options);
+    const ProcessCost stream  = run_converter(filename, {"--stream"}, options);
+    if (!options.keep)
+    {
+        std::remove(filename.c_str());
+    }
+
+    printf("{\"record\":\"case\",\"case\":\"%s\",\"group\":\"%s\",\"size\":[%zu,%zu,%zu],\"mode\":%d,"
+           "\"endian\":\"%s\",\"ext_header_bytes\":%zu,\"axis_order\":[%d,%d,%d],\"data_bytes\":%zu,"
+           "\"header_parse_us\":%s,\"read_decode_gbps\":%s,\"read_map_gbps\":%s,\"mapped\":%s,"
+           "\"convert_s\":%s,\"convert_rss_kb\":%ld,\"stream_s\":%s,\"stream_rss_kb\":%ld}\n",
+           layout.name().c_str(), group.c_str(), layout.size[0], layout.size[1], layout.size[2], layout.mode,
+           layout.bigEndian ? "big" : "little", layout.extendedHeaderBytes,
+           layout.axisOrder[0], layout.axisOrder[1], layout.axisOrder[2], layout.dataBytes(),
+           json_number(headerUs).c_str(), json_number(decodeGbps).c_str(), json_number(mapGbps).c_str(), mapped ? "true" : "false",
+           json_number(convert.seconds).c_str(), convert.maxRssKb, json_number(stream.seconds).c_str(), stream.maxRssKb);
+    fflush(stdout);
+}
+
+void run_benchmarks(const BenchOptions &options)
+{
+    printf("{\"record\":\"meta\",\"bench\":\"mrcbench\",\"version\":1,\"threads\":%zu,\"repeat\":%zu,\"cache\":\"%s\"}\n",
+           hardwareThreads(), options.repeat, options.cold ? "cold" : "warm");
+    for (size_t size : options.sizes)
+    {
+        SyntheticMrc layout;
+        layout.size = {{ size, size, size }};
+        bench_case(layout, "size", options);
+    }
+    for (int mode : {0, 1, 2, 6, 12})
+    {
+        for (bool bigEndian : {false, true})
+        {
+            for (size_t extendedHeaderBytes : {size_t(0), size_t(4096)})
+            {
+                for (const std::array<int, 3> &axisOrder : { std::array<int, 3> {{1, 2, 3}}, std::array<int, 3> {{3, 1, 2}} })
+                {
+                    SyntheticMrc layout;
+                    layout.size                = {{ options.variantSize, options.variantSize, options.variantSize }};
+                    layout.mode                = mode;
+                    layout.bigEndian           = bigEndian;
+                    layout.extendedHeaderBytes = extendedHeaderBytes;
+                    layout.axisOrder           = axisOrder;
+                    bench_case(layout, "layout", options);
+                }
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Comparison of two result files
+ */
+
+typedef std::map<std::string, std::string> Record;
+
+//! Parse the flat string, number and boolean fields of a record written by this program; arrays are skipped.
+Record parse_record(const std::string & line)
+{
+    Record record;
+    size_t position = 0;
+    while ((position = line.find('"', position)) != std::string::npos)
+    {
+        const size_t keyEnd = line.find('"', position + 1);
+        if (keyEnd == std::string::npos || keyEnd + 1 >= line.size() || line[keyEnd + 1] != ':')
+        {
+            break;
+        }
+        const std::string key   = line.substr(position + 1, keyEnd - position - 1);
+        size_t            begin = keyEnd + 2;
+        size_t            end;
+        if (line[begin] == '"')
+        {
+            end = line.find('"', begin + 1);
+            record[key] = line.substr(begin + 1, end - begin - 1);
+            ++end;
+        }
+        else if (line[begin] == '[')
+        {
+            end = line.find(']', begin) + 1;
+        }
+        else
+        {
+            end = line.find_first_of(",}", begin);
+            record[key] = line.substr(begin, end - begin);
+        }
+        position = end;
+    }
+    return record;
+}
+
+std::map<std::string, Record> read_cases(const std::string & filename)
+{
+    std::ifstream input(filename);
+    if (!input)
+    {
+        throw std::runtime_error("Cannot open \"" + filename + "\".");
+    }
+    std::map<std::string, Record> cases;
+    std::string                   line;
+    while (std::getline(input, line))
+    {
+        Record record = parse_record(line);
+        if (record["record"] == "case")
+        {
+            cases[record["case"]] = record;
+        }
+    }
+    return cases;
+}
+
+//! Print the change of every metric; returns the number of changes worse than threshold percent.
+size_t compare_results(const std::string & baseline, const std::string & current, double threshold)
+{
+    struct Metric
+    {
+        const char * key;
+        bool         higherIsBetter;
+    };
+    const Metric metrics[] = {
+        {"header_parse_us", false}, {"read_decode_gbps", true}, {"read_map_gbps", true},
+        {"convert_s", false}, {"convert_rss_kb", false}, {"stream_s", false}, {"stream_rss_kb", false}
+    };
+    const std::map<std::string, Record> before = read_cases(baseline);
+    const std::map<std::string, Record> after  = read_cases(current);
+    size_t                              numRegressions = 0;
+    printf("%-40s %-18s %12s %12s %8s\n", "case", "metric", "baseline", "current", "change");
+    for (const std::pair<const std::string, Record> &entry : after)
+    {
+        const auto old = before.find(entry.first);
+        if (old == before.end())
+        {
+            continue;
+        }
+        for (const Metric &metric : metrics)
+        {
+            const auto oldValue = old->second.find(metric.key);
+            const auto newValue = entry.second.find(metric.key);
+            if (oldValue == old->second.end() || newValue == entry.second.end())
+            {
+                continue;
+            }
+            const double a      = std::atof(oldValue->second.c_str());
+            const double b      = std::atof(newValue->second.c_str());
+            const double change = a != 0 ? (b - a) / a * 100 : 0;
+            const bool   worse  = metric.higherIsBetter ? change < -threshold : change > threshold;
+            numRegressions += worse ? 1 : 0;
+            printf("%-40s %-18s %12.6g %12.6g %+7.1f%%%s\n", entry.first.c_str(), metric.key, a, b, change, worse ? "  worse" : "");
+        }
+    }
+    return numRegressions;
+}
+
+/*******************************************************************************
+ * Command line
+ */
+
+void print_usage(const char * program)
+{
+	fprintf(stderr,
+	        "Usage: %s [options]\n"
+	        "       %s --compare <baseline.jsonl> <current.jsonl> [--threshold <percent>]\n"
+	        "Writes synthetic mrc files, times reading and converting them and prints one JSON object per line.\n"
+	        "Options:\n"
+	        "  --converter <path>   mrctoinviwo executable to time (default %s)\n"
+	        "  --dir <directory>    where to write the synthetic files (default /tmp)\n"
+	        "  --sizes <n,n,...>    edge lengths of the float32 size sweep (default 64,128,256,512, up to 1024)\n"
+	        "  --variant-size <n>   edge length of the files varying mode, byte order, extended header and axis order (default 128)\n"
+	        "  --repeat <n>         repetitions of each timing, the best is reported (default 3)\n"
+	        "  --cold               evict files from the page cache before each timed read\n"
+	        "  --keep               keep the synthetic files\n"
+	        "  --threshold <p>      with --compare, report changes worse than p percent (default 10)\n",
+	        program, program, MRCBENCH_CONVERTER);
+}
+
+size_t parse_count(const char * option, const char * value)
+{
+	char * end = nullptr;
+	const long count = value != nullptr ? strtol(value, &end, 10) : 0;
+	if (value == nullptr || *end != '\0' || count < 1)
+	{
+		throw std::runtime_error(std::string(option) + " expects a positive number.");
+	}
+	return count;
+}
+
+std::vector<size_t> parse_sizes(const char * option, const char * value)
+{
+	std::vector<size_t> sizes;
+	std::string         text(value != nullptr ? value : "");
+	size_t              begin = 0;
+	while (begin <= text.size())
+	{
+		const size_t end = std::min(text.find(',', begin), text.size());
+		sizes.push_back(parse_count(option, text.substr(begin, end - begin).c_str()));
+		begin = end + 1;
+	}
+	return sizes;
+}
+
+}   // namespace
+
+int main(int argc, const char *argv[]) try {
+
+	BenchOptions options;
+	std::vector<std::string> compare;
+	double threshold = 10;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string argument(argv[i]);
+		const char *      value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (argument == "--converter" && value != nullptr)
+		{
+			options.converter = value;
+			++i;
+		}
+		else if (argument == "--dir" && value != nullptr)
+		{
+			options.directory = value;
+			++i;
+		}
+		else if (argument == "--sizes")
+		{
+			options.sizes = parse_sizes(argv[i], value);
+			++i;
+		}
+		else if (argument == "--variant-size")
+		{
+			options.variantSize = parse_count(argv[i], value);
+			++i;
+		}
+		else if (argument == "--repeat")
+		{
+			options.repeat = parse_count(argv[i], value);
+			++i;
+		}
+		else if (argument == "--cold")
+		{
+			options.cold = true;
+		}
+		else if (argument == "--keep")
+		{
+			options.keep = true;
+		}
+		else if (argument == "--compare" && i + 2 < argc)
+		{
+			compare = { argv[i + 1], argv[i + 2] };
+			i += 2;
+		}
+		else if (argument == "--threshold" && value != nullptr)
+		{
+			threshold = std::atof(value);
+			++i;
+		}
+		else
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (!compare.empty())
+	{
+		const size_t numRegressions = compare_results(compare[0], compare[1], threshold);
+		fprintf(stderr, "%zu metrics worse by more than %g%%\n", numRegressions, threshold);
+		return numRegressions > 0 ? 2 : 0;
+	}
+	run_benchmarks(options);
+	return 0;
+} catch (const std::exception & e) {
+	fprintf(stderr,"Error: %s\n", e.what());
+	return 1;
+}
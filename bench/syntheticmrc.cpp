@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "syntheticmrc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "util/byteswap.h"
+#include "util/dataformat.h"
+#include "util/posixfile.h"
+
+namespace
+{
+
+constexpr size_t headerBytes_c = 1024;
+
+bool host_is_big_endian()
+{
+    const uint32_t one = 1;
+    unsigned char  first;
+    std::memcpy(&first, &one, 1);
+    return first == 0;
+}
+
+size_t mode_bytes(int mode)
+{
+    switch (mode)
+    {
+        case 0:  return 1;
+        case 1:  return 2;
+        case 2:  return 4;
+        case 6:  return 2;
+        case 12: return 2;
+        default: throw std::runtime_error("Synthetic mrc files support modes 0, 1, 2, 6 and 12.");
+    }
+}
+
+const char * mode_name(int mode)
+{
+    switch (mode)
+    {
+        case 0:  return "int8";
+        case 1:  return "int16";
+        case 2:  return "float32";
+        case 6:  return "uint16";
+        case 12: return "float16";
+        default: return "unknown";
+    }
+}
+
+//! A smooth profile in [-1, 1] along an axis of n voxels.
+std::vector<double> axis_profile(size_t n, double periods, double phase)
+{
+    std::vector<double> profile(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        profile[i] = std::sin(2 * M_PI * periods * double(i) / double(std::max<size_t>(n, 1)) + phase);
+    }
+    return profile;
+}
+
+//! Store the density value in the type of the mode and return the stored value.
+double store_value(double density, int mode, char * target)
+{
+    switch (mode)
+    {
+        case 0:
+        {
+            const int8_t value = int8_t(std::lround(density * 40));
+            std::memcpy(target, &value, sizeof(value));
+            return value;
+        }
+        case 1:
+        {
+            const int16_t value = int16_t(std::lround(density * 10000));
+            std::memcpy(target, &value, sizeof(value));
+            return value;
+        }
+        case 6:
+        {
+            const uint16_t value = uint16_t(std::lround((density + 3) * 10000));
+            std::memcpy(target, &value, sizeof(value));
+            return value;
+        }
+        case 12:
+        {
+            const uint16_t value = floatToHalf(float(density));
+            std::memcpy(target, &value, sizeof(value));
+            return halfToFloat(value);
+        }
+        default:
+        {
+            const float value = float(density);
+            std::memcpy(target, &value, sizeof(value));
+            return value;
+        }
+    }
+}
+
+template <typename T>
+void put(std::vector<char> * header, size_t word, T value, bool swap)
+{
+    if (swap)
+    {
+        value = swapBytes(value);
+    }
+    std::memcpy(header->data() + 4 * word, &value, sizeof(value));
+}
+
+}   // namespace
+
+std::string SyntheticMrc::name() const
+{
+    static const char axes[] = "xyz";
+    std::string       order;
+    for (int axis : axisOrder)
+    {
+        order += (axis >= 1 && axis <= 3) ? axes[axis - 1] : '?';
+    }
+    return std::to_string(size[0]) + "x" + std::to_string(size[1]) + "x" + std::to_string(size[2]) + "-" + mode_name(mode)
+           + (bigEndian ? "-be" : "-le") + "-ext" + std::to_string(extendedHeaderBytes) + "-" + order;
+}
+
+size_t SyntheticMrc::dataBytes() const
+{
+    return size[0] * size[1] * size[2] * mode_bytes(mode);
+}
+
+void writeSyntheticMrc(const std::string & filename, const SyntheticMrc &layout)
+{
+    std::array<int, 3> sorted = layout.axisOrder;
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted != std::array<int, 3> {{1, 2, 3}})
+    {
+        throw std::runtime_error("The axis order of a synthetic mrc file must be a permutation of 1, 2, 3.");
+    }
+    const size_t          valueBytes = mode_bytes(layout.mode);
+    const bool            swap       = layout.bigEndian != host_is_big_endian();
+    std::array<size_t, 3> numCrs;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        numCrs[i] = layout.size[layout.axisOrder[i] - 1];
+    }
+    const std::array<std::vector<double>, 3> profiles {{
+        axis_profile(layout.size[0], 1.5, 0.3), axis_profile(layout.size[1], 2.5, 1.1), axis_profile(layout.size[2], 0.5, 2.0)
+    }};
+
+    PosixFile         file(filename, PosixFile::Mode::Write);
+    std::vector<char> extendedHeader(layout.extendedHeaderBytes, 0);
+    file.writeAt(extendedHeader.data(), extendedHeader.size(), headerBytes_c);
+
+    double                minimum    = std::numeric_limits<double>::infinity();
+    double                maximum    = -std::numeric_limits<double>::infinity();
+    double                sum        = 0;
+    double                sumSquares = 0;
+    std::vector<char>     section(numCrs[0] * numCrs[1] * valueBytes);
+    std::array<size_t, 3> position;
+    for (size_t s = 0; s < numCrs[2]; ++s)
+    {
+        position[layout.axisOrder[2] - 1] = s;
+        char * target = section.data();
+        for (size_t r = 0; r < numCrs[1]; ++r)
+        {
+            position[layout.axisOrder[1] - 1] = r;
+            for (size_t c = 0; c < numCrs[0]; ++c, target += valueBytes)
+            {
+                position[layout.axisOrder[0] - 1] = c;
+                const double density = profiles[0][position[0]] + profiles[1][position[1]] + profiles[2][position[2]];
+                const double value   = store_value(density, layout.mode, target);
+                minimum     = std::min(minimum, value);
+                maximum     = std::max(maximum, value);
+                sum        += value;
+                sumSquares += value * value;
+            }
+        }
+        if (swap)
+        {
+            swapBytes(section.data(), numCrs[0] * numCrs[1], valueBytes);
+        }
+        file.writeAt(section.data(), section.size(), headerBytes_c + layout.extendedHeaderBytes + s * section.size());
+    }
+
+    const double      count = double(layout.size[0] * layout.size[1] * layout.size[2]);
+    const double      mean  = count > 0 ? sum / count : 0;
+    const double      rms   = count > 0 ? std::sqrt(std::max(sumSquares / count - mean * mean, 0.0)) : 0;
+    std::vector<char> header(headerBytes_c, 0);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        put(&header, i, int32_t(numCrs[i]), swap);
+        put(&header, 7 + i, int32_t(layout.size[i]), swap);
+        put(&header, 10 + i, float(layout.size[i]), swap);
+        put(&header, 13 + i, 90.0f, swap);
+        put(&header, 16 + i, int32_t(layout.axisOrder[i]), swap);
+    }
+    put(&header, 3, int32_t(layout.mode), swap);
+    put(&header, 19, float(count > 0 ? minimum : 0), swap);
+    put(&header, 20, float(count > 0 ? maximum : 0), swap);
+    put(&header, 21, float(mean), swap);
+    put(&header, 22, int32_t(1), swap);
+    put(&header, 23, int32_t(layout.extendedHeaderBytes), swap);
+    std::memcpy(header.data() + 4 * 52, "MAP ", 4);
+    const char stamp[4] = { layout.bigEndian ? '\x11' : '\x44', layout.bigEndian ? '\x11' : '\x41', 0, 0 };
+    std::memcpy(header.data() + 4 * 53, stamp, sizeof(stamp));
+    put(&header, 54, float(rms), swap);
+    put(&header, 55, int32_t(1), swap);
+    const std::string label = "mrcbench synthetic " + layout.name();
+    std::memcpy(header.data() + 4 * 56, label.data(), std::min<size_t>(label.size(), 80));
+    file.writeAt(header.data(), header.size(), 0);
+}
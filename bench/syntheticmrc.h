@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Synthetic mrc files for benchmarks.
+ */
+
+#ifndef SYNTHETICMRC_H_
+#define SYNTHETICMRC_H_
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+//! Layout of a synthetic mrc file.
+struct SyntheticMrc
+{
+    SyntheticMrc() : size {{64, 64, 64}}, mode(2), bigEndian(false), extendedHeaderBytes(0), axisOrder {{1, 2, 3}} {}
+    std::array<size_t, 3> size;                //!< voxels along x, y and z
+    int                   mode;                //!< mrc data mode, 0, 1, 2, 6 or 12
+    bool                  bigEndian;           //!< write big-endian instead of little-endian values
+    size_t                extendedHeaderBytes; //!< size of the extended header between header and data
+    std::array<int, 3>    axisOrder;           //!< MAPC, MAPR, MAPS, the axes, 1 to 3 for x to z, along columns, rows and sections
+
+    //! A short name that identifies the layout, e.g. 128x128x128-float32-le-ext0-xyz.
+    std::string name() const;
+    //! Number of bytes of the voxel data.
+    size_t dataBytes() const;
+};
+
+/*! \brief Write a synthetic mrc file with a smooth density.
+ *
+ * The values only depend on the x, y, z position, so files of any layout hold the
+ * same volume. The header records the correct density statistics.
+ * \throws std::runtime_error if writing fails or the layout is invalid
+ */
+void writeSyntheticMrc(const std::string & filename, const SyntheticMrc &layout);
+
+#endif /* end of include guard: SYNTHETICMRC_H_ */
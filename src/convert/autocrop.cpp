@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "autocrop.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "mrc/mrcheader.h"
+#include "util/parallel.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Voxels per parallel task; smaller slabs run on the calling thread.
+constexpr size_t voxelsPerTask_c = 1 << 18;
+
+//! Number of values above threshold; the loop has no branches, so it vectorizes.
+size_t count_above(const float * values, size_t count, float threshold)
+{
+    size_t numAbove = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        numAbove += values[i] > threshold;
+    }
+    return numAbove;
+}
+
+}   // namespace
+
+double cropThreshold(const MrcHeader &header, const CropOptions &options)
+{
+    if (!options.fromHeader)
+    {
+        return options.threshold;
+    }
+    if (!(header.rms_value > 0))
+    {
+        throw std::runtime_error("The header reports no rms to derive a crop threshold from, give the threshold instead.");
+    }
+    return header.mean_value + options.sigmas * header.rms_value;
+}
+
+BoundingBoxSink::BoundingBoxSink(const std::array<size_t, 3> &numCrs, double threshold) :
+    numCrs_(numCrs), threshold_(float(threshold)),
+    lower_({{ std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max() }}),
+    upper_({{ 0, 0, 0 }})
+{
+}
+
+void BoundingBoxSink::consume(const Slab & slab)
+{
+    ScopedStage  stage(Stage::Statistics, slab.data.size());
+    const size_t width       = std::max<size_t>(numCrs_[0], 1);
+    const size_t numRows     = slab.numSections * numCrs_[1];
+    const size_t rowsPerTask = std::max<size_t>(1, voxelsPerTask_c / width);
+    const size_t numTasks    = (numRows + rowsPerTask - 1) / rowsPerTask;
+    parallelFor(numTasks, [&](size_t task) {
+            search_rows_(slab, task * rowsPerTask, std::min(numRows, (task + 1) * rowsPerTask));
+        }, numTasks > 1 ? 0 : 1);
+}
+
+void BoundingBoxSink::search_rows_(const Slab & slab, size_t firstRow, size_t endRow)
+{
+    const size_t          width = numCrs_[0];
+    std::vector<float>    values(width);
+    std::array<size_t, 3> lower = lower_;
+    std::array<size_t, 3> upper = upper_;
+    bool                  found = false;
+    const auto            above = [this](float value) { return value > threshold_; };
+    for (size_t row = firstRow; row < endRow; ++row)
+    {
+        toFloat(slab.data.data() + row * width * formatBytes(slab.format), slab.format, values.data(), width);
+        // most rows of a padded map hold only background, so count first and search only rows with hits
+        if (count_above(values.data(), width, threshold_) == 0)
+        {
+            continue;
+        }
+        const size_t first   = std::find_if(values.begin(), values.end(), above) - values.begin();
+        const size_t last    = width - 1 - (std::find_if(values.rbegin(), values.rend(), above) - values.rbegin());
+        const size_t y       = row % numCrs_[1];
+        const size_t section = slab.firstSection + row / numCrs_[1];
+        lower = {{ std::min(lower[0], first), std::min(lower[1], y), std::min(lower[2], section) }};
+        upper = {{ std::max(upper[0], last), std::max(upper[1], y), std::max(upper[2], section) }};
+        found = true;
+    }
+    if (found)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t crs = 0; crs < 3; ++crs)
+        {
+            lower_[crs] = std::min(lower_[crs], lower[crs]);
+            upper_[crs] = std::max(upper_[crs], upper[crs]);
+        }
+    }
+}
+
+GridRegion findCropRegion(const std::string & filename, const SlabPipeline::Options &pipelineOptions, const CropOptions &options)
+{
+    SlabPipeline::Options searchOptions = pipelineOptions;
+    // the box does not depend on the order of the values
+    searchOptions.reorderAxes = false;
+    SlabPipeline    pipeline(filename, searchOptions);
+    const double    threshold = cropThreshold(pipeline.header(), options);
+    BoundingBoxSink boundingBox(mrcNumCrs(pipeline.header()), threshold);
+    pipeline.addSink(&boundingBox);
+    pipeline.run();
+    if (boundingBox.isEmpty())
+    {
+        std::ostringstream message;
+        message << "No voxel of \"" << filename << "\" lies above the crop threshold " << threshold << ".";
+        throw std::runtime_error(message.str());
+    }
+
+    const std::array<size_t, 3> gridSize = mrcGridSize(pipeline.header());
+    GridRegion                  region;
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        const int dim     = pipeline.header().crs_to_xyz[crs];
+        region.begin[dim] = boundingBox.lower()[crs] - std::min(boundingBox.lower()[crs], options.margin);
+        region.size[dim]  = std::min(boundingBox.upper()[crs] + options.margin + 1, gridSize[dim]) - region.begin[dim];
+    }
+    return region;
+}
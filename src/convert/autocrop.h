@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Bounding box of the voxels above a threshold, to crop the background around a molecule.
+ */
+
+#ifndef AUTOCROP_H_
+#define AUTOCROP_H_
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+#include "convert/slab.h"
+#include "convert/slabpipeline.h"
+#include "mrc/mrcgrid.h"
+
+struct MrcHeader;
+
+//! Which voxels a cropped volume keeps.
+struct CropOptions
+{
+    CropOptions() : fromHeader(true), sigmas(3), threshold(0), margin(1) {}
+    bool   fromHeader; //!< take the threshold from the mean and rms in the mrc header
+    double sigmas;     //!< the threshold is mean + sigmas * rms, if fromHeader is set
+    double threshold;  //!< the box holds all voxels above this value, unless fromHeader is set
+    size_t margin;     //!< voxels kept around the box, so values interpolate smoothly up to its faces
+};
+
+/*! \brief The value above which voxels are kept.
+ *
+ * \throws std::runtime_error if the threshold shall follow from the header, but the header reports no rms
+ */
+double cropThreshold(const MrcHeader &header, const CropOptions &options);
+
+/*! \brief Finds the bounding box of the voxels above a threshold in the slabs it consumes.
+ *
+ * Slabs are expected in column, row, section order, as stored. The rows of each slab
+ * are searched on all threads. NaN values are never above the threshold.
+ */
+class BoundingBoxSink : public SlabSink
+{
+public:
+    BoundingBoxSink(const std::array<size_t, 3> &numCrs, double threshold);
+
+    void consume(const Slab & slab) override;
+
+    //! True if no voxel lies above the threshold.
+    bool isEmpty() const { return lower_[0] > upper_[0]; }
+    //! Smallest column, row and section of a voxel above the threshold.
+    const std::array<size_t, 3> &lower() const { return lower_; }
+    //! Largest column, row and section of a voxel above the threshold.
+    const std::array<size_t, 3> &upper() const { return upper_; }
+
+private:
+    //! Widen the box to cover the voxels above the threshold in rows [firstRow, endRow) of slab.
+    void search_rows_(const Slab & slab, size_t firstRow, size_t endRow);
+
+    std::array<size_t, 3> numCrs_;
+    float                 threshold_;
+    std::array<size_t, 3> lower_;
+    std::array<size_t, 3> upper_;
+    std::mutex            mutex_;
+};
+
+/*! \brief The smallest region of the grid that holds all voxels above the threshold, widened by the margin.
+ *
+ * Streams the file once, without reordering axes.
+ * \throws std::runtime_error if no voxel lies above the threshold
+ */
+GridRegion findCropRegion(const std::string & filename, const SlabPipeline::Options &pipelineOptions, const CropOptions &options);
+
+#endif /* end of include guard: AUTOCROP_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Implements the tiled 3D transpose.
+ */
+#include "axisorder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "util/parallel.h"
+
+namespace
+{
+
+//! Edge length of the cubic tiles; 32^3 four-byte values in and out fit into L2 cache.
+constexpr size_t tileEdge_c = 32;
+//! Spawning a thread only pays off for a couple of tiles.
+constexpr size_t minTilesPerThread_c = 8;
+
+template <typename T>
+void reorder_tiles(const void * crsData, void * xyzData, const std::array<size_t, 3> &numCrs,
+                   const std::array<int, 3> &crsToXyz, size_t numThreads)
+{
+    const T * in  = static_cast<const T *>(crsData);
+    T       * out = static_cast<T *>(xyzData);
+
+    // distance in the input between neighbouring voxels along x, y and z
+    const std::array<size_t, 3> crsStride = {{ 1, numCrs[0], numCrs[0] * numCrs[1] }};
+    std::array<size_t, 3>       stride;
+    std::array<size_t, 3>       size;
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        stride[crsToXyz[crs]] = crsStride[crs];
+        size[crsToXyz[crs]]   = numCrs[crs];
+    }
+
+    std::array<size_t, 3> numTiles;
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        numTiles[dim] = (size[dim] + tileEdge_c - 1) / tileEdge_c;
+    }
+    const size_t totalTiles = numTiles[0] * numTiles[1] * numTiles[2];
+    numThreads = std::min(numThreads == 0 ? threadBudget() : numThreads,
+                          (totalTiles + minTilesPerThread_c - 1) / minTilesPerThread_c);
+
+    parallelFor(totalTiles, [&](size_t tile) {
+                    const size_t x0 = (tile % numTiles[0]) * tileEdge_c;
+                    const size_t y0 = (tile / numTiles[0] % numTiles[1]) * tileEdge_c;
+                    const size_t z0 = (tile / (numTiles[0] * numTiles[1])) * tileEdge_c;
+                    const size_t x1 = std::min(x0 + tileEdge_c, size[0]);
+                    const size_t y1 = std::min(y0 + tileEdge_c, size[1]);
+                    const size_t z1 = std::min(z0 + tileEdge_c, size[2]);
+                    for (size_t z = z0; z < z1; ++z)
+                    {
+                        for (size_t y = y0; y < y1; ++y)
+                        {
+                            const T * source      = in + y * stride[1] + z * stride[2];
+                            T       * destination = out + size[0] * (y + size[1] * z);
+                            for (size_t x = x0; x < x1; ++x)
+                            {
+                                destination[x] = source[x * stride[0]];
+                            }
+                        }
+                    }
+                }, numThreads);
+}
+
+}   // namespace
+
+bool sectionsRunAlongZ(const std::array<int, 3> &crsToXyz)
+{
+    return crsToXyz[2] == 2;
+}
+
+void reorderToXyz(const void * crsData, void * xyzData, const std::array<size_t, 3> &numCrs,
+                  const std::array<int, 3> &crsToXyz, size_t valueBytes, size_t numThreads)
+{
+    if (crsToXyz[0] == 0 && crsToXyz[1] == 1 && crsToXyz[2] == 2)
+    {
+        std::memcpy(xyzData, crsData, numCrs[0] * numCrs[1] * numCrs[2] * valueBytes);
+        return;
+    }
+    switch (valueBytes)
+    {
+        case 1: reorder_tiles<uint8_t>(crsData, xyzData, numCrs, crsToXyz, numThreads); break;
+        case 2: reorder_tiles<uint16_t>(crsData, xyzData, numCrs, crsToXyz, numThreads); break;
+        case 4: reorder_tiles<uint32_t>(crsData, xyzData, numCrs, crsToXyz, numThreads); break;
+        case 8: reorder_tiles<uint64_t>(crsData, xyzData, numCrs, crsToXyz, numThreads); break;
+        default: throw std::logic_error("Cannot reorder voxels of this size.");
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Reordering of voxel data from column, row, section order to x, y, z order.
+ */
+
+#ifndef AXISORDER_H_
+#define AXISORDER_H_
+
+#include <array>
+#include <cstddef>
+
+//! True if the sections run along z, so each slab of sections is a slab of the x, y, z ordered volume.
+bool sectionsRunAlongZ(const std::array<int, 3> &crsToXyz);
+
+/*! \brief Reorder voxels from column, row, section order to x fastest, then y, then z.
+ *
+ * A 3D transpose over cache-sized tiles of the output, so the strided reads of a tile
+ * stay in cache; tiles are distributed over threads.
+ * \param[in] crsData voxels with columns fastest, then rows, then sections
+ * \param[out] xyzData same number of voxels, must not overlap crsData
+ * \param[in] numCrs number of columns, rows and sections
+ * \param[in] crsToXyz the axis (0 = x, 1 = y, 2 = z) along which columns, rows and sections run
+ * \param[in] valueBytes size of a voxel value, 1, 2, 4 or 8 bytes
+ * \param[in] numThreads number of threads, zero for threadBudget()
+ */
+void reorderToXyz(const void * crsData, void * xyzData, const std::array<size_t, 3> &numCrs,
+                  const std::array<int, 3> &crsToXyz, size_t valueBytes, size_t numThreads = 0);
+
+#endif /* end of include guard: AXISORDER_H_ */
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "convert/axisorder.h"
+#include "convert/converter.h"
+#include "convert/slab.h"
+#include "convert/slabdecoder.h"
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcgrid.h"
+#include "mrc/mrcheader.h"
+#include "util/bufferpool.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+#include "util/threadpool.h"
+#include "util/valuestatistics.h"
+
+namespace
+{
+
+//! Sections are grouped into tasks of about this many bytes.
+constexpr size_t taskBytes_c = 32 << 20;
+
+//! State shared by the section tasks of one file.
+struct FileJob
+{
+    FileJob(const std::string &name, const MrcFileView &view, const ConversionOptions &options) :
+        filename(name),
+        header(view.header()),
+        dataOffset(view.dataOffset()),
+        decoder(view.header(), options.pipeline.widenToFloat, options.pipeline.reorderAxes),
+        input(name, PosixFile::Mode::Read),
+        output(outputBaseName(name, options) + ".raw", PosixFile::Mode::Write),
+        remaining(0),
+        failed(false),
+        statistics(isIntegerFormat(decoder.format()))
+    {
+    }
+
+    std::string                  filename;
+    MrcHeader                    header;
+    size_t                       dataOffset;
+    SlabDecoder                  decoder;
+    PosixFile                    input;
+    PosixFile                    output;
+    std::atomic<size_t>          remaining;
+    std::atomic<bool>            failed;
+    std::mutex                   errorMutex;
+    std::string                  error;
+    std::mutex                   statisticsMutex;
+    ValueStatistics              statistics; //!< merged statistics of the finished tasks
+    std::unique_ptr<StageReport> report;     //!< stages of opening the file and of all tasks, if the options ask for a report
+};
+
+class Batch
+{
+    public:
+        Batch(const ConversionOptions &options, size_t numThreads, const std::function<void(const std::string &)> &converted) :
+            options_(options), converted_(converted), pool_(numThreads), failures_(0) {}
+
+        //! Share the threads of the pool between the files converted at once, for the loops of files that are not split.
+        void share_threads_(size_t numFiles);
+
+        void convert_file_(const std::string &filename);
+        void convert_sections_(const std::shared_ptr<FileJob> &job, size_t firstSection, size_t numSections);
+        void report_failure_(const std::string &filename, const std::string &error);
+
+        ConversionOptions        options_;
+        const std::function<void(const std::string &)> &converted_;
+        ThreadPool               pool_;
+        std::atomic<size_t>      failures_;
+        std::mutex               reportMutex_;
+};
+
+void Batch::share_threads_(size_t numFiles)
+{
+    if (options_.numThreads == 0)
+    {
+        const size_t numWorkers = pool_.numThreads();
+        options_.numThreads     = std::max<size_t>(numWorkers / std::max<size_t>(std::min(numFiles, numWorkers), 1), 1);
+    }
+}
+
+void Batch::report_failure_(const std::string &filename, const std::string &error)
+{
+    ++failures_;
+    std::lock_guard<std::mutex> lock(reportMutex_);
+    fprintf(stderr, "Error converting \"%s\": %s\n", filename.c_str(), error.c_str());
+}
+
+void Batch::convert_file_(const std::string &filename)
+{
+    try
+    {
+        std::unique_ptr<StageReport> report(options_.reportStages ? new StageReport : nullptr);
+        ReportScope                  scope(report.get());
+        const MrcFileView view(filename, MrcFileView::DataAccess::HeaderOnly);
+        // sections of compressed files cannot be read independently, quantized ranges may depend on all values,
+        // sequences already write their volumes concurrently, stored data that is kept needs no decoding at all,
+        // Fourier maps are expanded from sections at both ends of the file
+        const bool        splittable = !options_.streaming && !options_.split && !options_.hasRegion && !options_.autoCrop
+            && !hasDerivedOutputs(options_) && !options_.quantize && !view.source().isSequential() && !mrcIsComplex(view.header())
+            && !keepsStoredData(view, options_)
+            && (!options_.pipeline.reorderAxes || sectionsRunAlongZ(view.header().crs_to_xyz));
+        if (!splittable)
+        {
+            convertMrcToInviwo(filename, options_);
+            if (converted_)
+            {
+                converted_(filename);
+            }
+            return;
+        }
+
+        std::shared_ptr<FileJob> job = std::make_shared<FileJob>(filename, view, options_);
+        job->report = std::move(report);
+        const size_t             numSections     = mrcNumCrs(job->header)[2];
+        const size_t             sectionBytes    = std::max(job->decoder.storedSectionBytes(), job->decoder.sectionBytes());
+        const size_t             sectionsPerTask = std::max<size_t>(taskBytes_c / std::max<size_t>(sectionBytes, 1), 1);
+        const size_t             numTasks        = (numSections + sectionsPerTask - 1) / sectionsPerTask;
+        job->output.resize(numSections * job->decoder.sectionBytes());
+        if (numTasks == 0)
+        {
+            mrcDatFile(job->header, job->decoder.format(), job->output.filename()).write(outputBaseName(filename, options_) + ".dat");
+            if (converted_)
+            {
+                converted_(filename);
+            }
+            return;
+        }
+
+        job->remaining = numTasks;
+        // this worker runs its own tasks newest first, so submit the last sections first to read the file front to back
+        for (size_t task = numTasks; task-- > 0; )
+        {
+            const size_t first = task * sectionsPerTask;
+            const size_t count = std::min(sectionsPerTask, numSections - first);
+            pool_.submit([this, job, first, count] { convert_sections_(job, first, count); });
+        }
+    }
+    catch (const std::exception &e)
+    {
+        report_failure_(filename, e.what());
+    }
+}
+
+void Batch::convert_sections_(const std::shared_ptr<FileJob> &job, size_t firstSection, size_t numSections)
+{
+    ReportScope scope(job->report.get());
+    if (!job->failed)
+    {
+        try
+        {
+            Slab               slab;
+            slab.data   = BufferPool::shared().acquire(numSections * job->decoder.sectionBytes());
+            slab.stored = BufferPool::shared().acquire(0);
+            std::vector<char> &stored = job->decoder.prepare(&slab, firstSection, numSections);
+            {
+                ScopedStage stage(Stage::Read, stored.size());
+                job->input.readAt(stored.data(), stored.size(), job->dataOffset + firstSection * job->decoder.storedSectionBytes());
+            }
+            {
+                ScopedStage stage(Stage::Decode);
+                // the pool already keeps all threads busy
+                job->decoder.decode(&slab, 1);
+                stage.addBytes(slab.data.size());
+            }
+            {
+                ScopedStage stage(Stage::Write, slab.data.size());
+                job->output.writeAt(slab.data.data(), slab.data.size(), firstSection * job->decoder.sectionBytes());
+            }
+            if (options_.statistics)
+            {
+                ScopedStage           stage(Stage::Statistics, slab.data.size());
+                const ValueStatistics statistics = computeStatistics(slab.data.data(), slab.format, slab.data.size() / formatBytes(slab.format), 1);
+                std::lock_guard<std::mutex> lock(job->statisticsMutex);
+                job->statistics.merge(statistics);
+            }
+            BufferPool::shared().release(std::move(slab.data));
+            BufferPool::shared().release(std::move(slab.stored));
+        }
+        catch (const std::exception &e)
+        {
+            std::lock_guard<std::mutex> lock(job->errorMutex);
+            if (!job->failed)
+            {
+                job->error  = e.what();
+                job->failed = true;
+            }
+        }
+    }
+    if (--job->remaining > 0)
+    {
+        return;
+    }
+
+    if (job->failed)
+    {
+        report_failure_(job->filename, job->error);
+        return;
+    }
+    try
+    {
+        DatFile datFile = mrcDatFile(job->header, job->decoder.format(), job->output.filename());
+        if (options_.statistics)
+        {
+            applyStatistics(job->filename, job->header, job->statistics, options_, &datFile);
+        }
+        {
+            ScopedStage stage(Stage::Write);
+            datFile.write(outputBaseName(job->filename, options_) + ".dat");
+        }
+        if (converted_)
+        {
+            converted_(job->filename);
+        }
+        std::lock_guard<std::mutex> lock(reportMutex_);
+        fprintf(stderr, "Converted \"%s\"\n", job->filename.c_str());
+        if (job->report)
+        {
+            printf("%s\n", job->report->json(job->filename).c_str());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        report_failure_(job->filename, e.what());
+    }
+}
+
+}   // namespace
+
+size_t convertBatch(const std::vector<std::string> &filenames, const ConversionOptions &options, size_t numThreads,
+                    const std::function<void(const std::string &)> &converted)
+{
+    Batch batch(options, numThreads, converted);
+    batch.share_threads_(filenames.size());
+    for (const std::string &filename : filenames)
+    {
+        batch.pool_.submit([&batch, filename] { batch.convert_file_(filename); });
+    }
+    batch.pool_.wait();
+    return batch.failures_;
+}
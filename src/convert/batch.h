@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Conversion of many mrc files in one process.
+ */
+
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct ConversionOptions;
+
+/*! \brief Convert all files on a work-stealing thread pool.
+ *
+ * Every file becomes a task. Files whose sections can be decoded independently
+ * split into tasks of a few sections each, which decode their sections and write
+ * them with positioned writes, so idle threads help with the remaining large maps
+ * at the end of a batch. A failing file is reported and does not stop the batch.
+ * \param[in] numThreads number of worker threads, zero for all hardware threads
+ * \param[in] converted called with each file once it is converted, on any of the worker threads;
+ * if it throws, the file counts as failed
+ * \returns the number of files that could not be converted
+ */
+size_t convertBatch(const std::vector<std::string> &filenames, const ConversionOptions &options, size_t numThreads,
+                    const std::function<void(const std::string &)> &converted = {});
+
+#endif /* end of include guard: BATCH_H_ */
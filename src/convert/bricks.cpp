@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "bricks.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "util/parallel.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Index of the voxel of a volume with size voxels nearest to position.
+size_t clamp_to_volume(long position, size_t size)
+{
+    return size_t(std::min<long>(std::max<long>(position, 0), long(size) - 1));
+}
+
+}   // namespace
+
+BrickWriter::BrickWriter(const GridRegion &region, DataFormat format, const std::string &baseName, size_t brickSize, size_t border) :
+    region_(region), format_(format), indexFileName_(baseName + ".bricks.idx"), brickSize_(brickSize), border_(border),
+    storedSize_(brickSize + 2 * border), brickBytes_(storedSize_ * storedSize_ * storedSize_ * formatBytes(format)),
+    sectionBytes_(region.size[0] * region.size[1] * formatBytes(format)), file_(baseName + ".bricks.raw", PosixFile::Mode::Write),
+    windowBegin_(0), layer_(0), numConsumed_(0)
+{
+    if (brickSize == 0)
+    {
+        throw std::invalid_argument("Bricks need at least one voxel along each axis.");
+    }
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        numBricks_[dim] = (region.size[dim] + brickSize - 1) / brickSize;
+    }
+    const size_t numBricks = numBricks_[0] * numBricks_[1] * numBricks_[2];
+    if (numBricks > 0)
+    {
+        window_.resize(storedSize_ * sectionBytes_);
+        bricks_.resize(numBricks_[0] * brickBytes_);
+    }
+    index_.resize(numBricks);
+}
+
+void BrickWriter::consume(const Slab & slab)
+{
+    ScopedStage stage(Stage::Derived, slab.data.size());
+    if (index_.empty())
+    {
+        return;
+    }
+    for (size_t offset = 0; offset + sectionBytes_ <= slab.data.size(); offset += sectionBytes_)
+    {
+        const size_t z = numConsumed_++;
+        std::memcpy(window_.data() + (z + border_ - windowBegin_) * sectionBytes_, slab.data.data() + offset, sectionBytes_);
+        // near the end of the volume, the last section may complete several layers
+        while (layer_ < numBricks_[2] && z == std::min(layer_ * brickSize_ + brickSize_ + border_ - 1, region_.size[2] - 1))
+        {
+            emit_layer_();
+        }
+    }
+}
+
+void BrickWriter::gather_brick_(size_t bx, size_t by, char * brick) const
+{
+    const size_t voxelBytes = formatBytes(format_);
+    const size_t width      = region_.size[0];
+    const long   x0         = long(bx * brickSize_) - long(border_);
+    const size_t begin      = clamp_to_volume(x0, width);
+    const size_t end        = std::min<size_t>(x0 + storedSize_, width);
+    const size_t numLeft    = begin - x0;
+    const size_t numRight   = storedSize_ - numLeft - (end - begin);
+    for (size_t z = 0; z < storedSize_; ++z)
+    {
+        const size_t section = clamp_to_volume(long(layer_ * brickSize_ + z) - long(border_), region_.size[2]);
+        const char * slice   = window_.data() + (section + border_ - windowBegin_) * sectionBytes_;
+        for (size_t y = 0; y < storedSize_; ++y)
+        {
+            const char * row = slice + clamp_to_volume(long(by * brickSize_ + y) - long(border_), region_.size[1]) * width * voxelBytes;
+            for (size_t x = 0; x < numLeft; ++x, brick += voxelBytes)
+            {
+                std::memcpy(brick, row, voxelBytes);
+            }
+            std::memcpy(brick, row + begin * voxelBytes, (end - begin) * voxelBytes);
+            brick += (end - begin) * voxelBytes;
+            for (size_t x = 0; x < numRight; ++x, brick += voxelBytes)
+            {
+                std::memcpy(brick, row + (width - 1) * voxelBytes, voxelBytes);
+            }
+        }
+    }
+}
+
+void BrickWriter::emit_layer_()
+{
+    const size_t numVoxels = storedSize_ * storedSize_ * storedSize_;
+    for (size_t by = 0; by < numBricks_[1]; ++by)
+    {
+        const size_t firstBrick = (layer_ * numBricks_[1] + by) * numBricks_[0];
+        parallelFor(numBricks_[0], [&](size_t bx) {
+                char * brick = bricks_.data() + bx * brickBytes_;
+                gather_brick_(bx, by, brick);
+
+                std::vector<float> values(numVoxels);
+                toFloat(brick, format_, values.data(), numVoxels);
+                BrickIndexEntry &entry = index_[firstBrick + bx];
+                entry.offset = (firstBrick + bx) * brickBytes_;
+                entry.min    = std::numeric_limits<float>::infinity();
+                entry.max    = -std::numeric_limits<float>::infinity();
+                for (float value : values)
+                {
+                    // comparisons with NaN are false, so NaN values are skipped
+                    entry.min = value < entry.min ? value : entry.min;
+                    entry.max = value > entry.max ? value : entry.max;
+                }
+            });
+        file_.write(bricks_.data(), numBricks_[0] * brickBytes_);
+    }
+
+    // the borders of the next layer overlap this layer
+    std::memmove(window_.data(), window_.data() + brickSize_ * sectionBytes_, 2 * border_ * sectionBytes_);
+    windowBegin_ += brickSize_;
+    ++layer_;
+}
+
+void BrickWriter::finish()
+{
+    ScopedStage stage(Stage::Derived);
+    if (layer_ != numBricks_[2])
+    {
+        throw std::runtime_error("Volume ended before all bricks of \"" + file_.filename() + "\" were written.");
+    }
+    BrickIndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "MRCBRICK", sizeof(header.magic));
+    header.version   = 1;
+    header.brickSize = uint32_t(brickSize_);
+    header.border    = uint32_t(border_);
+    std::strncpy(header.format, formatName(format_), sizeof(header.format) - 1);
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        header.volumeSize[dim] = region_.size[dim];
+        header.numBricks[dim]  = numBricks_[dim];
+    }
+    PosixFile indexFile(indexFileName_, PosixFile::Mode::Write);
+    indexFile.write(&header, sizeof(header));
+    indexFile.write(index_.data(), index_.size() * sizeof(BrickIndexEntry));
+}
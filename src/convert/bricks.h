@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Bricked copy of a volume with an index, for renderers that page in parts of a volume.
+ */
+
+#ifndef BRICKS_H_
+#define BRICKS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "convert/slab.h"
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+#include "util/posixfile.h"
+
+/*! \brief Layout of the brick index file.
+ *
+ * The index starts with this header, followed by one BrickIndexEntry per brick,
+ * x fastest, then y, then z. All numbers are in the byte order of the writing machine.
+ */
+struct BrickIndexHeader
+{
+    char     magic[8];      //!< "MRCBRICK"
+    uint32_t version;       //!< layout version, currently 1
+    uint32_t brickSize;     //!< voxels along each axis of a brick, without border
+    uint32_t border;        //!< ghost voxels on each side of a brick
+    char     format[12];    //!< Inviwo name of the voxel type, zero padded
+    uint64_t volumeSize[3]; //!< voxels along x, y and z of the volume
+    uint64_t numBricks[3];  //!< bricks along x, y and z
+};
+
+//! Position and value range of a single brick.
+struct BrickIndexEntry
+{
+    uint64_t offset; //!< byte offset of the brick in the brick file
+    float    min;    //!< smallest value in the brick, including its border
+    float    max;    //!< largest value in the brick, including its border
+};
+
+/*! \brief Writes a volume as cubes of brickSize voxels, each padded with a ghost border.
+ *
+ * A stored brick holds brickSize + 2 * border voxels along each axis, x fastest, so
+ * bricks can be interpolated up to their faces without reading their neighbours.
+ * Border voxels and bricks reaching beyond the volume repeat the nearest voxel of the volume.
+ *
+ * Only the sections of one layer of bricks and their borders are held in memory.
+ * Consumed slabs must be ordered x fastest, then y, then z.
+ */
+class BrickWriter : public SlabSink
+{
+public:
+    /*! \brief Prepare writing baseName.bricks.raw and the index baseName.bricks.idx.
+     *
+     * \param[in] region the part of the mrc grid that is consumed
+     */
+    BrickWriter(const GridRegion &region, DataFormat format, const std::string &baseName, size_t brickSize, size_t border);
+
+    void consume(const Slab & slab) override;
+    //! Write the index.
+    void finish() override;
+
+    //! Number of bricks along x, y and z.
+    const std::array<size_t, 3> &numBricks() const { return numBricks_; }
+
+private:
+    //! Copy the bricks of the current layer into the brick file and slide the window to the next layer.
+    void emit_layer_();
+    //! Gather the brick at bx, by of the current layer into brick, with its border.
+    void gather_brick_(size_t bx, size_t by, char * brick) const;
+
+    GridRegion                   region_;
+    DataFormat                   format_;
+    std::string                  indexFileName_;
+    size_t                       brickSize_;
+    size_t                       border_;
+    size_t                       storedSize_;   //!< voxels along each axis of a stored brick
+    size_t                       brickBytes_;
+    size_t                       sectionBytes_;
+    std::array<size_t, 3>        numBricks_;
+    PosixFile                    file_;
+    std::vector<char>            window_;       //!< the sections of the current layer of bricks, including borders
+    size_t                       windowBegin_;  //!< z of the first section in the window, offset by border_
+    size_t                       layer_;        //!< z index of the layer of bricks being collected
+    size_t                       numConsumed_;
+    std::vector<char>            bricks_;       //!< a row of gathered bricks
+    std::vector<BrickIndexEntry> index_;
+};
+
+#endif /* end of include guard: BRICKS_H_ */
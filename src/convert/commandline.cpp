@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "commandline.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "convert/converter.h"
+
+namespace
+{
+
+RegionOfInterest parse_region(const char * option, const char * value, RegionOfInterest::Units units)
+{
+    RegionOfInterest region;
+    region.units = units;
+    char extra;
+    if (value == nullptr || sscanf(value, "%f,%f,%f,%f,%f,%f%c",
+                                   &region.lower[0], &region.lower[1], &region.lower[2],
+                                   &region.upper[0], &region.upper[1], &region.upper[2], &extra) != 6)
+    {
+        throw std::runtime_error(std::string(option) + " expects six comma separated numbers.");
+    }
+    return region;
+}
+
+PyramidWriter::Reduction parse_reduction(const char * option, const char * value)
+{
+    const std::string name(value != nullptr ? value : "");
+    if (name == "mean")
+    {
+        return PyramidWriter::Reduction::Mean;
+    }
+    if (name == "min")
+    {
+        return PyramidWriter::Reduction::Min;
+    }
+    if (name == "max")
+    {
+        return PyramidWriter::Reduction::Max;
+    }
+    throw std::runtime_error(std::string(option) + " expects mean, min or max.");
+}
+
+std::array<float, 3> parse_voxel_size(const char * option, const char * value)
+{
+    std::array<float, 3> size;
+    char                 extra;
+    const int            numRead = value != nullptr ? sscanf(value, "%f,%f,%f%c", &size[0], &size[1], &size[2], &extra) : 0;
+    if (numRead == 1)
+    {
+        size[1] = size[2] = size[0];
+    }
+    if ((numRead != 1 && numRead != 3) || !(size[0] > 0 && size[1] > 0 && size[2] > 0))
+    {
+        throw std::runtime_error(std::string(option) + " expects a positive voxel size or three comma separated ones.");
+    }
+    return size;
+}
+
+ResampleWriter::Filter parse_filter(const char * option, const char * value)
+{
+    const std::string name(value != nullptr ? value : "");
+    if (name == "trilinear")
+    {
+        return ResampleWriter::Filter::Trilinear;
+    }
+    if (name == "sinc")
+    {
+        return ResampleWriter::Filter::Sinc;
+    }
+    throw std::runtime_error(std::string(option) + " expects trilinear or sinc.");
+}
+
+GradientWriter::Stencil parse_stencil(const char * option, const char * value)
+{
+    const std::string name(value != nullptr ? value : "");
+    if (name == "central")
+    {
+        return GradientWriter::Stencil::Central;
+    }
+    if (name == "sobel")
+    {
+        return GradientWriter::Stencil::Sobel;
+    }
+    throw std::runtime_error(std::string(option) + " expects central or sobel.");
+}
+
+DataFormat parse_gradient_format(const char * option, const char * value)
+{
+    const std::string name(value != nullptr ? value : "");
+    if (name == "float16")
+    {
+        return DataFormat::FLOAT16;
+    }
+    if (name == "float32")
+    {
+        return DataFormat::FLOAT32;
+    }
+    if (name == "int8")
+    {
+        return DataFormat::INT8;
+    }
+    throw std::runtime_error(std::string(option) + " expects float16, float32 or int8.");
+}
+
+void parse_crop_threshold(const char * option, const char * value, CropOptions * crop)
+{
+    const std::string text(value != nullptr ? value : "");
+    char *            end = nullptr;
+    if (text.compare(0, 5, "sigma") == 0)
+    {
+        crop->fromHeader = true;
+        if (text.size() > 5)
+        {
+            crop->sigmas = strtod(text.c_str() + 6, &end);
+            if (text[5] != '=' || *end != '\0' || end == text.c_str() + 6)
+            {
+                throw std::runtime_error(std::string(option) + " expects a number after sigma=.");
+            }
+        }
+        return;
+    }
+    crop->fromHeader = false;
+    crop->threshold  = strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0')
+    {
+        throw std::runtime_error(std::string(option) + " expects a threshold or sigma[=k].");
+    }
+}
+
+FourierComponent parse_fourier_component(const char * option, const char * value)
+{
+    for (FourierComponent component : { FourierComponent::Amplitude, FourierComponent::Phase, FourierComponent::LogPower })
+    {
+        if (value != nullptr && fourierComponentName(component) == std::string(value))
+        {
+            return component;
+        }
+    }
+    throw std::runtime_error(std::string(option) + " expects amplitude, phase or log-power.");
+}
+
+DataFormat parse_quantized_format(const char * option, const char * value)
+{
+    const std::string name(value != nullptr ? value : "");
+    if (name == "uint8")
+    {
+        return DataFormat::UINT8;
+    }
+    if (name == "uint16")
+    {
+        return DataFormat::UINT16;
+    }
+    throw std::runtime_error(std::string(option) + " expects uint8 or uint16.");
+}
+
+void parse_quantization_range(const char * option, const char * value, QuantizationOptions * quantization)
+{
+    const std::string text(value != nullptr ? value : "");
+    const size_t      equals = text.find('=');
+    const std::string name   = text.substr(0, equals);
+    double            number = 0;
+    if (equals != std::string::npos)
+    {
+        char * end = nullptr;
+        number     = strtod(text.c_str() + equals + 1, &end);
+        if (*end != '\0' || end == text.c_str() + equals + 1 || !(number >= 0) || (name != "percentile" && name != "sigma"))
+        {
+            throw std::runtime_error(std::string(option) + " expects a non-negative number after percentile= or sigma=.");
+        }
+    }
+    if (name == "header")
+    {
+        quantization->range = QuantizationOptions::Range::Header;
+    }
+    else if (name == "measured")
+    {
+        quantization->range = QuantizationOptions::Range::Measured;
+    }
+    else if (name == "percentile")
+    {
+        quantization->range = QuantizationOptions::Range::Percentile;
+        if (equals != std::string::npos)
+        {
+            if (number >= 50)
+            {
+                throw std::runtime_error(std::string(option) + " expects a percentile below 50.");
+            }
+            quantization->percentile = number;
+        }
+    }
+    else if (name == "sigma")
+    {
+        quantization->range = QuantizationOptions::Range::Sigma;
+        if (equals != std::string::npos)
+        {
+            quantization->sigmas = number;
+        }
+    }
+    else
+    {
+        throw std::runtime_error(std::string(option) + " expects header, measured, percentile or sigma.");
+    }
+}
+
+}   // namespace
+
+size_t parseCount(const char * option, const char * value, long minimum)
+{
+    char * end = nullptr;
+    const long count = value != nullptr ? strtol(value, &end, 10) : 0;
+    if (value == nullptr || *end != '\0' || count < minimum)
+    {
+        throw std::runtime_error(std::string(option) + (minimum > 0 ? " expects a positive number." : " expects a non-negative number."));
+    }
+    return count;
+}
+
+bool parseConversionOption(const std::vector<std::string> &arguments, size_t * index, ConversionOptions * options)
+{
+    const std::string &argument = arguments[*index];
+    const char        *option   = argument.c_str();
+    const char        *value    = *index + 1 < arguments.size() ? arguments[*index + 1].c_str() : nullptr;
+    if (argument == "--stream")
+    {
+        options->streaming = true;
+        return true;
+    }
+    if (argument == "--widen")
+    {
+        options->pipeline.widenToFloat = true;
+        return true;
+    }
+    if (argument == "--no-statistics")
+    {
+        options->statistics = false;
+        return true;
+    }
+    if (argument == "--reference-mrc")
+    {
+        options->referenceMrc = true;
+        return true;
+    }
+    if (argument == "--fourier-full")
+    {
+        options->fourier.halfComplex = false;
+        return true;
+    }
+    if (argument == "--update-header")
+    {
+        options->updateHeader = true;
+        return true;
+    }
+    if (argument == "--stats")
+    {
+        options->reportStages = true;
+        return true;
+    }
+
+    // the remaining options take a value
+    if (argument == "--slabs")
+    {
+        options->pipeline.slabsInFlight = parseCount(option, value);
+    }
+    else if (argument == "--slab-sections")
+    {
+        options->pipeline.sectionsPerSlab = parseCount(option, value);
+    }
+    else if (argument == "--roi" || argument == "--roi-angstrom")
+    {
+        options->hasRegion = true;
+        options->region    = parse_region(option, value, argument == "--roi" ? RegionOfInterest::Units::Voxels : RegionOfInterest::Units::Angstrom);
+    }
+    else if (argument == "--auto-crop")
+    {
+        options->autoCrop = true;
+        parse_crop_threshold(option, value, &options->crop);
+    }
+    else if (argument == "--crop-margin")
+    {
+        options->crop.margin = parseCount(option, value, 0);
+    }
+    else if (argument == "--pyramid")
+    {
+        options->pyramidLevels = parseCount(option, value);
+    }
+    else if (argument == "--pyramid-reduction")
+    {
+        options->pyramidReduction = parse_reduction(option, value);
+    }
+    else if (argument == "--bricks")
+    {
+        options->brickSize = parseCount(option, value);
+    }
+    else if (argument == "--brick-border")
+    {
+        options->brickBorder = parseCount(option, value, 0);
+    }
+    else if (argument == "--resample")
+    {
+        options->resampleVoxelSize = parse_voxel_size(option, value);
+    }
+    else if (argument == "--resample-filter")
+    {
+        options->resampleFilter = parse_filter(option, value);
+    }
+    else if (argument == "--gradient")
+    {
+        options->gradient        = true;
+        options->gradientStencil = parse_stencil(option, value);
+    }
+    else if (argument == "--gradient-format")
+    {
+        options->gradientFormat = parse_gradient_format(option, value);
+    }
+    else if (argument == "--macrocells")
+    {
+        options->macrocellSize = parseCount(option, value);
+    }
+    else if (argument == "--macrocell-levels")
+    {
+        options->macrocellLevels = parseCount(option, value);
+    }
+    else if (argument == "--quantize")
+    {
+        options->quantize            = true;
+        options->quantization.format = parse_quantized_format(option, value);
+    }
+    else if (argument == "--quantize-range")
+    {
+        parse_quantization_range(option, value, &options->quantization);
+    }
+    else if (argument == "--sequence")
+    {
+        options->split               = true;
+        options->sequence.numVolumes = (value != nullptr && std::string(value) == "auto") ? 0 : parseCount(option, value);
+    }
+    else if (argument == "--sequence-sections")
+    {
+        options->split                      = true;
+        options->sequence.sectionsPerVolume = parseCount(option, value);
+    }
+    else if (argument == "--fourier")
+    {
+        options->fourier.component = parse_fourier_component(option, value);
+    }
+    else if (argument == "--output")
+    {
+        if (value == nullptr || *value == '\0')
+        {
+            throw std::runtime_error(argument + " expects the base name of the output files.");
+        }
+        options->outputBase = value;
+    }
+    else
+    {
+        return false;
+    }
+    ++*index;
+    return true;
+}
+
+const char * conversionOptionsUsage()
+{
+    return "  --stream             convert slab by slab with bounded memory\n"
+           "  --widen              write float values instead of the type stored in the file\n"
+           "  --slabs <n>          number of slabs held in memory when streaming (default 4)\n"
+           "  --slab-sections <n>  number of sections per slab when streaming (default 1)\n"
+           "  --roi <x0,y0,z0,x1,y1,z1>\n"
+           "                       convert only voxels x0 <= x < x1, y0 <= y < y1, z0 <= z < z1\n"
+           "  --roi-angstrom <x0,y0,z0,x1,y1,z1>\n"
+           "                       convert only voxels centered in this box, in Aangstrom\n"
+           "  --auto-crop <threshold | sigma[=k]>\n"
+           "                       convert only the box around the voxels above the threshold, or above the mean\n"
+           "                       plus k rms deviations reported in the header (default 3)\n"
+           "  --crop-margin <n>    voxels kept around the cropped box (default 1)\n"
+           "  --pyramid <n>        also write n levels of halved resolution, file.mrc.2x.raw, file.mrc.4x.raw, ...\n"
+           "  --pyramid-reduction <mean|min|max>\n"
+           "                       how blocks of voxels combine into a pyramid level (default mean)\n"
+           "  --bricks <n>         also write the volume as n^3 voxel bricks to file.mrc.bricks.raw, indexed in file.mrc.bricks.idx\n"
+           "  --brick-border <n>   ghost voxels around each brick (default 1)\n"
+           "  --resample <size | x,y,z>\n"
+           "                       also write the volume resampled to this voxel size in Aangstrom to file.mrc.resampled.raw\n"
+           "  --resample-filter <trilinear|sinc>\n"
+           "                       interpolate linearly, or with a Lanczos windowed sinc (default trilinear)\n"
+           "  --gradient <central|sobel>\n"
+           "                       also write the gradient in value per Aangstrom to file.mrc.gradient.raw, from central\n"
+           "                       differences or from differences smoothed across the other two axes\n"
+           "  --gradient-format <float16|float32|int8>\n"
+           "                       type of the three gradient components; int8 keeps only the direction (default float16)\n"
+           "  --macrocells <n>     also write the value range of each n^3 voxel cell to file.mrc.macrocells\n"
+           "  --macrocell-levels <n>\n"
+           "                       also combine the cells into up to n - 1 coarser levels of an octree (default 1)\n"
+           "  --reference-mrc      write only file.mrc.dat, referring to the voxel data in file.mrc, where the data needs\n"
+           "                       no conversion; such data is otherwise copied by the kernel, without decoding\n"
+           "  --quantize <uint8|uint16>\n"
+           "                       write values linearly quantized to unsigned integers, derived outputs keep\n"
+           "                       the values of the map\n"
+           "  --quantize-range <header|measured|percentile[=p]|sigma[=k]>\n"
+           "                       values mapped to the ends of the quantized range: the header min and max,\n"
+           "                       the measured min and max (default), clipping p percent at either end\n"
+           "                       (default 0.1), or the mean plus and minus k rms deviations (default 3)\n"
+           "  --sequence <n|auto>  split the sections into n volumes, or the volumes of a volume stack (space group\n"
+           "                       401 and above) and the images of an image stack (space group 0), played back\n"
+           "                       by Inviwo from file.mrc.dat, with each volume also in file.mrc.000.dat, ...;\n"
+           "                       n must divide the number of sections\n"
+           "  --sequence-sections <n>\n"
+           "                       split the sections into volumes of n sections each, n must divide their number\n"
+           "  --fourier <amplitude|phase|log-power>\n"
+           "                       value written for each complex value of a Fourier transform, mode 3 or 4, expanded\n"
+           "                       to the full grid with the zero frequency in the center (default amplitude)\n"
+           "  --fourier-full       the Fourier transform holds all x frequencies, not only the non-negative half\n"
+           "  --no-statistics      do not compute value range, mean, rms and histogram for the .dat file\n"
+           "  --update-header      write the computed min, max, mean and rms into the mrc header\n"
+           "  --output <base>      write base.raw and base.dat instead of file.mrc.raw and file.mrc.dat\n"
+           "  --stats              print a line of JSON per file to stdout with the duration, bytes and MB/s\n"
+           "                       of each stage, the number of file system calls and the peak memory use\n"
+           "  --cache <manifest>   record converted files in a manifest and skip those that did not change since,\n"
+           "                       rewriting only the .dat file of those whose header alone changed\n"
+           "  --watch <directory>  convert the mrc files in the directory, then every mrc file written to it,\n"
+           "                       until interrupted\n";
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Parsing of conversion options, shared by the command line and the jobs of the conversion service.
+ */
+
+#ifndef COMMANDLINE_H_
+#define COMMANDLINE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct ConversionOptions;
+
+/*! \brief Parse a positive number, or a number of at least minimum.
+ *
+ * \param[in] value the text of the number, nullptr if the option is the last argument
+ * \throws std::runtime_error naming the option if value is no such number
+ */
+size_t parseCount(const char * option, const char * value, long minimum = 1);
+
+/*! \brief Apply the conversion option at arguments[*index] to options.
+ *
+ * Advances *index past the values the option takes.
+ * \returns false, leaving *index unchanged, if arguments[*index] is no conversion option
+ * \throws std::runtime_error if the value of the option is missing or invalid
+ */
+bool parseConversionOption(const std::vector<std::string> &arguments, size_t * index, ConversionOptions * options);
+
+//! Usage lines of the options understood by parseConversionOption(), followed by --cache and --watch, which steer what is converted.
+const char * conversionOptionsUsage();
+
+#endif /* end of include guard: COMMANDLINE_H_ */
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "conversioncache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "convert/batch.h"
+#include "convert/converter.h"
+#include "inviwo/datfile.h"
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcfilewriter.h"
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+#include "util/hash.h"
+#include "util/inputfiles.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+
+namespace
+{
+
+//! Bytes of each block of voxel data that the fingerprint hashes.
+constexpr size_t sampleBytes_c = 64 << 10;
+//! Number of blocks spread over the voxel data; smaller data is hashed as a whole.
+constexpr size_t numSamples_c = 64;
+//! First line of the manifest, changed when its format changes.
+const char manifestHeader_c[] = "# mrctoinviwo conversion cache 1";
+
+//! Hashes of the content of an input.
+struct Fingerprint
+{
+    uint64_t layout; //!< grid size, mode, stored data format, axis order, data offset and value statistics
+    uint64_t header; //!< main and extended header
+    uint64_t data;   //!< sampled voxel data, or the sampled file if compressed
+};
+
+struct Entry
+{
+    uint64_t    size;
+    int64_t     modified; //!< modification time in nanoseconds
+    Fingerprint fingerprint;
+    uint64_t    options;
+};
+
+//! The key of a file in the manifest, the same for all paths that lead to it.
+std::string manifest_key(const std::string &filename)
+{
+    char * resolved = realpath(filename.c_str(), nullptr);
+    if (resolved == nullptr)
+    {
+        return absolutePath(filename);
+    }
+    const std::string key(resolved);
+    free(resolved);
+    return key;
+}
+
+bool file_state(const std::string &filename, uint64_t * size, int64_t * modified)
+{
+    struct stat status;
+    if (stat(filename.c_str(), &status) != 0)
+    {
+        return false;
+    }
+    *size     = uint64_t(status.st_size);
+    *modified = int64_t(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+    return true;
+}
+
+//! The fields of the header that change the converted values or their description beyond placing the volume.
+uint64_t hash_layout(const MrcHeader &header, size_t dataOffset)
+{
+    // the stored format follows the mode and flags such as the IMOD flag for unsigned bytes
+    int64_t storedFormat = -1;
+    try
+    {
+        storedFormat = int64_t(mrcStoredFormat(header));
+    }
+    catch (const std::runtime_error &)
+    {
+        // complex and unknown modes have no stored format, their mode tells them apart
+    }
+    const std::array<size_t, 3> numCrs  = mrcNumCrs(header);
+    const int64_t               words[] = {
+        header.mrc_data_mode, storedFormat, int64_t(numCrs[0]), int64_t(numCrs[1]), int64_t(numCrs[2]), header.extend[0], header.extend[1],
+        header.extend[2], header.crs_to_xyz[0], header.crs_to_xyz[1], header.crs_to_xyz[2], int64_t(dataOffset), header.swap_bytes
+    };
+    // the header statistics set quantization ranges and are corrected in place by updating the header
+    const float statistics[] = { header.min_value, header.max_value, header.mean_value, header.rms_value };
+    return hashBytes(statistics, sizeof(statistics), hashBytes(words, sizeof(words)));
+}
+
+uint64_t hash_samples(const PosixFile &file, size_t begin)
+{
+    const size_t fileSize  = file.size();
+    const size_t size      = fileSize > begin ? fileSize - begin : 0;
+    const size_t numBlocks = std::min(numSamples_c, (size + sampleBytes_c - 1) / sampleBytes_c);
+    const bool   sampled   = size > numSamples_c * sampleBytes_c;
+    std::vector<char> block(sampleBytes_c);
+    uint64_t          hash = 0;
+    for (size_t i = 0; i < numBlocks; ++i)
+    {
+        // samples include the first and the last block
+        const size_t offset = begin + (sampled ? i * (size - sampleBytes_c) / (numSamples_c - 1) : i * sampleBytes_c);
+        hash = hashBytes(block.data(), file.readAtMost(block.data(), sampleBytes_c, offset), hash);
+    }
+    return hash;
+}
+
+Fingerprint fingerprint(const std::string &filename, const MrcFileView &view)
+{
+    const MrcHeader        &header = view.header();
+    const std::vector<char> bytes  = mrcHeaderBytes(header, false);
+    Fingerprint             result;
+    result.layout = hash_layout(header, view.dataOffset());
+    result.header = hashBytes(header.extended_header.data(), header.extended_header.size(), hashBytes(bytes.data(), bytes.size()));
+    // a changed header changes the whole compressed stream after it, so compressed files are sampled as a whole
+    result.data   = hash_samples(PosixFile(filename, PosixFile::Mode::Read), view.source().isSequential() ? 0 : view.dataOffset());
+    return result;
+}
+
+//! True if the .dat file describes all that depends on the header, without derived outputs whose placement would change too.
+bool header_rewritable(const MrcHeader &header, const ConversionOptions &options)
+{
+    return !options.hasRegion && !options.autoCrop && !hasDerivedOutputs(options) && !options.quantize && !options.split
+           && !options.updateHeader && !mrcIsComplex(header);
+}
+
+/*! \brief True if the .dat file exists and its raw file holds all the voxel data it describes.
+ *
+ * The raw file of a converted volume has exactly that size; an mrc file referred to in place holds the data after its header.
+ */
+bool outputs_exist(const std::string &filename, const ConversionOptions &options)
+{
+    DatFile    datFile;
+    DataFormat format;
+    try
+    {
+        datFile = DatFile::read(outputBaseName(filename, options) + ".dat");
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    uint64_t rawSize;
+    int64_t  rawModified;
+    if (!formatFromName(datFile.format, &format) || !file_state(datFile.rawFile, &rawSize, &rawModified))
+    {
+        return false;
+    }
+    uint64_t expected = datFile.sequences * formatBytes(format);
+    for (int extent : datFile.resolution)
+    {
+        expected *= uint64_t(std::max(extent, 0));
+    }
+    return datFile.byteOffset == 0 ? rawSize == expected : rawSize >= datFile.byteOffset + expected;
+}
+
+}   // namespace
+
+class ConversionCache::Impl
+{
+    public:
+        Impl(const std::string &manifestFile, const std::string &optionsKey) :
+            manifestFile_(manifestFile), options_(hashBytes(optionsKey.data(), optionsKey.size())) {}
+
+        void load_();
+
+        std::string                   manifestFile_;
+        uint64_t                      options_;
+        mutable std::mutex            mutex_;
+        std::map<std::string, Entry>  entries_; //!< by absolute path of the input
+};
+
+void ConversionCache::Impl::load_()
+{
+    std::ifstream manifest(manifestFile_);
+    if (!manifest)
+    {
+        if (access(manifestFile_.c_str(), F_OK) != 0)
+        {
+            return;
+        }
+        throw std::runtime_error("Cannot read conversion cache \"" + manifestFile_ + "\".");
+    }
+    std::string line;
+    size_t      lineNumber = 0;
+    while (std::getline(manifest, line))
+    {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        // size, modification time, hashes and options come first, as the path may contain tabs
+        std::istringstream fields(line);
+        Entry              entry;
+        std::string        path;
+        fields >> entry.size >> entry.modified >> std::hex >> entry.fingerprint.layout >> entry.fingerprint.header
+        >> entry.fingerprint.data >> entry.options;
+        if (!fields || fields.get() != '\t' || !std::getline(fields, path) || path.empty())
+        {
+            throw std::runtime_error("Malformed line " + std::to_string(lineNumber) + " in conversion cache \"" + manifestFile_ + "\".");
+        }
+        entries_[path] = entry;
+    }
+}
+
+ConversionCache::ConversionCache(const std::string &manifestFile, const std::string &optionsKey) :
+    impl_(new Impl(manifestFile, optionsKey))
+{
+    if (!manifestFile.empty())
+    {
+        impl_->load_();
+    }
+}
+
+ConversionCache::~ConversionCache()
+{
+}
+
+ConversionCache::Action ConversionCache::check(const std::string &filename, const ConversionOptions &options)
+{
+    uint64_t size;
+    int64_t  modified;
+    if (!file_state(filename, &size, &modified))
+    {
+        // the conversion reports the error
+        return Action::Convert;
+    }
+    const std::string path = manifest_key(filename);
+    Entry             entry;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        const auto found = impl_->entries_.find(path);
+        if (found == impl_->entries_.end())
+        {
+            return Action::Convert;
+        }
+        entry = found->second;
+    }
+    if (entry.options != impl_->options_ || entry.size != size || !outputs_exist(filename, options))
+    {
+        return Action::Convert;
+    }
+    if (entry.modified == modified)
+    {
+        return Action::Skip;
+    }
+    try
+    {
+        const MrcFileView view(filename, MrcFileView::DataAccess::HeaderAndExtendedHeader);
+        const Fingerprint current = fingerprint(filename, view);
+        if (current.layout != entry.fingerprint.layout || current.data != entry.fingerprint.data)
+        {
+            return Action::Convert;
+        }
+        if (current.header == entry.fingerprint.header)
+        {
+            std::lock_guard<std::mutex> lock(impl_->mutex_);
+            impl_->entries_[path].modified = modified;
+            return Action::Skip;
+        }
+        return header_rewritable(view.header(), options) ? Action::RewriteHeader : Action::Convert;
+    }
+    catch (const std::exception &)
+    {
+        return Action::Convert;
+    }
+}
+
+void ConversionCache::rewriteHeader(const std::string &filename, const ConversionOptions &options)
+{
+    const std::string datFileName = outputBaseName(filename, options) + ".dat";
+    DatFile           datFile     = DatFile::read(datFileName);
+    {
+        const MrcFileView view(filename, MrcFileView::DataAccess::HeaderOnly);
+        const DatFile     described = mrcDatFile(view.header(), DataFormat::FLOAT32, datFile.rawFile);
+        datFile.basis  = described.basis;
+        datFile.offset = described.offset;
+    }
+    datFile.write(datFileName);
+    record(filename);
+}
+
+void ConversionCache::record(const std::string &filename)
+{
+    Entry entry;
+    // the state before reading, so changes while reading show at the next check
+    if (!file_state(filename, &entry.size, &entry.modified))
+    {
+        throw std::runtime_error("Cannot read \"" + filename + "\": " + strerror(errno));
+    }
+    const MrcFileView view(filename, MrcFileView::DataAccess::HeaderAndExtendedHeader);
+    entry.fingerprint = fingerprint(filename, view);
+    entry.options     = impl_->options_;
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->entries_[manifest_key(filename)] = entry;
+}
+
+void ConversionCache::save() const
+{
+    if (impl_->manifestFile_.empty())
+    {
+        return;
+    }
+    const std::string temporary = impl_->manifestFile_ + ".tmp";
+    {
+        std::ofstream manifest(temporary);
+        manifest << manifestHeader_c << "\n";
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        for (const std::pair<const std::string, Entry> &entry : impl_->entries_)
+        {
+            const Entry &value = entry.second;
+            manifest << std::dec << value.size << "\t" << value.modified << "\t" << std::hex << value.fingerprint.layout << "\t"
+                     << value.fingerprint.header << "\t" << value.fingerprint.data << "\t" << value.options << "\t" << entry.first << "\n";
+        }
+        if (!manifest.flush())
+        {
+            throw std::runtime_error("Cannot write conversion cache \"" + temporary + "\".");
+        }
+    }
+    if (rename(temporary.c_str(), impl_->manifestFile_.c_str()) != 0)
+    {
+        throw std::runtime_error("Cannot replace conversion cache \"" + impl_->manifestFile_ + "\": " + strerror(errno));
+    }
+}
+
+size_t convertCached(const std::vector<std::string> &filenames, const ConversionOptions &options, size_t numThreads,
+                     ConversionCache * cache)
+{
+    std::vector<ConversionCache::Action> actions(filenames.size());
+    parallelFor(filenames.size(), [&filenames, &options, &actions, cache](size_t i) {
+        actions[i] = cache->check(filenames[i], options);
+    }, numThreads);
+
+    std::vector<std::string> changed;
+    size_t                   numSkipped = 0;
+    for (size_t i = 0; i < filenames.size(); ++i)
+    {
+        if (actions[i] == ConversionCache::Action::Skip)
+        {
+            ++numSkipped;
+            continue;
+        }
+        if (actions[i] == ConversionCache::Action::RewriteHeader)
+        {
+            try
+            {
+                cache->rewriteHeader(filenames[i], options);
+                fprintf(stderr, "Updated the header of \"%s\"\n", filenames[i].c_str());
+                continue;
+            }
+            catch (const std::exception &e)
+            {
+                fprintf(stderr, "Converting \"%s\" again, as its header cannot be updated: %s\n", filenames[i].c_str(), e.what());
+            }
+        }
+        changed.push_back(filenames[i]);
+    }
+    if (numSkipped > 0)
+    {
+        fprintf(stderr, "Skipped %zu unchanged files\n", numSkipped);
+    }
+    const size_t numFailed = convertBatch(changed, options, numThreads, [cache](const std::string &filename) {
+        cache->record(filename);
+    });
+    cache->save();
+    return numFailed;
+}
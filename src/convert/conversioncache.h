@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Manifest of converted files that lets repeated conversions skip unchanged inputs.
+ */
+
+#ifndef CONVERSIONCACHE_H_
+#define CONVERSIONCACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ConversionOptions;
+
+/*! \brief Remembers which inputs were converted with which options, persisted in a manifest file.
+ *
+ * Every entry is keyed by the absolute path of the input and holds its size and modification time,
+ * a fingerprint of its content and a key of the conversion options. The fingerprint hashes the
+ * layout of the voxel data (size, mode, stored data format, axis order, data offset and the value statistics
+ * of the header), the whole header and sampled blocks
+ * of the voxel data, see hashBytes(), so a sampled fingerprint may miss changes confined to blocks
+ * between the samples.
+ *
+ * Inputs whose size and modification time are unchanged are skipped without reading them.
+ * Otherwise the fingerprint decides: an unchanged content is skipped, e.g. after the file was touched
+ * or copied, a changed header with unchanged data and layout rewrites only the .dat file, anything else is converted.
+ * Inputs are converted in any case if the options differ, the .dat file is missing or its raw file
+ * is missing or shorter than the volume it describes.
+ *
+ * Methods are thread-safe.
+ */
+class ConversionCache
+{
+public:
+    enum class Action
+    {
+        Skip,          //!< the outputs are up to date
+        RewriteHeader, //!< only the header changed, rewrite the .dat file
+        Convert        //!< convert the input
+    };
+
+    /*! \brief Load the manifest from manifestFile, if it exists.
+     *
+     * \param[in] manifestFile where the manifest is kept, empty for a cache that lives only in memory
+     * \param[in] optionsKey the conversion options, e.g. as given on the command line; entries recorded with other options do not count
+     * \throws std::runtime_error if the manifest exists but cannot be read
+     */
+    ConversionCache(const std::string &manifestFile, const std::string &optionsKey);
+    ~ConversionCache();
+
+    //! What it takes to bring the outputs of filename up to date.
+    Action check(const std::string &filename, const ConversionOptions &options);
+    /*! \brief Update the description of the volume in the .dat file to the changed mrc header, and record the input.
+     *
+     * Keeps the raw file and the statistics of the voxel values.
+     * \throws std::runtime_error if the files cannot be read or written
+     */
+    void rewriteHeader(const std::string &filename, const ConversionOptions &options);
+    /*! \brief Record the input as it is now, after converting it.
+     *
+     * \throws std::runtime_error if the file cannot be read
+     */
+    void record(const std::string &filename);
+    /*! \brief Write the manifest, replacing the previous one at once.
+     *
+     * \throws std::runtime_error if the manifest cannot be written
+     */
+    void save() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/*! \brief Convert those files whose outputs the cache does not find up to date, and record them.
+ *
+ * Checks the files on numThreads threads, rewrites the .dat files of inputs with changed headers
+ * and converts the remaining ones with convertBatch(). Saves the manifest at the end.
+ * \param[in] numThreads number of threads, zero for all hardware threads
+ * \returns the number of files that could not be converted
+ */
+size_t convertCached(const std::vector<std::string> &filenames, const ConversionOptions &options, size_t numThreads,
+                     ConversionCache * cache);
+
+#endif /* end of include guard: CONVERSIONCACHE_H_ */
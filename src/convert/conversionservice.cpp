@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "conversionservice.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "convert/commandline.h"
+#include "util/blockingqueue.h"
+#include "util/bufferpool.h"
+#include "util/inputfiles.h"
+#include "util/json.h"
+#include "util/parallel.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Interval at which the service checks for a stop signal while waiting for clients.
+constexpr int pollMilliseconds_c = 200;
+//! Clients whose unfinished line grows beyond this are disconnected.
+constexpr size_t maxLineBytes_c = 1 << 20;
+
+volatile sig_atomic_t stopRequested = 0;
+
+void request_stop(int)
+{
+    stopRequested = 1;
+}
+
+std::runtime_error socket_error(const std::string & what, const std::string & socketPath)
+{
+    return std::runtime_error(what + " \"" + socketPath + "\": " + strerror(errno));
+}
+
+sockaddr_un socket_address(const std::string & socketPath)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Socket path \"" + socketPath + "\" is too long.");
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    return address;
+}
+
+//! Send all bytes, returning false if the peer has gone.
+bool send_all(int fd, const std::string & bytes)
+{
+    for (size_t sent = 0; sent < bytes.size(); )
+    {
+        const ssize_t count = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        sent += count;
+    }
+    return true;
+}
+
+std::vector<std::string> split_tabs(const std::string & line)
+{
+    std::vector<std::string> fields;
+    size_t                   begin = 0;
+    for (size_t tab = line.find('\t'); tab != std::string::npos; tab = line.find('\t', begin))
+    {
+        fields.push_back(line.substr(begin, tab - begin));
+        begin = tab + 1;
+    }
+    fields.push_back(line.substr(begin));
+    return fields;
+}
+
+//! A client connection, closed once the reader and all jobs of the client have let go of it.
+struct Connection
+{
+    explicit Connection(int socket) : fd(socket), numJobs(0) {}
+    ~Connection() { close(fd); }
+    Connection(const Connection &)            = delete;
+    Connection &operator=(const Connection &) = delete;
+
+    //! Answer a job; answers of concurrent jobs do not interleave.
+    void answer(const std::string & line)
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        send_all(fd, line + "\n");
+    }
+
+    const int   fd;
+    std::mutex  sendMutex;
+    std::string unfinishedLine; //!< bytes received after the last complete line
+    size_t      numJobs;        //!< jobs received so far
+};
+
+struct Job
+{
+    std::shared_ptr<Connection> connection;
+    size_t                      number;
+    std::string                 line;
+};
+
+//! Convert the file of a job line and describe the result as a line of JSON.
+std::string run_job(const ConversionOptions &defaults, size_t number, const std::string & line)
+{
+    std::string              answer = "{\"job\":" + std::to_string(number);
+    std::vector<std::string> arguments = split_tabs(line);
+    std::string              input;
+    try
+    {
+        ConversionOptions options = defaults;
+        for (size_t i = 0; i < arguments.size(); ++i)
+        {
+            if (parseConversionOption(arguments, &i, &options))
+            {
+                continue;
+            }
+            if (arguments[i].compare(0, 2, "--") == 0 || !input.empty())
+            {
+                throw std::runtime_error("Unexpected argument \"" + arguments[i] + "\", a job converts a single file.");
+            }
+            input = arguments[i];
+        }
+        if (input.empty())
+        {
+            throw std::runtime_error("The job names no input file.");
+        }
+        // the report goes back to the client instead of stdout
+        options.reportStages = false;
+        StageReport report;
+        {
+            ReportScope scope(&report);
+            convertMrcToInviwo(input, options);
+        }
+        return answer + ",\"input\":" + jsonString(input) + ",\"output\":" + jsonString(outputBaseName(input, options))
+               + ",\"ok\":true,\"report\":" + report.json(input) + "}";
+    }
+    catch (const std::exception &e)
+    {
+        return answer + ",\"input\":" + jsonString(input) + ",\"ok\":false,\"error\":" + jsonString(e.what()) + "}";
+    }
+}
+
+class Service
+{
+public:
+    explicit Service(const ServiceOptions &options);
+    ~Service();
+    //! Accept clients and read their jobs until a stop signal arrives.
+    void run(const std::string & socketPath);
+
+private:
+    //! Read from a client, queueing its complete lines as jobs; false once the client stops sending.
+    bool receive_(const std::shared_ptr<Connection> &connection);
+    void work_();
+
+    ServiceOptions           options_;
+    BlockingQueue<Job>       jobs_;
+    std::vector<std::thread> workers_;
+};
+
+Service::Service(const ServiceOptions &options) : options_(options)
+{
+    BufferPool::shared().setCapacity(options.poolBytes);
+    const size_t numWorkers = options.numWorkers > 0 ? options.numWorkers : hardwareThreads();
+    // jobs converted at once share the hardware threads between their parallel loops
+    if (options_.defaults.numThreads == 0)
+    {
+        options_.defaults.numThreads = std::max<size_t>(hardwareThreads() / numWorkers, 1);
+    }
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+        workers_.emplace_back([this] { work_(); });
+    }
+}
+
+Service::~Service()
+{
+    jobs_.close();
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void Service::work_()
+{
+    Job job;
+    while (jobs_.pop(&job))
+    {
+        job.connection->answer(run_job(options_.defaults, job.number, job.line));
+        // release the connection before waiting for the next job, so it closes when done
+        job.connection.reset();
+    }
+}
+
+bool Service::receive_(const std::shared_ptr<Connection> &connection)
+{
+    char          buffer[64 << 10];
+    const ssize_t count = recv(connection->fd, buffer, sizeof(buffer), 0);
+    if (count < 0 && (errno == EINTR || errno == EAGAIN))
+    {
+        return true;
+    }
+    if (count <= 0)
+    {
+        return false;
+    }
+    std::string &pending = connection->unfinishedLine;
+    pending.append(buffer, count);
+    size_t begin = 0;
+    for (size_t end = pending.find('\n'); end != std::string::npos; end = pending.find('\n', begin))
+    {
+        std::string line = pending.substr(begin, end - begin);
+        begin = end + 1;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (!line.empty())
+        {
+            jobs_.push(Job {connection, ++connection->numJobs, line});
+        }
+    }
+    pending.erase(0, begin);
+    if (pending.size() > maxLineBytes_c)
+    {
+        connection->answer("{\"ok\":false,\"error\":\"Job line too long.\"}");
+        return false;
+    }
+    return true;
+}
+
+void Service::run(const std::string & socketPath)
+{
+    const sockaddr_un address = socket_address(socketPath);
+    // replace the socket of a previous run, but no other file
+    struct stat status;
+    if (lstat(socketPath.c_str(), &status) == 0)
+    {
+        if (!S_ISSOCK(status.st_mode))
+        {
+            throw std::runtime_error("\"" + socketPath + "\" exists and is no socket.");
+        }
+        unlink(socketPath.c_str());
+    }
+    const int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+    {
+        throw socket_error("Cannot create socket", socketPath);
+    }
+    if (bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        const std::runtime_error error = socket_error("Cannot listen on", socketPath);
+        close(listener);
+        throw error;
+    }
+    fprintf(stderr, "Listening for conversion jobs on \"%s\" with %zu workers\n", socketPath.c_str(), workers_.size());
+
+    std::map<int, std::shared_ptr<Connection> > connections;
+    while (!stopRequested)
+    {
+        std::vector<pollfd> waiting(1, pollfd {listener, POLLIN, 0});
+        for (const std::pair<const int, std::shared_ptr<Connection> > &connection : connections)
+        {
+            waiting.push_back(pollfd {connection.first, POLLIN, 0});
+        }
+        if (poll(waiting.data(), waiting.size(), pollMilliseconds_c) <= 0)
+        {
+            continue;
+        }
+        for (size_t i = 1; i < waiting.size(); ++i)
+        {
+            // clients that stopped sending keep their connection until their jobs are answered
+            if (waiting[i].revents != 0 && !receive_(connections[waiting[i].fd]))
+            {
+                connections.erase(waiting[i].fd);
+            }
+        }
+        if (waiting[0].revents & POLLIN)
+        {
+            const int client = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0)
+            {
+                connections[client] = std::make_shared<Connection>(client);
+            }
+        }
+    }
+    fprintf(stderr, "Stopping, finishing the jobs received so far\n");
+    close(listener);
+    unlink(socketPath.c_str());
+}
+
+}   // namespace
+
+void serveConversions(const std::string & socketPath, const ServiceOptions &options)
+{
+    struct sigaction stop;
+    std::memset(&stop, 0, sizeof(stop));
+    stop.sa_handler = &request_stop;
+    struct sigaction previousInterrupt, previousTerminate;
+    sigaction(SIGINT, &stop, &previousInterrupt);
+    sigaction(SIGTERM, &stop, &previousTerminate);
+    stopRequested = 0;
+    try
+    {
+        // the destructor lets the workers finish all queued jobs
+        Service service(options);
+        service.run(socketPath);
+    }
+    catch (...)
+    {
+        sigaction(SIGINT, &previousInterrupt, nullptr);
+        sigaction(SIGTERM, &previousTerminate, nullptr);
+        throw;
+    }
+    sigaction(SIGINT, &previousInterrupt, nullptr);
+    sigaction(SIGTERM, &previousTerminate, nullptr);
+}
+
+size_t submitConversions(const std::string & socketPath, const std::vector<std::string> &jobArguments,
+                         const std::vector<std::string> &inputs)
+{
+    const sockaddr_un address = socket_address(socketPath);
+    const int         fd      = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        const std::runtime_error error = socket_error("Cannot connect to", socketPath);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        throw error;
+    }
+    std::string jobs;
+    for (const std::string &input : inputs)
+    {
+        for (size_t i = 0; i < jobArguments.size(); ++i)
+        {
+            const bool isPath = i > 0 && jobArguments[i - 1] == "--output";
+            jobs += (isPath ? absolutePath(jobArguments[i]) : jobArguments[i]) + "\t";
+        }
+        jobs += absolutePath(input) + "\n";
+    }
+    if (!send_all(fd, jobs))
+    {
+        const std::runtime_error error = socket_error("Cannot send jobs to", socketPath);
+        close(fd);
+        throw error;
+    }
+    shutdown(fd, SHUT_WR);
+
+    // the service closes the connection after the last answer
+    size_t      numFailed = 0;
+    std::string answers;
+    char        buffer[64 << 10];
+    for (ssize_t count; (count = recv(fd, buffer, sizeof(buffer), 0)) != 0; )
+    {
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count < 0)
+        {
+            const std::runtime_error error = socket_error("Lost connection to", socketPath);
+            close(fd);
+            throw error;
+        }
+        answers.append(buffer, count);
+        for (size_t end = answers.find('\n'); end != std::string::npos; end = answers.find('\n'))
+        {
+            const std::string answer = answers.substr(0, end);
+            answers.erase(0, end + 1);
+            numFailed += answer.find("\"ok\":false") != std::string::npos ? 1 : 0;
+            printf("%s\n", answer.c_str());
+            fflush(stdout);
+        }
+    }
+    close(fd);
+    return numFailed;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Long-running conversion service that takes jobs over a Unix domain socket.
+ */
+
+#ifndef CONVERSIONSERVICE_H_
+#define CONVERSIONSERVICE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "convert/converter.h"
+
+//! Settings of the conversion service that apply to all jobs.
+struct ServiceOptions
+{
+    ServiceOptions() : numWorkers(0), poolBytes(size_t(1) << 30) {}
+    size_t            numWorkers; //!< number of jobs converted at once, zero for all hardware threads
+    size_t            poolBytes;  //!< bytes of slab and volume buffers kept for reuse between jobs
+    ConversionOptions defaults;   //!< options of every job, which the options given with a job add to
+};
+
+/*! \brief Convert files on request of clients that connect to a Unix domain socket.
+ *
+ * Every line a client sends is a job: the arguments of a conversion separated by tabs,
+ * the options as on the command line, e.g. --output, followed by a single input file.
+ * A fixed number of workers converts the jobs in the order they arrive, with buffers
+ * taken from BufferPool::shared(), so jobs after the first reuse memory that is already
+ * allocated and faulted in.
+ *
+ * Each job is answered with a line of JSON when it is done, e.g.
+ * {"job":1,"input":"a.mrc","output":"a.mrc","ok":true,"report":{...}}, with the StageReport
+ * of the job, or "ok":false and an "error" message. Jobs count from one per connection and
+ * may finish out of order. The connection closes once the client has shut down its sending
+ * side and all its jobs are answered.
+ *
+ * Runs until SIGINT or SIGTERM, then finishes the jobs already received and removes the socket.
+ * \throws std::runtime_error if the socket cannot be created
+ */
+void serveConversions(const std::string & socketPath, const ServiceOptions &options);
+
+/*! \brief Send a job per input file to a running service and print its answers to stdout.
+ *
+ * Relative paths of inputs and outputs are made absolute, as the service may run in another directory.
+ * \param[in] jobArguments options given with every job, as on the command line
+ * \returns the number of jobs that failed
+ * \throws std::runtime_error if the service cannot be reached
+ */
+size_t submitConversions(const std::string & socketPath, const std::vector<std::string> &jobArguments,
+                         const std::vector<std::string> &inputs);
+
+#endif /* end of include guard: CONVERSIONSERVICE_H_ */
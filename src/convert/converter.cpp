@@ -0,0 +1,609 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "converter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "convert/axisorder.h"
+#include "convert/bricks.h"
+#include "convert/sequence.h"
+#include "convert/slabpipeline.h"
+#include "convert/statisticssink.h"
+#include "inviwo/datfile.h"
+#include "inviwo/rawfilewriter.h"
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcgrid.h"
+#include "mrc/mrcheader.h"
+#include "mrc/mrcstatistics.h"
+#include "util/bufferpool.h"
+#include "util/byteswap.h"
+#include "util/datasource.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+#include "util/quantiles.h"
+#include "util/quantize.h"
+#include "util/stagereport.h"
+#include "util/valuestatistics.h"
+
+DatFile mrcDatFile(const MrcHeader &header, DataFormat format, const std::string & rawFileName)
+{
+    return mrcDatFile(header, format, rawFileName, mrcFullGrid(header));
+}
+
+DatFile mrcDatFile(const MrcHeader &header, DataFormat format, const std::string & rawFileName, const GridRegion &region)
+{
+    const std::array<float, 3> voxelSize  = mrcVoxelSize(header);
+    const std::array<float, 3> firstVoxel = mrcFirstVoxelPosition(header);
+    const std::array<size_t, 3> &size     = region.size;
+
+    DatFile datFile;
+    datFile.rawFile    = rawFileName;
+    datFile.resolution = {{ int(size[0]), int(size[1]), int(size[2]) }};
+    datFile.format     = formatName(format);
+    datFile.basis      = {{
+                              {{voxelSize[0] * size[0], 0, 0}},
+                              {{0, voxelSize[1] * size[1], 0}},
+                              {{0, 0, voxelSize[2] * size[2]}}
+                          }};
+    // voxel centers lie half a voxel inside the volume corner
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        datFile.offset[dim] = firstVoxel[dim] + (float(region.begin[dim]) - 0.5f) * voxelSize[dim];
+    }
+    return datFile;
+}
+
+namespace
+{
+
+std::string to_text(double value, int precision)
+{
+    std::ostringstream text;
+    text.precision(precision);
+    text << value;
+    return text.str();
+}
+
+//! Number of bytes handed to the derived outputs at once when the whole volume is in memory.
+constexpr size_t derivedSlabBytes_c = 16 << 20;
+
+typedef std::vector<std::unique_ptr<SlabSink> > SinkList;
+
+SinkList derived_sinks(const std::string & filename, const MrcHeader &header, const GridRegion &region,
+                       DataFormat format, const ConversionOptions &options)
+{
+    SinkList sinks;
+    if (options.pyramidLevels > 0)
+    {
+        sinks.emplace_back(new PyramidWriter(header, region, format, outputBaseName(filename, options), options.pyramidLevels, options.pyramidReduction));
+    }
+    if (options.brickSize > 0)
+    {
+        sinks.emplace_back(new BrickWriter(region, format, outputBaseName(filename, options), options.brickSize, options.brickBorder));
+    }
+    if (options.resampleVoxelSize[0] > 0)
+    {
+        sinks.emplace_back(new ResampleWriter(header, region, format, outputBaseName(filename, options), options.resampleVoxelSize,
+                                              options.resampleFilter));
+    }
+    if (options.gradient)
+    {
+        sinks.emplace_back(new GradientWriter(header, region, format, outputBaseName(filename, options), options.gradientStencil,
+                                              options.gradientFormat));
+    }
+    if (options.macrocellSize > 0)
+    {
+        sinks.emplace_back(new MacrocellWriter(header, region, format, outputBaseName(filename, options), options.macrocellSize,
+                                               options.macrocellLevels));
+    }
+    return sinks;
+}
+
+//! Hand a volume in x, y, z order to the sinks slab by slab.
+void feed_sinks(const char * data, const GridRegion &region, DataFormat format, const SinkList &sinks)
+{
+    if (sinks.empty())
+    {
+        return;
+    }
+    const size_t sectionBytes    = region.size[0] * region.size[1] * formatBytes(format);
+    const size_t sectionsPerSlab = std::max<size_t>(derivedSlabBytes_c / std::max<size_t>(sectionBytes, 1), 1);
+    Slab         slab;
+    slab.index  = 0;
+    slab.format = format;
+    for (size_t first = 0; first < region.size[2]; first += sectionsPerSlab)
+    {
+        slab.firstSection = first;
+        slab.numSections  = std::min(sectionsPerSlab, region.size[2] - first);
+        slab.data.assign(data + first * sectionBytes, data + (first + slab.numSections) * sectionBytes);
+        for (const std::unique_ptr<SlabSink> &sink : sinks)
+        {
+            sink->consume(slab);
+        }
+        ++slab.index;
+    }
+    for (const std::unique_ptr<SlabSink> &sink : sinks)
+    {
+        sink->finish();
+    }
+}
+
+/*! \brief Write a volume in x, y, z order with its description and derived outputs.
+ *
+ * Quantizes the values of the raw file if the options ask for it. The derived outputs
+ * receive the values of the map, so their descriptions keep its units.
+ */
+void write_volume(const std::string & filename, const std::string & rawFileName, const MrcHeader &header, const GridRegion &region,
+                  const char * data, DataFormat format, const ConversionOptions &options)
+{
+    const size_t    numVoxels = region.size[0] * region.size[1] * region.size[2];
+    const bool        measureFirst = options.quantize && quantizationNeedsValues(options.quantization, header);
+    const bool        measure      = options.statistics || measureFirst;
+    ValueStatistics   statistics(isIntegerFormat(format));
+    QuantileHistogram quantiles;
+    if (measure)
+    {
+        ScopedStage stage(Stage::Statistics, numVoxels * formatBytes(format));
+        statistics = computeStatistics(data, format, numVoxels);
+    }
+    if (measureFirst && options.quantization.range == QuantizationOptions::Range::Percentile)
+    {
+        ScopedStage stage(Stage::Statistics, numVoxels * formatBytes(format));
+        quantiles = computeQuantiles(data, format, numVoxels);
+    }
+
+    feed_sinks(data, region, format, derived_sinks(filename, header, region, format, options));
+
+    DataFormat        outputFormat = format;
+    PooledBuffer      quantized;
+    std::unique_ptr<Quantization> quantization;
+    if (options.quantize)
+    {
+        quantization.reset(new Quantization(chooseQuantization(options.quantization, header, &statistics, &quantiles)));
+        outputFormat = quantization->format();
+        ScopedStage stage(Stage::Quantize, numVoxels * formatBytes(format));
+        quantize(data, format, *quantization, quantized.resize(numVoxels * formatBytes(outputFormat)), numVoxels);
+        data = quantized.get().data();
+    }
+    {
+        ScopedStage stage(Stage::Write, numVoxels * formatBytes(outputFormat));
+        PosixFile(rawFileName, PosixFile::Mode::Write).write(data, numVoxels * formatBytes(outputFormat));
+    }
+
+    DatFile datFile = mrcDatFile(header, outputFormat, rawFileName, region);
+    if (options.statistics)
+    {
+        applyStatistics(filename, header, statistics, options, &datFile);
+    }
+    if (quantization)
+    {
+        applyQuantization(*quantization, &datFile);
+    }
+    ScopedStage stage(Stage::Write);
+    datFile.write(outputBaseName(filename, options) + ".dat");
+}
+
+void convert_in_memory(const std::string & filename, const std::string & rawFileName, const ConversionOptions &options)
+{
+    const MrcFileView mrcfile(filename, MrcFileView::DataAccess::MapIfPossible,
+                              options.pipeline.widenToFloat ? MrcFileView::Conversion::WidenToFloat : MrcFileView::Conversion::Native);
+    const char *      xyzData = mrcfile.bytes().data();
+    PooledBuffer      reordered;
+    if (!mrcHasStandardAxisOrder(mrcfile.header()))
+    {
+        ScopedStage stage(Stage::Reorder, mrcfile.bytes().size());
+        reorderToXyz(mrcfile.bytes().data(), reordered.resize(mrcfile.bytes().size()), mrcNumCrs(mrcfile.header()),
+                     mrcfile.header().crs_to_xyz, formatBytes(mrcfile.format()));
+        xyzData = reordered.get().data();
+    }
+    write_volume(filename, rawFileName, mrcfile.header(), mrcFullGrid(mrcfile.header()), xyzData, mrcfile.format(), options);
+    fprintf(stderr, "Dumped voxel data into \"%s\"\n", rawFileName.c_str());
+}
+
+//! Expand a Fourier transform to the centered frequency grid of one of its components.
+void convert_fourier(const std::string & filename, const std::string & rawFileName, const MrcHeader &header,
+                     const ConversionOptions &options)
+{
+    if (options.hasRegion || options.autoCrop || options.quantize || options.split)
+    {
+        throw std::runtime_error("Fourier maps cannot be combined with a region of interest, cropping, quantization or sequences.");
+    }
+    const MrcHeader        gridHeader = fourierGridHeader(header, options.fourier);
+    RawFileWriter          rawWriter(rawFileName);
+    StatisticsSink         statistics(DataFormat::FLOAT32);
+    std::vector<SlabSink *> sinks = { &rawWriter };
+    if (options.statistics)
+    {
+        sinks.push_back(&statistics);
+    }
+    const SinkList derived = derived_sinks(filename, gridHeader, mrcFullGrid(gridHeader), DataFormat::FLOAT32, options);
+    for (const std::unique_ptr<SlabSink> &sink : derived)
+    {
+        sinks.push_back(sink.get());
+    }
+    streamFourierMap(filename, options.fourier, sinks);
+    fprintf(stderr, "Expanded the %s of the Fourier transform into \"%s\"\n", fourierComponentName(options.fourier.component),
+            rawFileName.c_str());
+
+    DatFile datFile = mrcDatFile(gridHeader, DataFormat::FLOAT32, rawFileName);
+    datFile.metaData.emplace_back("FourierComponent", fourierComponentName(options.fourier.component));
+    if (options.statistics)
+    {
+        if (options.updateHeader)
+        {
+            fprintf(stderr, "Statistics of the %s are not written to the header of \"%s\"\n",
+                    fourierComponentName(options.fourier.component), filename.c_str());
+        }
+        ConversionOptions gridOptions = options;
+        gridOptions.updateHeader = false;
+        applyStatistics(filename, gridHeader, statistics.statistics(), gridOptions, &datFile);
+    }
+    ScopedStage stage(Stage::Write);
+    datFile.write(outputBaseName(filename, options) + ".dat");
+}
+
+//! Convert a file whose stored data needs no conversion, see keepsStoredData().
+void convert_stored_data(const std::string & filename, const std::string & rawFileName, const MrcFileView &headerView,
+                         const ConversionOptions &options)
+{
+    const MrcHeader &header    = headerView.header();
+    const DataFormat format    = mrcStoredFormat(header);
+    const GridRegion region    = mrcFullGrid(header);
+    const size_t     numVoxels = region.size[0] * region.size[1] * region.size[2];
+    DatFile          datFile;
+    if (options.referenceMrc)
+    {
+        datFile            = mrcDatFile(header, format, filename, region);
+        datFile.byteOffset = headerView.dataOffset();
+        datFile.bigEndian  = hostIsBigEndian() != header.swap_bytes;
+        fprintf(stderr, "Referred to the voxel data in \"%s\"\n", filename.c_str());
+    }
+    else
+    {
+        ScopedStage stage(Stage::Write, numVoxels * formatBytes(format));
+        PosixFile(rawFileName, PosixFile::Mode::Write).copyFrom(PosixFile(filename, PosixFile::Mode::Read), headerView.dataOffset(),
+                                                                numVoxels * formatBytes(format));
+        datFile = mrcDatFile(header, format, rawFileName, region);
+        fprintf(stderr, "Copied voxel data into \"%s\"\n", rawFileName.c_str());
+    }
+    if (options.statistics)
+    {
+        // maps native-endian data, so measuring reads the file without copying it
+        const MrcFileView view(filename);
+        ScopedStage       stage(Stage::Statistics, view.bytes().size());
+        applyStatistics(filename, header, computeStatistics(view.bytes().data(), view.format(), numVoxels), options, &datFile);
+    }
+    ScopedStage stage(Stage::Write);
+    datFile.write(outputBaseName(filename, options) + ".dat");
+}
+
+void convert_region(const std::string & filename, const std::string & rawFileName, const ConversionOptions &options)
+{
+    const MrcFileView view(filename, MrcFileView::DataAccess::HeaderOnly);
+    const GridRegion  region = regionToGrid(options.region, view.header());
+    DataFormat        format;
+    const std::vector<char> data = extractRegion(filename, region, options.pipeline.widenToFloat, &format);
+    write_volume(filename, rawFileName, view.header(), region, data.data(), format, options);
+    fprintf(stderr, "Extracted %zu x %zu x %zu voxels into \"%s\"\n", region.size[0], region.size[1], region.size[2], rawFileName.c_str());
+}
+
+//! Measure all values of a file in a separate streaming pass.
+void measure_streaming(const std::string & filename, const ConversionOptions &options, StatisticsSink * statistics)
+{
+    SlabPipeline::Options pipelineOptions = options.pipeline;
+    // statistics do not depend on the order of the values
+    pipelineOptions.reorderAxes = false;
+    SlabPipeline pipeline(filename, pipelineOptions);
+    pipeline.addSink(statistics);
+    pipeline.run();
+}
+
+/*! \brief Describe the volumes of a sequence, each placed where the first volume of the stack lies.
+ *
+ * Writes base.dat, which Inviwo reads as a sequence of all volumes in the raw file,
+ * and base.000.dat, ... which describe a volume each, with its own statistics.
+ */
+void write_sequence_headers(const std::string & filename, const MrcHeader &header, const SequenceLayout &layout,
+                            const SequenceWriter &sequenceWriter, DataFormat format, const Quantization * quantization,
+                            const ConversionOptions &options)
+{
+    if (options.updateHeader)
+    {
+        fprintf(stderr, "Statistics of the volumes of a sequence are not written to the header of \"%s\"\n", filename.c_str());
+    }
+    ConversionOptions volumeOptions = options;
+    volumeOptions.updateHeader = false;
+    ScopedStage                 stage(Stage::Write);
+    const std::array<size_t, 3> gridSize = mrcGridSize(header);
+    const GridRegion            region   = {{{ 0, 0, 0 }}, {{ gridSize[0], gridSize[1], layout.sectionsPerVolume }}};
+    const std::string           baseName = outputBaseName(filename, options);
+    ValueStatistics             statistics(isIntegerFormat(format));
+    for (size_t volume = 0; volume < layout.numVolumes(); ++volume)
+    {
+        DatFile datFile    = mrcDatFile(header, format, sequenceWriter.rawFileName(), region);
+        datFile.byteOffset = volume * sequenceWriter.volumeBytes();
+        if (options.statistics && quantization == nullptr)
+        {
+            applyStatistics(filename, header, sequenceWriter.statistics(volume), volumeOptions, &datFile);
+            statistics.merge(sequenceWriter.statistics(volume));
+        }
+        if (quantization != nullptr)
+        {
+            applyQuantization(*quantization, &datFile);
+        }
+        datFile.write(sequenceVolumeName(baseName, layout, volume) + ".dat");
+    }
+    DatFile datFile   = mrcDatFile(header, format, sequenceWriter.rawFileName(), region);
+    datFile.sequences = layout.numVolumes();
+    if (options.statistics && quantization == nullptr)
+    {
+        applyStatistics(filename, header, statistics, volumeOptions, &datFile);
+    }
+    if (quantization != nullptr)
+    {
+        applyQuantization(*quantization, &datFile);
+    }
+    datFile.write(baseName + ".dat");
+}
+
+void convert_streaming(const std::string & filename, const std::string & rawFileName, const ConversionOptions &options)
+{
+    SlabPipeline   pipeline(filename, options.pipeline);
+    // ranges that follow from the values need a separate pass over the file before quantizing
+    const bool     measureFirst = options.quantize && quantizationNeedsValues(options.quantization, pipeline.header());
+    StatisticsSink statistics(pipeline.format(), measureFirst && options.quantization.range == QuantizationOptions::Range::Percentile);
+    if (measureFirst)
+    {
+        measure_streaming(filename, options, &statistics);
+    }
+    else if (options.statistics && !options.split)
+    {
+        pipeline.addSink(&statistics);
+    }
+    // the derived outputs receive the values of the map, ahead of the quantizer
+    const SinkList derived = derived_sinks(filename, pipeline.header(), mrcFullGrid(pipeline.header()), pipeline.format(), options);
+    for (const std::unique_ptr<SlabSink> &sink : derived)
+    {
+        pipeline.addSink(sink.get());
+    }
+    DataFormat                      outputFormat = pipeline.format();
+    std::unique_ptr<Quantization>   quantization;
+    std::unique_ptr<QuantizingSink> quantizer;
+    if (options.quantize)
+    {
+        quantization.reset(new Quantization(chooseQuantization(options.quantization, pipeline.header(),
+                                                               &statistics.statistics(), &statistics.quantiles())));
+        quantizer.reset(new QuantizingSink(*quantization));
+        pipeline.addSink(quantizer.get());
+        outputFormat = quantization->format();
+    }
+    // the raw file receives the quantized values
+    auto addOutput = [&pipeline, &quantizer](SlabSink * sink) {
+            if (quantizer)
+            {
+                quantizer->addSink(sink);
+            }
+            else
+            {
+                pipeline.addSink(sink);
+            }
+        };
+    if (options.split)
+    {
+        // the volumes record the statistics of their own values, unless they are quantized to a shared range
+        const SequenceLayout layout = sequenceLayout(pipeline.header(), options.sequence);
+        SequenceWriter       sequenceWriter(rawFileName, layout, mrcGridSize(pipeline.header()), outputFormat,
+                                            options.statistics && !quantization);
+        addOutput(&sequenceWriter);
+        pipeline.run();
+        fprintf(stderr, "Streamed voxel data into %zu volumes of %zu sections\n", layout.numVolumes(), layout.sectionsPerVolume);
+        write_sequence_headers(filename, pipeline.header(), layout, sequenceWriter, outputFormat, quantization.get(), options);
+        return;
+    }
+    RawFileWriter  rawWriter(rawFileName);
+    addOutput(&rawWriter);
+    pipeline.run();
+    fprintf(stderr, "Streamed voxel data into \"%s\"\n", rawFileName.c_str());
+
+    DatFile datFile = mrcDatFile(pipeline.header(), outputFormat, rawFileName);
+    if (options.statistics)
+    {
+        applyStatistics(filename, pipeline.header(), statistics.statistics(), options, &datFile);
+    }
+    if (quantization)
+    {
+        applyQuantization(*quantization, &datFile);
+    }
+    ScopedStage stage(Stage::Write);
+    datFile.write(outputBaseName(filename, options) + ".dat");
+}
+
+void convert_file(const std::string & filename, const ConversionOptions &options)
+{
+    const std::string rawFileName = outputBaseName(filename, options) + ".raw";
+    bool              streaming   = options.streaming;
+    if (options.split)
+    {
+        if (options.hasRegion || options.autoCrop || hasDerivedOutputs(options))
+        {
+            throw std::runtime_error("Sequences cannot be combined with a region of interest, cropping, pyramids, bricks, resampling, gradients or macrocells.");
+        }
+        // the volumes are written from one sequential read of the sections
+        convert_streaming(filename, rawFileName, options);
+        fprintf(stderr, "Converted header to \"%s\"\n", (outputBaseName(filename, options) + ".dat").c_str());
+        return;
+    }
+    if (options.autoCrop)
+    {
+        if (options.hasRegion)
+        {
+            throw std::runtime_error("Cropping cannot be combined with a region of interest.");
+        }
+        // the cropped volume is converted like a region of interest in voxels
+        const GridRegion  box         = findCropRegion(filename, options.pipeline, options.crop);
+        const MrcFileView           headerView(filename, MrcFileView::DataAccess::HeaderOnly);
+        const std::array<size_t, 3> gridSize    = mrcGridSize(headerView.header());
+        ConversionOptions           cropOptions = options;
+        cropOptions.autoCrop     = false;
+        cropOptions.hasRegion    = true;
+        cropOptions.region.units = RegionOfInterest::Units::Voxels;
+        for (size_t dim = 0; dim < 3; ++dim)
+        {
+            cropOptions.region.lower[dim] = float(box.begin[dim]);
+            cropOptions.region.upper[dim] = float(box.begin[dim] + box.size[dim]);
+        }
+        fprintf(stderr, "Cropped \"%s\" to voxels %zu,%zu,%zu up to %zu,%zu,%zu, %.1f%% of the volume\n", filename.c_str(),
+                box.begin[0], box.begin[1], box.begin[2], box.begin[0] + box.size[0], box.begin[1] + box.size[1], box.begin[2] + box.size[2],
+                100.0 * box.size[0] * box.size[1] * box.size[2] / (gridSize[0] * gridSize[1] * gridSize[2]));
+        convert_file(filename, cropOptions);
+        return;
+    }
+    if (options.hasRegion)
+    {
+        convert_region(filename, rawFileName, options);
+        fprintf(stderr, "Converted header to \"%s\"\n", (outputBaseName(filename, options) + ".dat").c_str());
+        return;
+    }
+    const MrcFileView headerView(filename, MrcFileView::DataAccess::HeaderOnly);
+    if (mrcIsComplex(headerView.header()))
+    {
+        convert_fourier(filename, rawFileName, headerView.header(), options);
+        fprintf(stderr, "Converted header to \"%s\"\n", (outputBaseName(filename, options) + ".dat").c_str());
+        return;
+    }
+    if (keepsStoredData(headerView, options))
+    {
+        convert_stored_data(filename, rawFileName, headerView, options);
+        fprintf(stderr, "Converted header to \"%s\"\n", (outputBaseName(filename, options) + ".dat").c_str());
+        return;
+    }
+    if (options.referenceMrc)
+    {
+        fprintf(stderr, "The voxel data of \"%s\" needs converting, writing \"%s\" instead of referring to it\n",
+                filename.c_str(), rawFileName.c_str());
+    }
+    if (streaming && (options.pipeline.reorderAxes || hasDerivedOutputs(options)))
+    {
+        if (!sectionsRunAlongZ(headerView.header().crs_to_xyz))
+        {
+            fprintf(stderr, "Sections of \"%s\" do not run along z, reordering axes in memory instead of streaming\n", filename.c_str());
+            streaming = false;
+        }
+    }
+    if (streaming)
+    {
+        convert_streaming(filename, rawFileName, options);
+    }
+    else
+    {
+        convert_in_memory(filename, rawFileName, options);
+    }
+    fprintf(stderr, "Converted header to \"%s\"\n", (outputBaseName(filename, options) + ".dat").c_str());
+}
+
+}   // namespace
+
+void applyStatistics(const std::string & filename, const MrcHeader &header, const ValueStatistics &statistics,
+                     const ConversionOptions &options, DatFile * datFile)
+{
+    if (statistics.count() == 0)
+    {
+        return;
+    }
+    datFile->hasRange   = true;
+    datFile->dataRange  = {{ statistics.min(), statistics.max() }};
+    datFile->valueRange = datFile->dataRange;
+
+    std::ostringstream histogram;
+    for (uint64_t count : statistics.histogram())
+    {
+        histogram << (histogram.tellp() > 0 ? " " : "") << count;
+    }
+    datFile->metaData.emplace_back("Mean", to_text(statistics.mean(), std::numeric_limits<float>::max_digits10));
+    datFile->metaData.emplace_back("RMS", to_text(statistics.rms(), std::numeric_limits<float>::max_digits10));
+    // bin edges are exact binary fractions
+    datFile->metaData.emplace_back("HistogramLower", to_text(statistics.histogramLower(), std::numeric_limits<double>::max_digits10));
+    datFile->metaData.emplace_back("HistogramBinWidth", to_text(statistics.binWidth(), std::numeric_limits<double>::max_digits10));
+    datFile->metaData.emplace_back("Histogram", histogram.str());
+
+    if (options.updateHeader)
+    {
+        if (options.hasRegion)
+        {
+            fprintf(stderr, "Statistics of a region of interest are not written to the header of \"%s\"\n", filename.c_str());
+            return;
+        }
+        mrcWriteStatistics(filename, header, statistics);
+        fprintf(stderr, "Corrected density statistics in the header of \"%s\"\n", filename.c_str());
+    }
+}
+
+std::string outputBaseName(const std::string & filename, const ConversionOptions &options)
+{
+    return options.outputBase.empty() ? stripCompressionExtension(filename) : options.outputBase;
+}
+
+bool hasDerivedOutputs(const ConversionOptions &options)
+{
+    return options.pyramidLevels > 0 || options.brickSize > 0 || options.resampleVoxelSize[0] > 0 || options.gradient || options.macrocellSize > 0;
+}
+
+bool keepsStoredData(const MrcFileView &view, const ConversionOptions &options)
+{
+    const MrcHeader &header = view.header();
+    if (options.hasRegion || options.autoCrop || options.quantize || options.split || hasDerivedOutputs(options) || view.source().isSequential()
+        || !mrcHasStandardAxisOrder(header) || (header.swap_bytes && !options.referenceMrc))
+    {
+        return false;
+    }
+    // throws for modes without scalar real data, which the conversion reports
+    try
+    {
+        const DataFormat stored = mrcStoredFormat(header);
+        return !options.pipeline.widenToFloat || stored == DataFormat::FLOAT32;
+    }
+    catch (const std::runtime_error &)
+    {
+        return false;
+    }
+}
+
+void convertMrcToInviwo(const std::string & filename, const ConversionOptions &options)
+{
+    StageReport report;
+    {
+        // without printing a report, stages record into the report of the caller, e.g. a service job
+        ReportScope       scope(options.reportStages ? &report : StageReport::current());
+        ThreadBudgetScope budget(options.numThreads);
+        convert_file(filename, options);
+    }
+    if (options.reportStages)
+    {
+        printf("%s\n", report.json(filename).c_str());
+    }
+}
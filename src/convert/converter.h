@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Conversion of mrc files to Inviwo raw/dat volumes.
+ */
+
+#ifndef CONVERTER_H_
+#define CONVERTER_H_
+
+#include <string>
+
+#include "convert/autocrop.h"
+#include "convert/fourier.h"
+#include "convert/gradient.h"
+#include "convert/macrocells.h"
+#include "convert/pyramid.h"
+#include "convert/quantizer.h"
+#include "convert/region.h"
+#include "convert/resample.h"
+#include "convert/sequence.h"
+#include "convert/slabpipeline.h"
+#include "inviwo/datfile.h"
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+
+class MrcFileView;
+struct MrcHeader;
+class ValueStatistics;
+
+//! Choices that steer the conversion of a single file.
+struct ConversionOptions
+{
+    ConversionOptions() : streaming(false), hasRegion(false), autoCrop(false), pyramidLevels(0), pyramidReduction(PyramidWriter::Reduction::Mean),
+                          brickSize(0), brickBorder(1), resampleVoxelSize({{0, 0, 0}}), resampleFilter(ResampleWriter::Filter::Trilinear),
+                          gradient(false), gradientStencil(GradientWriter::Stencil::Central), gradientFormat(DataFormat::FLOAT16),
+                          macrocellSize(0), macrocellLevels(1),
+                          referenceMrc(false), quantize(false), statistics(true), updateHeader(false), reportStages(false), split(false), numThreads(0) {}
+    bool                     streaming;        //!< stream the data slab by slab instead of viewing the whole volume at once
+    SlabPipeline::Options    pipeline;         //!< value type, and slab size and number of slabs held in memory when streaming
+    bool                     hasRegion;        //!< convert only the region of interest
+    RegionOfInterest         region;           //!< the region of interest, if hasRegion is set
+    bool                     autoCrop;         //!< convert only the box around the voxels above a threshold
+    CropOptions              crop;             //!< threshold and margin of the box, if autoCrop is set
+    size_t                   pyramidLevels;    //!< number of coarser levels written next to the volume
+    PyramidWriter::Reduction pyramidReduction; //!< how the voxels of a block combine into a coarser level
+    size_t                   brickSize;        //!< voxels along each axis of the bricks written next to the volume, zero for none
+    size_t                   brickBorder;      //!< ghost voxels around each brick
+    std::array<float, 3>     resampleVoxelSize; //!< voxel size in Aangstrom of a resampled copy of the volume, zero for none
+    ResampleWriter::Filter   resampleFilter;    //!< how the resampled voxels interpolate the volume
+    bool                     gradient;         //!< write the gradient of the volume next to it
+    GradientWriter::Stencil  gradientStencil;  //!< differences the gradient is computed from
+    DataFormat               gradientFormat;   //!< type of the three gradient components
+    size_t                   macrocellSize;    //!< voxels along each axis of the cells of the value range grid, zero for none
+    size_t                   macrocellLevels;  //!< levels of the value range octree, starting with the grid
+    bool                     referenceMrc;     //!< describe voxel data that needs no conversion in place in the mrc file, without a .raw file
+    bool                     quantize;         //!< write the values quantized to unsigned integers
+    QuantizationOptions      quantization;     //!< target type and value range, if quantize is set
+    bool                     statistics;       //!< compute value range, mean, rms and histogram while converting
+    bool                     updateHeader;     //!< write the computed statistics back into the mrc header
+    bool                     reportStages;     //!< print a line of JSON per file with the durations of its stages, see StageReport
+    bool                     split;            //!< split the sections into a sequence of volumes
+    SequenceOptions          sequence;         //!< number or size of the volumes, if split is set
+    FourierOptions           fourier;          //!< component and layout of the volume expanded from a Fourier transform, see streamFourierMap()
+    std::string              outputBase;       //!< base name of the output files, empty for the input filename, see outputBaseName()
+    size_t                   numThreads;       //!< threads of each parallel loop of the conversion, zero for threadBudget() of the caller
+};
+
+/*! \brief The base name that the names of the output files extend, e.g. with .raw.
+ *
+ * The outputBase of the options if given, otherwise the input filename without compression extension.
+ */
+std::string outputBaseName(const std::string & filename, const ConversionOptions &options);
+
+/*! \brief True if the options ask for outputs derived from the whole volume in order, e.g. a pyramid, bricks, a resampled copy, gradients or macrocells.
+ *
+ * Such volumes are converted in a single pass over all sections and cannot be split into independent parts.
+ */
+bool hasDerivedOutputs(const ConversionOptions &options);
+
+/*! \brief True if the voxel data as stored in the file is the volume the options ask for.
+ *
+ * That is the whole volume of an uncompressed file in x, y, z order, neither cropped, widened nor quantized,
+ * and without derived outputs or a sequence. The data must be native-endian, unless the options ask to
+ * reference the mrc file, as Inviwo reads either byte order. Such files are converted without decoding:
+ * the .dat file refers to the data in the mrc file, or the kernel copies the data to the .raw file.
+ * \param[in] view a view of the file, e.g. of its header only
+ */
+bool keepsStoredData(const MrcFileView &view, const ConversionOptions &options);
+
+/*! \brief Describe the volume of an mrc file, reordered to x, y, z, as Inviwo .dat header.
+ *
+ * The volume is placed at its position in Aangstrom, see mrcFirstVoxelPosition().
+ * \param[in] format type of the voxel values in the raw file
+ */
+DatFile mrcDatFile(const MrcHeader &header, DataFormat format, const std::string & rawFileName);
+
+//! Describe a region of the volume of an mrc file as Inviwo .dat header, see mrcDatFile().
+DatFile mrcDatFile(const MrcHeader &header, DataFormat format, const std::string & rawFileName, const GridRegion &region);
+
+/*! \brief Record the statistics of the converted values.
+ *
+ * Adds the value range, mean, rms and histogram to the .dat header and, if the options ask
+ * for it and the whole volume was converted, corrects the statistics in the mrc header.
+ */
+void applyStatistics(const std::string & filename, const MrcHeader &header, const ValueStatistics &statistics,
+                     const ConversionOptions &options, DatFile * datFile);
+
+/*! \brief Convert an mrc file to an Inviwo volume.
+ *
+ * Writes the voxel data to base.raw, the volume description to base.dat and derived outputs
+ * such as pyramid levels, bricks, a resampled copy, gradients and macrocells in the same pass, where base is outputBaseName(filename, options).
+ * If the options ask to split the file, writes the volumes of the sequence one after the other to base.raw,
+ * describes them as Inviwo sequence in base.dat and each volume on its own in base.000.dat, base.001.dat, ...
+ * Fourier transforms, data modes 3 and 4, are expanded to the centered frequency grid of one of their
+ * components, see streamFourierMap().
+ * If the stored data is kept, see keepsStoredData(), and the options ask to reference the mrc file,
+ * writes only base.dat, which refers to the data in the mrc file.
+ * If the options ask for it, prints the StageReport of the conversion to stdout,
+ * otherwise the stages record into the report current on the calling thread, if any.
+ * \throws std::runtime_error if reading or writing fails
+ */
+void convertMrcToInviwo(const std::string & filename, const ConversionOptions &options);
+
+#endif /* end of include guard: CONVERTER_H_ */
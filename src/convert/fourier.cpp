@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "fourier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcgrid.h"
+#include "mrc/mrcheader.h"
+#include "util/byteswap.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Output sections are expanded in slabs of about this many bytes.
+constexpr size_t slabBytes_c = 16 << 20;
+
+//! Index of frequency along an axis of size voxels in wrap-around order.
+size_t wrapped(long frequency, size_t size)
+{
+    const long remainder = frequency % long(size);
+    return size_t(remainder < 0 ? remainder + long(size) : remainder);
+}
+
+/*! \brief Split count stored complex values into real and imaginary parts.
+ *
+ * \tparam Part type of the real and imaginary part, int16_t for mode 3 and float for mode 4
+ */
+template <typename Part>
+void split_complex(const char * stored, size_t count, bool swap, float * real, float * imaginary)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Part parts[2];
+        std::memcpy(parts, stored + i * sizeof(parts), sizeof(parts));
+        if (swap)
+        {
+            parts[0] = swapBytes(parts[0]);
+            parts[1] = swapBytes(parts[1]);
+        }
+        real[i]      = float(parts[0]);
+        imaginary[i] = float(parts[1]);
+    }
+}
+
+/*! \brief The component of count complex values, of their complex conjugates if conjugate is set.
+ *
+ * Amplitudes and powers are computed in loops without branches, so they vectorize;
+ * the conjugate only changes the sign of the phase.
+ */
+void complex_component(const float * real, const float * imaginary, size_t count, FourierComponent component, bool conjugate,
+                       float * result)
+{
+    switch (component)
+    {
+        case FourierComponent::Amplitude:
+            for (size_t i = 0; i < count; ++i)
+            {
+                result[i] = std::sqrt(real[i] * real[i] + imaginary[i] * imaginary[i]);
+            }
+            break;
+        case FourierComponent::Phase:
+        {
+            const float sign = conjugate ? -1.0f : 1.0f;
+            for (size_t i = 0; i < count; ++i)
+            {
+                result[i] = std::atan2(sign * imaginary[i], real[i]);
+            }
+            break;
+        }
+        case FourierComponent::LogPower:
+            for (size_t i = 0; i < count; ++i)
+            {
+                result[i] = std::log1p(real[i] * real[i] + imaginary[i] * imaginary[i]);
+            }
+            break;
+    }
+}
+
+//! Expands the stored sections of a Fourier map to sections of the centered grid.
+class FourierExpander
+{
+public:
+    FourierExpander(const MrcHeader &header, const FourierOptions &options) :
+        options_(options), numCrs_(mrcNumCrs(header)), size_(fourierGridSize(header, options)), swap_(header.swap_bytes),
+        mode_(MrcHeader::MrcDataMode(header.mrc_data_mode)),
+        valueBytes_(mode_ == MrcHeader::MrcDataMode::complexInt32 ? 2 * sizeof(int16_t) : 2 * sizeof(float)) {}
+
+    size_t storedSectionBytes() const { return numCrs_[0] * numCrs_[1] * valueBytes_; }
+    size_t sectionVoxels() const { return size_[0] * size_[1]; }
+
+    //! Half-complex sections need the stored sections of frequency kz and of the opposite frequency -kz.
+    size_t storedPerSection() const { return options_.halfComplex ? 2 : 1; }
+
+    //! The stored section holding frequency z - size / 2 if which is zero, the one holding its opposite otherwise.
+    size_t storedSection(size_t z, size_t which) const
+    {
+        const long frequency = long(z) - long(size_[2] / 2);
+        return wrapped(which == 0 ? frequency : -frequency, numCrs_[2]);
+    }
+
+    /*! \brief Expand an output section from its stored sections.
+     *
+     * \param[in] stored the storedPerSection() sections of frequency kz and -kz, one after the other
+     */
+    void expand_section_(const char * stored, float * result) const;
+
+private:
+    //! The component of count stored values, starting at column of row.
+    void component_(const char * row, size_t column, size_t count, bool conjugate, float * result,
+                    std::vector<float> * real, std::vector<float> * imaginary) const;
+
+    FourierOptions          options_;
+    std::array<size_t, 3>   numCrs_;
+    std::array<size_t, 3>   size_;
+    bool                    swap_;
+    MrcHeader::MrcDataMode  mode_;
+    size_t                  valueBytes_;
+};
+
+void FourierExpander::component_(const char * row, size_t column, size_t count, bool conjugate, float * result,
+                                 std::vector<float> * real, std::vector<float> * imaginary) const
+{
+    if (mode_ == MrcHeader::MrcDataMode::complexInt32)
+    {
+        split_complex<int16_t>(row + column * valueBytes_, count, swap_, real->data(), imaginary->data());
+    }
+    else
+    {
+        split_complex<float>(row + column * valueBytes_, count, swap_, real->data(), imaginary->data());
+    }
+    complex_component(real->data(), imaginary->data(), count, options_.component, conjugate, result);
+}
+
+void FourierExpander::expand_section_(const char * stored, float * result) const
+{
+    const size_t       width    = size_[0];
+    const size_t       centerX  = width / 2;
+    const size_t       rowBytes = numCrs_[0] * valueBytes_;
+    std::vector<float> real(width), imaginary(width), reversed(width);
+    for (size_t y = 0; y < size_[1]; ++y)
+    {
+        const long   frequency = long(y) - long(size_[1] / 2);
+        const char * row       = stored + wrapped(frequency, numCrs_[1]) * rowBytes;
+        float      * target    = result + y * width;
+        // non-negative x frequencies 0 .. width - centerX - 1 go to the upper half of the row
+        component_(row, 0, width - centerX, false, target + centerX, &real, &imaginary);
+        if (options_.halfComplex)
+        {
+            // negative x frequencies -centerX .. -1 are the conjugates of the stored columns centerX .. 1 at -ky, -kz
+            const char * oppositeRow = stored + storedSectionBytes() + wrapped(-frequency, numCrs_[1]) * rowBytes;
+            component_(oppositeRow, 1, centerX, true, reversed.data(), &real, &imaginary);
+            std::reverse_copy(reversed.begin(), reversed.begin() + centerX, target);
+        }
+        else
+        {
+            // negative x frequencies are stored wrapped around at the end of the row
+            component_(row, width - centerX, centerX, false, target, &real, &imaginary);
+        }
+    }
+}
+
+}   // namespace
+
+const char * fourierComponentName(FourierComponent component)
+{
+    switch (component)
+    {
+        case FourierComponent::Amplitude: return "amplitude";
+        case FourierComponent::Phase:     return "phase";
+        case FourierComponent::LogPower:  return "log-power";
+    }
+    return "";
+}
+
+std::array<size_t, 3> fourierGridSize(const MrcHeader &header, const FourierOptions &options)
+{
+    std::array<size_t, 3> size = mrcNumCrs(header);
+    if (options.halfComplex)
+    {
+        size[0] = size[0] > 0 ? 2 * (size[0] - 1) : 0;
+    }
+    return size;
+}
+
+MrcHeader fourierGridHeader(const MrcHeader &header, const FourierOptions &options)
+{
+    const std::array<size_t, 3> size       = fourierGridSize(header, options);
+    MrcHeader                   gridHeader = header;
+    gridHeader.mrc_data_mode = int(MrcHeader::MrcDataMode::float32);
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        gridHeader.num_crs[dim]     = int(size[dim]);
+        gridHeader.extend[dim]      = int(size[dim]);
+        gridHeader.cell_length[dim] = float(size[dim]);
+        gridHeader.crs_start[dim]   = -int(size[dim] / 2);
+        // the MRC2014 origin would take precedence over the grid start
+        gridHeader.extra[12 + dim]  = 0;
+    }
+    return gridHeader;
+}
+
+void streamFourierMap(const std::string & filename, const FourierOptions &options, const std::vector<SlabSink *> &sinks,
+                      size_t numThreads)
+{
+    const MrcFileView view(filename, MrcFileView::DataAccess::HeaderOnly);
+    const MrcHeader  &header = view.header();
+    if (!mrcIsComplex(header))
+    {
+        throw std::runtime_error("\"" + filename + "\" holds no Fourier transform.");
+    }
+    if (view.source().isSequential())
+    {
+        throw std::runtime_error("Fourier maps are read at random positions, decompress \"" + filename + "\" first.");
+    }
+    if (!mrcHasStandardAxisOrder(header))
+    {
+        throw std::runtime_error("Fourier maps are expanded only with columns, rows and sections along x, y and z.");
+    }
+
+    const FourierExpander       expander(header, options);
+    const std::array<size_t, 3> size               = fourierGridSize(header, options);
+    const size_t                storedSectionBytes = expander.storedSectionBytes();
+    const size_t                sectionBytes       = expander.sectionVoxels() * sizeof(float);
+    const size_t                sectionsPerSlab    = std::max<size_t>(slabBytes_c / std::max<size_t>(sectionBytes, 1), 1);
+    const PosixFile             input(filename, PosixFile::Mode::Read);
+    if (input.size() < view.dataOffset() + size[2] * storedSectionBytes)
+    {
+        throw std::runtime_error("\"" + filename + "\" ends before all sections of its Fourier transform.");
+    }
+
+    Slab              slab;
+    std::vector<char> stored;
+    slab.index  = 0;
+    slab.format = DataFormat::FLOAT32;
+    for (size_t first = 0; first < size[2]; first += sectionsPerSlab)
+    {
+        slab.firstSection = first;
+        slab.numSections  = std::min(sectionsPerSlab, size[2] - first);
+        slab.data.resize(slab.numSections * sectionBytes);
+        stored.resize(slab.numSections * expander.storedPerSection() * storedSectionBytes);
+        {
+            ScopedStage stage(Stage::Read, stored.size());
+            for (size_t i = 0; i < slab.numSections * expander.storedPerSection(); ++i)
+            {
+                const size_t section = expander.storedSection(first + i / expander.storedPerSection(), i % expander.storedPerSection());
+                input.readAt(stored.data() + i * storedSectionBytes, storedSectionBytes, view.dataOffset() + section * storedSectionBytes);
+            }
+        }
+        {
+            ScopedStage stage(Stage::Decode, slab.data.size());
+            parallelFor(slab.numSections, [&](size_t i) {
+                    expander.expand_section_(stored.data() + i * expander.storedPerSection() * storedSectionBytes,
+                                             reinterpret_cast<float *>(slab.data.data()) + i * expander.sectionVoxels());
+                }, numThreads);
+        }
+        for (SlabSink * sink : sinks)
+        {
+            sink->consume(slab);
+        }
+        ++slab.index;
+    }
+    for (SlabSink * sink : sinks)
+    {
+        sink->finish();
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Real volumes from the Fourier transforms stored in mrc files, data modes 3 and 4.
+ */
+
+#ifndef FOURIER_H_
+#define FOURIER_H_
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "convert/slab.h"
+
+struct MrcHeader;
+
+//! The real value computed from each complex value of a Fourier transform.
+enum class FourierComponent
+{
+    Amplitude, //!< |F|
+    Phase,     //!< arg F in radians, from -pi to pi
+    LogPower   //!< ln(1 + |F|^2), which keeps the weak high frequencies visible
+};
+
+//! How to read the Fourier transform in an mrc file.
+struct FourierOptions
+{
+    FourierOptions() : component(FourierComponent::Amplitude), halfComplex(true) {}
+    FourierComponent component;   //!< the value written per voxel
+    bool             halfComplex; //!< columns hold only the non-negative x frequencies, as written by real-to-complex transforms
+};
+
+//! Lower case name of the component, e.g. "log-power".
+const char * fourierComponentName(FourierComponent component);
+
+/*! \brief Voxels along x, y and z of the full frequency grid.
+ *
+ * Half-complex files with n columns expand to 2 (n - 1) voxels along x, the size of an even real-space grid.
+ */
+std::array<size_t, 3> fourierGridSize(const MrcHeader &header, const FourierOptions &options);
+
+/*! \brief Header of the centered frequency grid of a Fourier map, as a real-valued FLOAT32 map.
+ *
+ * The grid has unit spacing, one per frequency index, and places the zero frequency at the origin,
+ * so the .dat files of the grid and its derived outputs show the frequencies on their axes.
+ */
+MrcHeader fourierGridHeader(const MrcHeader &header, const FourierOptions &options);
+
+/*! \brief Hand the centered frequency grid of a Fourier map to sinks, slab by slab of FLOAT32 values.
+ *
+ * The stored transform has its zero frequency at the first voxel and negative frequencies wrapped around
+ * to the upper end of each axis. The streamed grid places the zero frequency at voxel size / 2 along each axis.
+ * Half-complex files supply the negative x frequencies from the complex conjugates at the opposite
+ * frequencies, F(-k) = F(k)*, as the transform of a real volume is Hermitian.
+ *
+ * Each output section needs up to two stored sections, which are read with positioned reads,
+ * so only a slab of sections is held in memory. The sections of a slab are expanded on numThreads threads.
+ * \param[in] numThreads number of threads, zero for threadBudget()
+ * \throws std::runtime_error for compressed files, which cannot be read at random positions,
+ * files that are not complex or whose axes are not in x, y, z order
+ */
+void streamFourierMap(const std::string & filename, const FourierOptions &options, const std::vector<SlabSink *> &sinks,
+                      size_t numThreads = 0);
+
+#endif /* end of include guard: FOURIER_H_ */
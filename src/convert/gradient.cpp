@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "gradient.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "convert/converter.h"
+#include "inviwo/datfile.h"
+#include "mrc/mrcheader.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Voxels per parallel task; smaller sections run on the calling thread.
+constexpr size_t voxelsPerTask_c = 1 << 16;
+
+std::string gradient_file_name(const std::string &baseName, const std::string &extension)
+{
+    return baseName + ".gradient" + extension;
+}
+
+//! The neighbours of index along an axis of size voxels, clamped to the volume, and their distance in voxels.
+struct Neighbours
+{
+    Neighbours(size_t index, size_t size) :
+        lower(index > 0 ? index - 1 : 0), upper(std::min(index + 1, size - 1)), distance(float(upper - lower)) {}
+    size_t lower;
+    size_t upper;
+    float  distance;
+};
+
+//! Factor turning the difference of the neighbours into a gradient, zero along axes of a single voxel.
+float difference_factor(const Neighbours &neighbours, float spacing)
+{
+    return neighbours.distance > 0 ? 1 / (neighbours.distance * spacing) : 0;
+}
+
+/*! \brief Differences along x of a row, with one-sided differences at both ends.
+ *
+ * The interior loop has no branches, so it vectorizes.
+ */
+void difference_x(const float * row, size_t size, float factor, float * result)
+{
+    if (size == 1)
+    {
+        result[0] = 0;
+        return;
+    }
+    result[0] = (row[1] - row[0]) * 2 * factor;
+    for (size_t x = 1; x + 1 < size; ++x)
+    {
+        result[x] = (row[x + 1] - row[x - 1]) * factor;
+    }
+    result[size - 1] = (row[size - 1] - row[size - 2]) * 2 * factor;
+}
+
+//! result = a * weight, or result += a * weight when accumulating.
+void scale_add(const float * a, float weight, float * result, size_t size, bool accumulate)
+{
+    if (accumulate)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            result[x] += weight * a[x];
+        }
+    }
+    else
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            result[x] = weight * a[x];
+        }
+    }
+}
+
+//! result = (a - b) * factor, or result += (a - b) * factor when accumulating.
+void difference_add(const float * a, const float * b, float factor, float * result, size_t size, bool accumulate)
+{
+    if (accumulate)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            result[x] += (a[x] - b[x]) * factor;
+        }
+    }
+    else
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            result[x] = (a[x] - b[x]) * factor;
+        }
+    }
+}
+
+//! Smooth a row with 1, 2, 1 weights, repeating the border values.
+void smooth_x(const float * row, size_t size, float * result)
+{
+    if (size == 1)
+    {
+        result[0] = 4 * row[0];
+        return;
+    }
+    result[0] = 3 * row[0] + row[1];
+    for (size_t x = 1; x + 1 < size; ++x)
+    {
+        result[x] = row[x - 1] + 2 * row[x] + row[x + 1];
+    }
+    result[size - 1] = row[size - 2] + 3 * row[size - 1];
+}
+
+}   // namespace
+
+class GradientWriter::Impl
+{
+public:
+    Impl(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+         Stencil stencil, DataFormat componentFormat);
+
+    //! Take the next section into the window, writing the section before it once its upper neighbour is known.
+    void add_section_(const char * values);
+    //! Write the gradients of section z from the sections around it.
+    void emit_section_(size_t z);
+    //! Gradients of rows [firstRow, endRow) of section z into the packed output.
+    void compute_rows_(size_t z, size_t firstRow, size_t endRow, std::array<float, 2> * range);
+
+    MrcHeader             header_;
+    GridRegion            region_;
+    DataFormat            format_;
+    std::string           baseName_;
+    Stencil               stencil_;
+    DataFormat            componentFormat_;
+    std::array<float, 3>  spacing_;
+    PosixFile             file_;
+
+    std::array<std::vector<float>, 3> window_;     //!< the last three sections as float, section z in window_[z % 3]
+    size_t                            numSections_; //!< sections consumed so far
+    std::vector<float>                gradients_;  //!< packed gradients of a section as float
+    std::vector<char>                 output_;     //!< packed gradients of a section in the component format
+    std::array<float, 2>              range_;      //!< smallest and largest component written
+    std::mutex                        rangeMutex_;
+};
+
+GradientWriter::Impl::Impl(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                           Stencil stencil, DataFormat componentFormat) :
+    header_(header), region_(region), format_(format), baseName_(baseName), stencil_(stencil), componentFormat_(componentFormat),
+    spacing_(mrcVoxelSize(header)), file_(gradient_file_name(baseName, ".raw"), PosixFile::Mode::Write), numSections_(0),
+    range_({{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() }})
+{
+    if (componentFormat != DataFormat::FLOAT32 && componentFormat != DataFormat::FLOAT16 && componentFormat != DataFormat::INT8)
+    {
+        throw std::runtime_error("Gradients are written as FLOAT32, FLOAT16 or INT8 components.");
+    }
+    // headers without a cell size give gradients per voxel
+    for (float &spacing : spacing_)
+    {
+        spacing = spacing > 0 ? spacing : 1;
+    }
+    const size_t sectionVoxels = region.size[0] * region.size[1];
+    for (std::vector<float> &section : window_)
+    {
+        section.resize(sectionVoxels);
+    }
+    gradients_.resize(3 * sectionVoxels);
+    output_.resize(3 * sectionVoxels * formatBytes(componentFormat));
+}
+
+void GradientWriter::Impl::add_section_(const char * values)
+{
+    toFloat(values, format_, window_[numSections_ % 3].data(), region_.size[0] * region_.size[1]);
+    ++numSections_;
+    if (numSections_ >= 2)
+    {
+        emit_section_(numSections_ - 2);
+    }
+}
+
+void GradientWriter::Impl::compute_rows_(size_t z, size_t firstRow, size_t endRow, std::array<float, 2> * range)
+{
+    const size_t       width = region_.size[0];
+    const Neighbours   alongZ(z, region_.size[2]);
+    std::vector<float> gx(width), gy(width), gz(width), scratch(width), smoothed(width);
+    // the Sobel stencil weighs the neighbours across each difference by 1, 2, 1, sixteen in total
+    const std::array<float, 3> weights = {{ 1, 2, 1 }};
+    auto                       row     = [this, width](size_t section, size_t y) {
+        return window_[section % 3].data() + y * width;
+    };
+    for (size_t y = firstRow; y < endRow; ++y)
+    {
+        const Neighbours alongY(y, region_.size[1]);
+        const float      factorX = 1 / (2 * spacing_[0]);
+        const float      factorY = difference_factor(alongY, spacing_[1]);
+        const float      factorZ = difference_factor(alongZ, spacing_[2]);
+        if (stencil_ == Stencil::Central)
+        {
+            difference_x(row(z, y), width, factorX, gx.data());
+            difference_add(row(z, alongY.upper), row(z, alongY.lower), factorY, gy.data(), width, false);
+            difference_add(row(alongZ.upper, y), row(alongZ.lower, y), factorZ, gz.data(), width, false);
+        }
+        else
+        {
+            const std::array<size_t, 3> rowsY     = {{ alongY.lower, y, alongY.upper }};
+            const std::array<size_t, 3> sectionsZ = {{ alongZ.lower, z, alongZ.upper }};
+            // x: smooth over the 3 x 3 rows around, then take differences along the row
+            for (size_t i = 0; i < 9; ++i)
+            {
+                scale_add(row(sectionsZ[i / 3], rowsY[i % 3]), weights[i / 3] * weights[i % 3] / 16, scratch.data(), width, i > 0);
+            }
+            difference_x(scratch.data(), width, factorX, gx.data());
+            // y and z: differences smoothed over the other axis, then along the row
+            for (size_t i = 0; i < 3; ++i)
+            {
+                difference_add(row(sectionsZ[i], alongY.upper), row(sectionsZ[i], alongY.lower), factorY * weights[i] / 16,
+                               scratch.data(), width, i > 0);
+            }
+            smooth_x(scratch.data(), width, gy.data());
+            for (size_t i = 0; i < 3; ++i)
+            {
+                difference_add(row(alongZ.upper, rowsY[i]), row(alongZ.lower, rowsY[i]), factorZ * weights[i] / 16,
+                               scratch.data(), width, i > 0);
+            }
+            smooth_x(scratch.data(), width, gz.data());
+        }
+        float * packed = gradients_.data() + 3 * y * width;
+        for (size_t x = 0; x < width; ++x)
+        {
+            float g[3] = { gx[x], gy[x], gz[x] };
+            if (componentFormat_ == DataFormat::INT8)
+            {
+                const float length = std::sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+                const float scale  = length > 0 ? 127 / length : 0;
+                g[0] *= scale;
+                g[1] *= scale;
+                g[2] *= scale;
+            }
+            for (size_t c = 0; c < 3; ++c)
+            {
+                packed[3 * x + c] = g[c];
+                (*range)[0]       = std::min((*range)[0], g[c]);
+                (*range)[1]       = std::max((*range)[1], g[c]);
+            }
+        }
+    }
+}
+
+void GradientWriter::Impl::emit_section_(size_t z)
+{
+    const size_t width       = std::max<size_t>(region_.size[0], 1);
+    const size_t rowsPerTask = std::max<size_t>(1, voxelsPerTask_c / width);
+    const size_t numTasks    = (region_.size[1] + rowsPerTask - 1) / rowsPerTask;
+    parallelFor(numTasks, [this, z, rowsPerTask](size_t task) {
+                    std::array<float, 2> range = {{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() }};
+                    compute_rows_(z, task * rowsPerTask, std::min(region_.size[1], (task + 1) * rowsPerTask), &range);
+                    std::lock_guard<std::mutex> lock(rangeMutex_);
+                    range_[0] = std::min(range_[0], range[0]);
+                    range_[1] = std::max(range_[1], range[1]);
+                }, region_.size[0] * region_.size[1] >= voxelsPerTask_c ? 0 : 1);
+    fromFloat(gradients_.data(), componentFormat_, output_.data(), gradients_.size());
+    file_.write(output_.data(), output_.size());
+}
+
+GradientWriter::GradientWriter(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                               Stencil stencil, DataFormat componentFormat) :
+    impl_(new Impl(header, region, format, baseName, stencil, componentFormat))
+{
+}
+
+GradientWriter::~GradientWriter()
+{
+}
+
+void GradientWriter::consume(const Slab & slab)
+{
+    ScopedStage  stage(Stage::Derived, slab.data.size());
+    Impl        &impl         = *impl_;
+    const size_t sectionBytes = impl.region_.size[0] * impl.region_.size[1] * formatBytes(impl.format_);
+    for (size_t offset = 0; offset + sectionBytes <= slab.data.size(); offset += sectionBytes)
+    {
+        impl.add_section_(slab.data.data() + offset);
+    }
+}
+
+void GradientWriter::finish()
+{
+    ScopedStage stage(Stage::Derived);
+    Impl       &impl = *impl_;
+    if (impl.numSections_ != impl.region_.size[2])
+    {
+        throw std::runtime_error("The volume ended before all gradient sections were written.");
+    }
+    if (impl.numSections_ > 0)
+    {
+        // the last section has no upper neighbour
+        impl.emit_section_(impl.numSections_ - 1);
+    }
+    DatFile datFile = mrcDatFile(impl.header_, impl.componentFormat_, impl.file_.filename(), impl.region_);
+    datFile.format   = std::string("Vec3") + formatName(impl.componentFormat_);
+    datFile.hasRange = impl.range_[0] <= impl.range_[1];
+    if (impl.componentFormat_ == DataFormat::INT8)
+    {
+        datFile.dataRange  = {{ -127, 127 }};
+        datFile.valueRange = {{ -1, 1 }};
+        datFile.metaData.emplace_back("GradientEncoding", "direction");
+    }
+    else
+    {
+        datFile.dataRange  = {{ impl.range_[0], impl.range_[1] }};
+        datFile.valueRange = datFile.dataRange;
+        datFile.metaData.emplace_back("GradientEncoding", "value per Aangstrom");
+    }
+    datFile.metaData.emplace_back("GradientStencil", impl.stencil_ == Stencil::Central ? "central" : "sobel");
+    datFile.write(gradient_file_name(impl.baseName_, ".dat"));
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Gradient volume of a volume, computed while the volume streams by.
+ */
+
+#ifndef GRADIENT_H_
+#define GRADIENT_H_
+
+#include <memory>
+#include <string>
+
+#include "convert/slab.h"
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+
+struct MrcHeader;
+
+/*! \brief Writes the gradient of a volume as three packed components per voxel.
+ *
+ * Differences are taken over a sliding window of three sections and divided by the voxel
+ * spacing in Aangstrom, so the gradients are in value units per Aangstrom. At the border
+ * of the volume the differences become one-sided. Rows of each section are spread over
+ * all threads. Consumed slabs must be ordered x fastest, then y, then z.
+ */
+class GradientWriter : public SlabSink
+{
+public:
+    enum class Stencil
+    {
+        Central, //!< differences of the two neighbours along each axis
+        Sobel    //!< central differences smoothed with 1, 2, 1 weights along the other two axes
+    };
+
+    /*! \brief Prepare writing baseName.gradient.raw and baseName.gradient.dat.
+     *
+     * \param[in] region          the part of the mrc grid that is consumed
+     * \param[in] format          type of the consumed values
+     * \param[in] componentFormat FLOAT32 or FLOAT16 for gradients, or INT8 for unit gradient directions
+     *                            scaled to 127, which suit shading but lose the magnitude
+     * \throws std::runtime_error for other component formats
+     */
+    GradientWriter(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                   Stencil stencil, DataFormat componentFormat);
+    ~GradientWriter();
+
+    void consume(const Slab & slab) override;
+    //! Write the last section and the .dat file of the gradient volume.
+    void finish() override;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif /* end of include guard: GRADIENT_H_ */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "inviwotomrc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "inviwo/datfile.h"
+#include "util/byteswap.h"
+#include "util/dataformat.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! The raw file is read in blocks of this size.
+constexpr size_t readBlockBytes_c = 32 << 20;
+
+float length(const std::array<float, 3> &v)
+{
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+//! Angle between two vectors in degrees, 90 if either vanishes.
+float angle(const std::array<float, 3> &a, const std::array<float, 3> &b)
+{
+    const float lengths = length(a) * length(b);
+    if (!(lengths > 0))
+    {
+        return 90;
+    }
+    const float cosine = (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]) / lengths;
+    return std::acos(std::max(-1.0f, std::min(1.0f, cosine))) * 180 / float(M_PI);
+}
+
+//! Look up a number in the meta data of the .dat file.
+bool meta_number(const DatFile &datFile, const std::string & key, double * value)
+{
+    for (const std::pair<std::string, std::string> &entry : datFile.metaData)
+    {
+        if (entry.first == key)
+        {
+            char * end = nullptr;
+            *value     = strtod(entry.second.c_str(), &end);
+            return end != entry.second.c_str();
+        }
+    }
+    return false;
+}
+
+}   // namespace
+
+MrcHeader datMrcHeader(const DatFile &datFile)
+{
+    MrcHeader header;
+    header.setEMDBDefaults();
+    std::array<float, 3> firstVoxel = datFile.offset;
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        header.num_crs[dim]     = datFile.resolution[dim];
+        header.extend[dim]      = datFile.resolution[dim];
+        header.cell_length[dim] = length(datFile.basis[dim]);
+        // the offset is the volume corner, half a voxel before the first voxel center
+        for (size_t i = 0; i < 3; ++i)
+        {
+            firstVoxel[i] += datFile.resolution[dim] > 0 ? 0.5f * datFile.basis[dim][i] / datFile.resolution[dim] : 0;
+        }
+    }
+    // a sequence becomes a volume stack of MZ sections per volume
+    header.num_crs[2] *= int(datFile.sequences);
+    header.cell_angles = {{ angle(datFile.basis[1], datFile.basis[2]), angle(datFile.basis[0], datFile.basis[2]),
+                            angle(datFile.basis[0], datFile.basis[1]) }};
+    // extra holds header words 38-52, the MRC2014 origin is in words 50-52
+    header.extra[12] = firstVoxel[0];
+    header.extra[13] = firstVoxel[1];
+    header.extra[14] = firstVoxel[2];
+    const std::string::size_type slash = datFile.rawFile.find_last_of('/');
+    header.labels[0]  = "inviwo-convert: " + datFile.rawFile.substr(slash == std::string::npos ? 0 : slash + 1);
+    header.num_labels = 1;
+    return header;
+}
+
+std::string mrcOutputName(const std::string & datFilename)
+{
+    const std::string extension = ".dat";
+    const bool        hasDat    = datFilename.size() > extension.size()
+        && datFilename.compare(datFilename.size() - extension.size(), extension.size(), extension) == 0;
+    return (hasDat ? datFilename.substr(0, datFilename.size() - extension.size()) : datFilename) + ".mrc";
+}
+
+namespace
+{
+
+void convert_file(const std::string & datFilename, MrcFileWriter::Endianness endianness)
+{
+    const DatFile datFile = DatFile::read(datFilename);
+    DataFormat    format;
+    if (!formatFromName(datFile.format, &format))
+    {
+        throw std::runtime_error("Cannot write values of format " + datFile.format + " to an mrc file.");
+    }
+    double       scale  = 1;
+    double       offset = 0;
+    const bool   dequantize  = meta_number(datFile, "QuantizationScale", &scale) && meta_number(datFile, "QuantizationOffset", &offset);
+    const bool   swap        = datFile.bigEndian != hostIsBigEndian();
+    const size_t valueBytes  = formatBytes(format);
+    const size_t numValues   = size_t(std::max(datFile.resolution[0], 0)) * size_t(std::max(datFile.resolution[1], 0))
+        * size_t(std::max(datFile.resolution[2], 0)) * datFile.sequences;
+
+    const std::string mrcFileName = mrcOutputName(datFilename);
+    PosixFile         raw(datFile.rawFile, PosixFile::Mode::Read);
+    MrcFileWriter     writer(mrcFileName, datMrcHeader(datFile), dequantize ? DataFormat::FLOAT32 : format, endianness);
+    std::vector<char>  block(std::min(numValues, readBlockBytes_c / valueBytes) * valueBytes);
+    std::vector<float> restored(dequantize ? block.size() / valueBytes : 0);
+    const size_t       valuesPerBlock = readBlockBytes_c / valueBytes;
+    for (size_t first = 0; first < numValues; first += valuesPerBlock)
+    {
+        const size_t count = std::min(valuesPerBlock, numValues - first);
+        {
+            ScopedStage stage(Stage::Read, count * valueBytes);
+            raw.readAt(block.data(), count * valueBytes, datFile.byteOffset + first * valueBytes);
+        }
+        if (swap)
+        {
+            ScopedStage stage(Stage::Decode, count * valueBytes);
+            swapBytes(block.data(), count, valueBytes);
+        }
+        if (!dequantize)
+        {
+            writer.write(block.data(), count);
+            continue;
+        }
+        {
+            // value = offset + stored * scale
+            ScopedStage stage(Stage::Quantize, count * sizeof(float));
+            toFloat(block.data(), format, restored.data(), count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                restored[i] = float(offset + restored[i] * scale);
+            }
+        }
+        writer.write(restored.data(), count);
+    }
+    writer.finish();
+    fprintf(stderr, "Wrote \"%s\"\n", mrcFileName.c_str());
+}
+
+}   // namespace
+
+void convertInviwoToMrc(const std::string & datFilename, MrcFileWriter::Endianness endianness, bool reportStages)
+{
+    StageReport report;
+    {
+        ReportScope scope(reportStages ? &report : nullptr);
+        convert_file(datFilename, endianness);
+    }
+    if (reportStages)
+    {
+        printf("%s\n", report.json(datFilename).c_str());
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Conversion of Inviwo raw/dat volumes back to mrc files.
+ */
+
+#ifndef INVIWOTOMRC_H_
+#define INVIWOTOMRC_H_
+
+#include <string>
+
+#include "mrc/mrcfilewriter.h"
+#include "mrc/mrcheader.h"
+
+struct DatFile;
+
+/*! \brief Describe an Inviwo volume as mrc header, the inverse of mrcDatFile().
+ *
+ * The basis vectors give cell lengths and angles, the offset the MRC2014 origin
+ * at the center of the first voxel. A sequence becomes a volume stack, its volumes one after the other along z.
+ */
+MrcHeader datMrcHeader(const DatFile &datFile);
+
+//! The name of the mrc file written for a .dat file, e.g. emd_1234.map.mrc for emd_1234.map.dat.
+std::string mrcOutputName(const std::string & datFilename);
+
+/*! \brief Convert an Inviwo volume to an mrc file named mrcOutputName(datFilename).
+ *
+ * The raw file is streamed in large blocks through MrcFileWriter, which measures the
+ * density statistics on the way. Volumes quantized by this program, which record
+ * QuantizationScale and QuantizationOffset, are restored to float values.
+ * \param[in] reportStages print the duration and throughput of each stage as a line of JSON to stdout
+ * \throws std::runtime_error if reading or writing fails
+ */
+void convertInviwoToMrc(const std::string & datFilename, MrcFileWriter::Endianness endianness, bool reportStages = false);
+
+#endif /* end of include guard: INVIWOTOMRC_H_ */
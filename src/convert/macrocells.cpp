@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "macrocells.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "mrc/mrcheader.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Voxels per parallel task; smaller sections run on the calling thread.
+constexpr size_t voxelsPerTask_c = 1 << 16;
+
+const MacrocellRange emptyRange_c = { std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+/*! \brief Merge values into the running minima and maxima of the same index.
+ *
+ * Comparisons with NaN are false, so NaN values are skipped. The loop has no branches, so it vectorizes.
+ */
+void merge_values(const float * values, size_t count, float * minima, float * maxima)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        minima[i] = values[i] < minima[i] ? values[i] : minima[i];
+        maxima[i] = values[i] > maxima[i] ? values[i] : maxima[i];
+    }
+}
+
+void merge_range(const MacrocellRange &range, MacrocellRange * target)
+{
+    target->min = std::min(target->min, range.min);
+    target->max = std::max(target->max, range.max);
+}
+
+//! First and one past the last voxel covered by cell index of cellSize voxels, including the first voxel of the next cell.
+std::array<size_t, 2> cell_voxels(size_t index, size_t cellSize, size_t size)
+{
+    return {{ index * cellSize, std::min(index * cellSize + cellSize + 1, size) }};
+}
+
+}   // namespace
+
+MacrocellWriter::MacrocellWriter(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                                 size_t cellSize, size_t numLevels) :
+    region_(region), format_(format), fileName_(baseName + ".macrocells"), cellSize_(cellSize),
+    section_(region.size[0] * region.size[1]), numConsumed_(0)
+{
+    if (cellSize == 0)
+    {
+        throw std::invalid_argument("Macrocells need at least one voxel along each axis.");
+    }
+    std::array<size_t, 3> numCells;
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        numCells[dim] = (region.size[dim] + cellSize - 1) / cellSize;
+    }
+    levelSizes_.push_back(numCells);
+    while (levelSizes_.size() < numLevels && numCells[0] * numCells[1] * numCells[2] > 1)
+    {
+        for (size_t &extent : numCells)
+        {
+            extent = (extent + 1) / 2;
+        }
+        levelSizes_.push_back(numCells);
+    }
+    levels_.resize(levelSizes_.size());
+    levels_[0].assign(levelSizes_[0][0] * levelSizes_[0][1] * levelSizes_[0][2], emptyRange_c);
+    sectionCells_.resize(levelSizes_[0][0] * levelSizes_[0][1]);
+
+    std::memset(&header_, 0, sizeof(header_));
+    std::memcpy(header_.magic, "MRCCELLS", sizeof(header_.magic));
+    header_.version   = 1;
+    header_.numLevels = uint32_t(levelSizes_.size());
+    header_.cellSize  = uint32_t(cellSize);
+    const std::array<float, 3> voxelSize  = mrcVoxelSize(header);
+    const std::array<float, 3> firstVoxel = mrcFirstVoxelPosition(header);
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        header_.gridExtend[dim]  = header.extend[dim];
+        header_.volumeSize[dim]  = region.size[dim];
+        header_.regionBegin[dim] = region.begin[dim];
+        header_.voxelSize[dim]   = voxelSize[dim];
+        header_.offset[dim]      = firstVoxel[dim] + (float(region.begin[dim]) - 0.5f) * voxelSize[dim];
+    }
+}
+
+std::vector<std::array<size_t, 3> > MacrocellWriter::levelSizes() const
+{
+    return levelSizes_;
+}
+
+void MacrocellWriter::consume(const Slab & slab)
+{
+    ScopedStage  stage(Stage::Derived, slab.data.size());
+    const size_t sectionBytes = section_.size() * formatBytes(format_);
+    if (levels_[0].empty())
+    {
+        return;
+    }
+    for (size_t offset = 0; offset + sectionBytes <= slab.data.size(); offset += sectionBytes)
+    {
+        add_section_(slab.data.data() + offset, numConsumed_++);
+    }
+}
+
+void MacrocellWriter::add_section_(const char * values, size_t z)
+{
+    toFloat(values, format_, section_.data(), section_.size());
+    const size_t width       = region_.size[0];
+    const size_t numCellsX   = levelSizes_[0][0];
+    // reduce the rows of each row of cells first, then the voxels of each cell along x
+    parallelFor(levelSizes_[0][1], [this, width, numCellsX](size_t cy) {
+            std::vector<float>          minima(width, emptyRange_c.min);
+            std::vector<float>          maxima(width, emptyRange_c.max);
+            const std::array<size_t, 2> rows = cell_voxels(cy, cellSize_, region_.size[1]);
+            for (size_t y = rows[0]; y < rows[1]; ++y)
+            {
+                merge_values(section_.data() + y * width, width, minima.data(), maxima.data());
+            }
+            for (size_t cx = 0; cx < numCellsX; ++cx)
+            {
+                const std::array<size_t, 2> columns = cell_voxels(cx, cellSize_, width);
+                MacrocellRange             &cell    = sectionCells_[cy * numCellsX + cx];
+                cell.min = *std::min_element(minima.begin() + columns[0], minima.begin() + columns[1]);
+                cell.max = *std::max_element(maxima.begin() + columns[0], maxima.begin() + columns[1]);
+            }
+        }, section_.size() >= voxelsPerTask_c ? 0 : 1);
+
+    // the first section of a layer of cells also belongs to the layer before
+    if (z % cellSize_ == 0 && z > 0)
+    {
+        merge_into_layer_(z / cellSize_ - 1);
+    }
+    merge_into_layer_(z / cellSize_);
+}
+
+void MacrocellWriter::merge_into_layer_(size_t cz)
+{
+    MacrocellRange * layer = levels_[0].data() + cz * sectionCells_.size();
+    for (size_t i = 0; i < sectionCells_.size(); ++i)
+    {
+        merge_range(sectionCells_[i], layer + i);
+    }
+}
+
+void MacrocellWriter::finish()
+{
+    ScopedStage stage(Stage::Derived);
+    if (numConsumed_ != region_.size[2])
+    {
+        throw std::runtime_error("Volume ended before all macrocells of \"" + fileName_ + "\" were computed.");
+    }
+    for (size_t level = 1; level < levels_.size(); ++level)
+    {
+        const std::array<size_t, 3> &size      = levelSizes_[level];
+        const std::array<size_t, 3> &finer     = levelSizes_[level - 1];
+        std::vector<MacrocellRange> &cells     = levels_[level];
+        cells.assign(size[0] * size[1] * size[2], emptyRange_c);
+        for (size_t z = 0; z < finer[2]; ++z)
+        {
+            for (size_t y = 0; y < finer[1]; ++y)
+            {
+                for (size_t x = 0; x < finer[0]; ++x)
+                {
+                    merge_range(levels_[level - 1][(z * finer[1] + y) * finer[0] + x], &cells[((z / 2) * size[1] + y / 2) * size[0] + x / 2]);
+                }
+            }
+        }
+    }
+
+    std::vector<MacrocellLevel> levels(levels_.size());
+    uint64_t                    offset = sizeof(MacrocellHeader) + levels.size() * sizeof(MacrocellLevel);
+    for (size_t level = 0; level < levels.size(); ++level)
+    {
+        levels[level].cellSize = cellSize_ << level;
+        for (size_t dim = 0; dim < 3; ++dim)
+        {
+            levels[level].numCells[dim] = levelSizes_[level][dim];
+        }
+        levels[level].offset = offset;
+        offset              += levels_[level].size() * sizeof(MacrocellRange);
+    }
+    PosixFile file(fileName_, PosixFile::Mode::Write);
+    file.write(&header_, sizeof(header_));
+    file.write(levels.data(), levels.size() * sizeof(MacrocellLevel));
+    for (const std::vector<MacrocellRange> &cells : levels_)
+    {
+        file.write(cells.data(), cells.size() * sizeof(MacrocellRange));
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Grids of value ranges over blocks of a volume, for renderers that skip empty space.
+ */
+
+#ifndef MACROCELLS_H_
+#define MACROCELLS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "convert/slab.h"
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+
+struct MrcHeader;
+
+/*! \brief Layout of the macrocell file.
+ *
+ * The file starts with this header, followed by one MacrocellLevel per level, finest first,
+ * and the value ranges of the cells of all levels. All numbers are in the byte order of the writing machine.
+ */
+struct MacrocellHeader
+{
+    char     magic[8];       //!< "MRCCELLS"
+    uint32_t version;        //!< layout version, currently 1
+    uint32_t numLevels;      //!< number of levels of cells
+    int32_t  gridExtend[3];  //!< sampling intervals per unit cell along x, y and z of the source mrc file (NX, NY, NZ)
+    uint32_t cellSize;       //!< voxels along each axis of a cell of the finest level
+    uint64_t volumeSize[3];  //!< voxels along x, y and z of the volume
+    uint64_t regionBegin[3]; //!< index of the first voxel of the volume along x, y and z of the mrc grid
+    float    voxelSize[3];   //!< voxel spacing along x, y and z in Aangstrom
+    float    offset[3];      //!< world position of the volume corner in Aangstrom, as in the .dat file
+};
+
+//! Number and position of the cells of a level.
+struct MacrocellLevel
+{
+    uint64_t cellSize;    //!< voxels along each axis of a cell, doubling from level to level
+    uint64_t numCells[3]; //!< cells along x, y and z
+    uint64_t offset;      //!< byte offset of the first MacrocellRange of the level in the file
+};
+
+/*! \brief Smallest and largest value of a cell.
+ *
+ * A cell with only NaN values has min infinity and max minus infinity.
+ */
+struct MacrocellRange
+{
+    float min;
+    float max;
+};
+
+/*! \brief Writes the value ranges of cubes of cellSize voxels, and optionally of coarser levels of an octree.
+ *
+ * Each cell also covers the first voxel of the next cell along each axis, so that its range
+ * bounds all values interpolated inside the cell. A cell of a coarser level covers eight
+ * cells of the level below. Cells reaching beyond the volume cover only the voxels inside.
+ *
+ * Only a section and the ranges of the finest level are held in memory.
+ * Consumed slabs must be ordered x fastest, then y, then z.
+ */
+class MacrocellWriter : public SlabSink
+{
+public:
+    /*! \brief Prepare writing baseName.macrocells.
+     *
+     * \param[in] region    the part of the mrc grid that is consumed
+     * \param[in] numLevels the finest level and numLevels - 1 coarser ones, fewer if a single cell covers the volume before
+     */
+    MacrocellWriter(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                    size_t cellSize, size_t numLevels);
+
+    void consume(const Slab & slab) override;
+    //! Combine the coarser levels and write the file.
+    void finish() override;
+
+    //! Number of cells along x, y and z of each level, finest first.
+    std::vector<std::array<size_t, 3> > levelSizes() const;
+
+private:
+    //! Merge the ranges of the cells in the section at z into the layers of cells it belongs to.
+    void add_section_(const char * values, size_t z);
+    //! Merge the cell ranges of the current section into the layer of cells at cz.
+    void merge_into_layer_(size_t cz);
+
+    GridRegion                                 region_;
+    DataFormat                                 format_;
+    std::string                                fileName_;
+    MacrocellHeader                            header_;
+    size_t                                     cellSize_;
+    std::vector<std::array<size_t, 3> >        levelSizes_;
+    std::vector<float>                         section_;      //!< the consumed section as float
+    std::vector<MacrocellRange>                sectionCells_; //!< ranges of the cells of the current section
+    std::vector<std::vector<MacrocellRange> >  levels_;       //!< ranges of the cells of each level, finest first
+    size_t                                     numConsumed_;
+};
+
+#endif /* end of include guard: MACROCELLS_H_ */
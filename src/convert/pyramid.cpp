@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "pyramid.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "convert/converter.h"
+#include "inviwo/datfile.h"
+#include "util/stagereport.h"
+
+struct PyramidWriter::Level
+{
+    Level(const std::string &rawFileName, const std::array<size_t, 3> &levelSize) :
+        file(rawFileName, PosixFile::Mode::Write), size(levelSize),
+        accumulator(levelSize[0] * levelSize[1]), numCombined(0), numEmitted(0) {}
+    PosixFile             file;
+    std::array<size_t, 3> size;
+    std::vector<float>    accumulator; //!< the section currently being combined
+    size_t                numCombined; //!< sections of the previous level in the accumulator
+    size_t                numEmitted;  //!< sections written so far
+};
+
+namespace
+{
+
+std::string level_file_name(const std::string &baseName, size_t level, const std::string &extension)
+{
+    return baseName + "." + std::to_string(size_t(1) << level) + "x" + extension;
+}
+
+template <typename Combine>
+void combine_section(const float * section, const std::array<size_t, 3> &sectionSize, float * accumulator,
+                     size_t accumulatorWidth, Combine combine)
+{
+    for (size_t y = 0; y < sectionSize[1]; ++y)
+    {
+        const float * row    = section + y * sectionSize[0];
+        float       * target = accumulator + (y / 2) * accumulatorWidth;
+        for (size_t x = 0; x < sectionSize[0]; ++x)
+        {
+            combine(target[x / 2], row[x]);
+        }
+    }
+}
+
+}   // namespace
+
+PyramidWriter::PyramidWriter(const MrcHeader &header, const GridRegion &region, DataFormat format,
+                             const std::string &baseName, size_t numLevels, Reduction reduction) :
+    header_(header), region_(region), format_(format), baseName_(baseName), reduction_(reduction),
+    section_(region.size[0] * region.size[1]), output_(region.size[0] * region.size[1] * formatBytes(format)),
+    numConsumed_(0)
+{
+    std::array<size_t, 3> size = region.size;
+    for (size_t level = 1; level <= numLevels; ++level)
+    {
+        for (size_t &extent : size)
+        {
+            extent = (extent + 1) / 2;
+        }
+        levels_.emplace_back(new Level(level_file_name(baseName, level, ".raw"), size));
+    }
+}
+
+PyramidWriter::~PyramidWriter()
+{
+}
+
+std::vector<std::array<size_t, 3> > PyramidWriter::levelSizes() const
+{
+    std::vector<std::array<size_t, 3> > sizes;
+    for (const std::unique_ptr<Level> &level : levels_)
+    {
+        sizes.push_back(level->size);
+    }
+    return sizes;
+}
+
+void PyramidWriter::consume(const Slab & slab)
+{
+    ScopedStage stage(Stage::Derived, slab.data.size());
+    if (levels_.empty())
+    {
+        return;
+    }
+    const size_t sectionVoxels = region_.size[0] * region_.size[1];
+    const size_t sectionBytes  = sectionVoxels * formatBytes(format_);
+    for (size_t offset = 0; offset + sectionBytes <= slab.data.size(); offset += sectionBytes)
+    {
+        toFloat(slab.data.data() + offset, format_, section_.data(), sectionVoxels);
+        add_section_(0, section_.data(), numConsumed_++);
+    }
+}
+
+void PyramidWriter::add_section_(size_t index, const float * section, size_t z)
+{
+    Level                       &level       = *levels_[index];
+    const std::array<size_t, 3> &sectionSize = index == 0 ? region_.size : levels_[index - 1]->size;
+    if (level.numCombined == 0)
+    {
+        float initial = 0;
+        if (reduction_ == Reduction::Min)
+        {
+            initial = std::numeric_limits<float>::infinity();
+        }
+        else if (reduction_ == Reduction::Max)
+        {
+            initial = -std::numeric_limits<float>::infinity();
+        }
+        std::fill(level.accumulator.begin(), level.accumulator.end(), initial);
+    }
+    switch (reduction_)
+    {
+        case Reduction::Mean:
+            combine_section(section, sectionSize, level.accumulator.data(), level.size[0],
+                            [](float &target, float value) { target += value; });
+            break;
+        case Reduction::Min:
+            combine_section(section, sectionSize, level.accumulator.data(), level.size[0],
+                            [](float &target, float value) { target = std::min(target, value); });
+            break;
+        case Reduction::Max:
+            combine_section(section, sectionSize, level.accumulator.data(), level.size[0],
+                            [](float &target, float value) { target = std::max(target, value); });
+            break;
+    }
+    ++level.numCombined;
+    if (z % 2 == 1 || z + 1 == sectionSize[2])
+    {
+        emit_section_(index, sectionSize);
+    }
+}
+
+void PyramidWriter::emit_section_(size_t index, const std::array<size_t, 3> &sectionSize)
+{
+    Level &level = *levels_[index];
+    if (reduction_ == Reduction::Mean)
+    {
+        // blocks at the upper border of odd-sized sections combine fewer voxels
+        for (size_t y = 0; y < level.size[1]; ++y)
+        {
+            const size_t numY = std::min<size_t>(2, sectionSize[1] - 2 * y);
+            for (size_t x = 0; x < level.size[0]; ++x)
+            {
+                const size_t numX = std::min<size_t>(2, sectionSize[0] - 2 * x);
+                level.accumulator[y * level.size[0] + x] /= float(numX * numY * level.numCombined);
+            }
+        }
+    }
+    fromFloat(level.accumulator.data(), format_, output_.data(), level.accumulator.size());
+    level.file.write(output_.data(), level.accumulator.size() * formatBytes(format_));
+    level.numCombined = 0;
+    if (index + 1 < levels_.size())
+    {
+        add_section_(index + 1, level.accumulator.data(), level.numEmitted);
+    }
+    ++level.numEmitted;
+}
+
+void PyramidWriter::finish()
+{
+    ScopedStage stage(Stage::Derived);
+    for (size_t index = 0; index < levels_.size(); ++index)
+    {
+        const Level &level   = *levels_[index];
+        const size_t factor  = size_t(1) << (index + 1);
+        DatFile      datFile = mrcDatFile(header_, format_, level.file.filename(), region_);
+        // the level covers whole blocks, which may reach beyond the upper border of the volume
+        for (size_t dim = 0; dim < 3; ++dim)
+        {
+            datFile.resolution[dim]  = int(level.size[dim]);
+            datFile.basis[dim][dim] *= float(factor * level.size[dim]) / float(region_.size[dim]);
+        }
+        datFile.write(level_file_name(baseName_, index + 1, ".dat"));
+    }
+}
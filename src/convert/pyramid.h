@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Multiresolution pyramid of a volume, built while the volume streams by.
+ */
+
+#ifndef PYRAMID_H_
+#define PYRAMID_H_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "convert/slab.h"
+#include "mrc/mrcgrid.h"
+#include "mrc/mrcheader.h"
+#include "util/dataformat.h"
+#include "util/posixfile.h"
+
+/*! \brief Writes coarser levels of a volume, each halving the resolution of the previous one.
+ *
+ * Level n combines blocks of 2^n voxels along each axis; blocks at the upper border
+ * of the volume are cut off. Every level keeps a single accumulating section, which is
+ * handed to the next level and appended to the level's raw file as soon as both
+ * sections it combines have been seen, so memory use does not grow with the volume size.
+ * Consumed slabs must be ordered x fastest, then y, then z.
+ */
+class PyramidWriter : public SlabSink
+{
+public:
+    enum class Reduction
+    {
+        Mean, //!< average of the voxels in a block
+        Min,  //!< smallest value in a block
+        Max   //!< largest value in a block
+    };
+
+    /*! \brief Prepare writing levels 1 to numLevels of a volume.
+     *
+     * Level n is written to baseName.<2^n>x.raw and described in baseName.<2^n>x.dat
+     * in the same type as the consumed slabs.
+     * \param[in] region the part of the mrc grid that is consumed
+     */
+    PyramidWriter(const MrcHeader &header, const GridRegion &region, DataFormat format,
+                  const std::string &baseName, size_t numLevels, Reduction reduction);
+    ~PyramidWriter();
+
+    void consume(const Slab & slab) override;
+    //! Write the .dat files of all levels.
+    void finish() override;
+
+    //! Number of voxels along x, y and z of each level, starting with level 1.
+    std::vector<std::array<size_t, 3> > levelSizes() const;
+
+private:
+    struct Level;
+
+    //! Combine a section of the previous level into level.
+    void add_section_(size_t level, const float * section, size_t z);
+    //! Write the accumulated section of level and pass it on to the next level.
+    void emit_section_(size_t level, const std::array<size_t, 3> &sectionSize);
+
+    MrcHeader                             header_;
+    GridRegion                            region_;
+    DataFormat                            format_;
+    std::string                           baseName_;
+    Reduction                             reduction_;
+    std::vector<std::unique_ptr<Level> >  levels_;
+    std::vector<float>                    section_; //!< a consumed section converted to float
+    std::vector<char>                     output_;  //!< an emitted section converted to the output type
+    size_t                                numConsumed_;
+};
+
+#endif /* end of include guard: PYRAMID_H_ */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "quantizer.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "inviwo/datfile.h"
+#include "mrc/mrcheader.h"
+#include "util/quantiles.h"
+#include "util/stagereport.h"
+#include "util/valuestatistics.h"
+
+namespace
+{
+
+bool header_has_rms(const MrcHeader &header)
+{
+    return std::isfinite(header.mean_value) && std::isfinite(header.rms_value) && header.rms_value > 0;
+}
+
+std::string to_text(double value)
+{
+    std::ostringstream text;
+    text.precision(std::numeric_limits<double>::max_digits10);
+    text << value;
+    return text.str();
+}
+
+}   // namespace
+
+bool quantizationNeedsValues(const QuantizationOptions &options, const MrcHeader &header)
+{
+    switch (options.range)
+    {
+        case QuantizationOptions::Range::Header:
+            return false;
+        case QuantizationOptions::Range::Sigma:
+            return !header_has_rms(header);
+        default:
+            return true;
+    }
+}
+
+Quantization chooseQuantization(const QuantizationOptions &options, const MrcHeader &header,
+                                const ValueStatistics * statistics, const QuantileHistogram * quantiles)
+{
+    if (quantizationNeedsValues(options, header)
+        && (statistics == nullptr || (options.range == QuantizationOptions::Range::Percentile && quantiles == nullptr)))
+    {
+        throw std::logic_error("The quantization range needs measured values.");
+    }
+    if (quantizationNeedsValues(options, header) && statistics->count() == 0)
+    {
+        // without finite values any range will do
+        return Quantization(options.format, 0, 0);
+    }
+    switch (options.range)
+    {
+        case QuantizationOptions::Range::Header:
+            if (!std::isfinite(header.min_value) || !std::isfinite(header.max_value) || !(header.min_value < header.max_value))
+            {
+                throw std::runtime_error("The mrc header records no valid density range, quantize to the measured range instead.");
+            }
+            return Quantization(options.format, header.min_value, header.max_value);
+        case QuantizationOptions::Range::Measured:
+            return Quantization(options.format, statistics->min(), statistics->max());
+        case QuantizationOptions::Range::Percentile:
+            return Quantization(options.format, quantiles->quantile(options.percentile / 100),
+                                quantiles->quantile(1 - options.percentile / 100));
+        case QuantizationOptions::Range::Sigma:
+        default:
+        {
+            const bool   fromHeader = header_has_rms(header);
+            const double mean       = fromHeader ? header.mean_value : statistics->mean();
+            const double rms        = fromHeader ? header.rms_value : statistics->rms();
+            return Quantization(options.format, mean - options.sigmas * rms, mean + options.sigmas * rms);
+        }
+    }
+}
+
+void applyQuantization(const Quantization &quantization, DatFile * datFile)
+{
+    datFile->format     = formatName(quantization.format());
+    datFile->hasRange   = true;
+    datFile->dataRange  = {{ 0.0, double(quantization.maxStored()) }};
+    datFile->valueRange = {{ quantization.lower(), quantization.upper() }};
+    // value = offset + stored * scale
+    datFile->metaData.emplace_back("QuantizationScale", to_text(quantization.scale()));
+    datFile->metaData.emplace_back("QuantizationOffset", to_text(quantization.offset()));
+}
+
+QuantizingSink::QuantizingSink(const Quantization &quantization) : quantization_(quantization)
+{
+    quantized_.format = quantization.format();
+}
+
+void QuantizingSink::addSink(SlabSink * sink)
+{
+    sinks_.push_back(sink);
+}
+
+void QuantizingSink::consume(const Slab & slab)
+{
+    const size_t count = slab.data.size() / formatBytes(slab.format);
+    quantized_.index        = slab.index;
+    quantized_.firstSection = slab.firstSection;
+    quantized_.numSections  = slab.numSections;
+    quantized_.data.resize(count * formatBytes(quantized_.format));
+    {
+        ScopedStage stage(Stage::Quantize, slab.data.size());
+        quantize(slab.data.data(), slab.format, quantization_, quantized_.data.data(), count);
+    }
+    for (SlabSink * sink : sinks_)
+    {
+        sink->consume(quantized_);
+    }
+}
+
+void QuantizingSink::finish()
+{
+    for (SlabSink * sink : sinks_)
+    {
+        sink->finish();
+    }
+}
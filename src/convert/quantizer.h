@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Choice of the quantized value range and quantization of streamed slabs.
+ */
+
+#ifndef QUANTIZER_H_
+#define QUANTIZER_H_
+
+#include <vector>
+
+#include "convert/slab.h"
+#include "util/dataformat.h"
+#include "util/quantize.h"
+
+struct DatFile;
+struct MrcHeader;
+class QuantileHistogram;
+class ValueStatistics;
+
+//! How values are quantized to unsigned integers.
+struct QuantizationOptions
+{
+    //! Which values map to the ends of the quantized range.
+    enum class Range
+    {
+        Header,     //!< minimum and maximum density recorded in the mrc header
+        Measured,   //!< smallest and largest value in the volume
+        Percentile, //!< clip the given percentage of values at either end
+        Sigma       //!< mean plus and minus a number of rms deviations, from the header if it records them
+    };
+    QuantizationOptions() : format(DataFormat::UINT8), range(Range::Measured), percentile(0.1), sigmas(3) {}
+    DataFormat format;     //!< UINT8 or UINT16
+    Range      range;
+    double     percentile; //!< percentage of the values clipped at either end for Range::Percentile
+    double     sigmas;     //!< number of rms deviations on either side of the mean for Range::Sigma
+};
+
+/*! \brief True if the range of the quantization depends on the values, which then are measured before quantizing.
+ *
+ * The statistics of the values are needed, and for Range::Percentile also their quantiles.
+ */
+bool quantizationNeedsValues(const QuantizationOptions &options, const MrcHeader &header);
+
+/*! \brief The quantization the options ask for.
+ *
+ * \param[in] statistics statistics of the values, may be null unless quantizationNeedsValues()
+ * \param[in] quantiles quantiles of the values, may be null unless quantizationNeedsValues() for Range::Percentile
+ * \throws std::runtime_error if the header records no valid range for Range::Header
+ */
+Quantization chooseQuantization(const QuantizationOptions &options, const MrcHeader &header,
+                                const ValueStatistics * statistics, const QuantileHistogram * quantiles);
+
+/*! \brief Record how stored values map back to the original values.
+ *
+ * The .dat data range spans the stored values and the value range the original values,
+ * so Inviwo recovers the values; scale and offset are recorded explicitly as well.
+ */
+void applyQuantization(const Quantization &quantization, DatFile * datFile);
+
+/*! \brief Quantizes consumed slabs and hands them on to its own sinks.
+ */
+class QuantizingSink : public SlabSink
+{
+public:
+    explicit QuantizingSink(const Quantization &quantization);
+
+    //! Add a sink that receives the quantized slabs; the sink must outlive this one.
+    void addSink(SlabSink * sink);
+    void consume(const Slab & slab) override;
+    void finish() override;
+
+private:
+    Quantization             quantization_;
+    Slab                     quantized_;
+    std::vector<SlabSink *>  sinks_;
+};
+
+#endif /* end of include guard: QUANTIZER_H_ */
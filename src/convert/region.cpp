@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "region.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "convert/axisorder.h"
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcheader.h"
+#include "util/datasource.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+/*! \brief Largest gap between the needed parts of two rows that is read rather than skipped.
+ *
+ * The kernel reads whole pages anyway, so skipping small gaps saves no I/O but costs system calls.
+ */
+constexpr size_t maxSkippedGapBytes_c = 16 << 10;
+
+}   // namespace
+
+GridRegion regionToGrid(const RegionOfInterest &roi, const MrcHeader &header)
+{
+    const std::array<size_t, 3> gridSize   = mrcGridSize(header);
+    const std::array<float, 3>  voxelSize  = mrcVoxelSize(header);
+    const std::array<float, 3>  firstVoxel = mrcFirstVoxelPosition(header);
+
+    GridRegion region;
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        double lower = roi.lower[dim];
+        double upper = roi.upper[dim];
+        if (roi.units == RegionOfInterest::Units::Angstrom)
+        {
+            lower = std::ceil((lower - firstVoxel[dim]) / voxelSize[dim]);
+            upper = std::floor((upper - firstVoxel[dim]) / voxelSize[dim]) + 1;
+        }
+        lower = std::max(lower, 0.0);
+        upper = std::min(upper, double(gridSize[dim]));
+        if (upper <= lower)
+        {
+            throw std::runtime_error("The region of interest contains no voxels of the map.");
+        }
+        region.begin[dim] = size_t(lower);
+        region.size[dim]  = size_t(upper) - size_t(lower);
+    }
+    return region;
+}
+
+std::vector<char> extractRegion(const std::string &filename, const GridRegion &region, bool widenToFloat,
+                                DataFormat * format)
+{
+    const MrcFileView view(filename, MrcFileView::DataAccess::HeaderOnly);
+    const MrcHeader  &header      = view.header();
+    const DataFormat  stored      = mrcStoredFormat(header);
+    *format                       = widenToFloat ? DataFormat::FLOAT32 : stored;
+    const size_t      valueBytes  = formatBytes(stored);
+
+    // the region in file order
+    const std::array<size_t, 3> numCrs = mrcNumCrs(header);
+    std::array<size_t, 3>       crsBegin;
+    std::array<size_t, 3>       crsSize;
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        crsBegin[crs] = region.begin[header.crs_to_xyz[crs]];
+        crsSize[crs]  = region.size[header.crs_to_xyz[crs]];
+    }
+
+    const size_t fileRowBytes = numCrs[0] * valueBytes;
+    const size_t rowBytes     = crsSize[0] * valueBytes;
+    const bool   readSpan     = fileRowBytes - rowBytes <= maxSkippedGapBytes_c;
+    const size_t spanBytes    = (crsSize[1] - 1) * fileRowBytes + rowBytes;
+
+    const DataSource &input = view.source();
+    std::vector<char> storedData(crsSize[0] * crsSize[1] * crsSize[2] * valueBytes);
+    std::vector<char> span(readSpan && rowBytes != fileRowBytes ? spanBytes : 0);
+    {
+        ScopedStage stage(Stage::Read, storedData.size());
+        for (size_t section = 0; section < crsSize[2]; ++section)
+        {
+            const size_t firstRowOffset = view.dataOffset()
+                + ((crsBegin[2] + section) * numCrs[1] + crsBegin[1]) * fileRowBytes + crsBegin[0] * valueBytes;
+            char * destination = storedData.data() + section * crsSize[1] * rowBytes;
+            if (rowBytes == fileRowBytes)
+            {
+                // whole rows are contiguous in the file
+                input.readAt(destination, crsSize[1] * rowBytes, firstRowOffset);
+            }
+            else if (readSpan)
+            {
+                input.readAt(span.data(), spanBytes, firstRowOffset);
+                for (size_t row = 0; row < crsSize[1]; ++row)
+                {
+                    std::memcpy(destination + row * rowBytes, span.data() + row * fileRowBytes, rowBytes);
+                }
+            }
+            else
+            {
+                for (size_t row = 0; row < crsSize[1]; ++row)
+                {
+                    input.readAt(destination + row * rowBytes, rowBytes, firstRowOffset + row * fileRowBytes);
+                }
+            }
+        }
+    }
+
+    const size_t      numVoxels = storedData.size() / valueBytes;
+    std::vector<char> decoded;
+    {
+        ScopedStage stage(Stage::Decode, numVoxels * formatBytes(*format));
+        if (*format == stored)
+        {
+            decodeVoxels(storedData.data(), numVoxels, stored, header.swap_bytes);
+            decoded.swap(storedData);
+        }
+        else
+        {
+            decoded.resize(numVoxels * formatBytes(*format));
+            widenVoxels(storedData.data(), reinterpret_cast<float *>(decoded.data()), numVoxels, stored, header.swap_bytes);
+            std::vector<char>().swap(storedData);
+        }
+    }
+
+    if (!mrcHasStandardAxisOrder(header))
+    {
+        ScopedStage       stage(Stage::Reorder, decoded.size());
+        std::vector<char> reordered(decoded.size());
+        reorderToXyz(decoded.data(), reordered.data(), crsSize, header.crs_to_xyz, formatBytes(*format));
+        decoded.swap(reordered);
+    }
+    return decoded;
+}
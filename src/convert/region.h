@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Extraction of a region of interest that reads only the voxels it needs.
+ */
+
+#ifndef REGION_H_
+#define REGION_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+
+struct MrcHeader;
+
+//! A box given in voxel indices or in Aangstrom along x, y and z.
+struct RegionOfInterest
+{
+    enum class Units
+    {
+        Voxels,  //!< indices into the stored grid, the upper corner is exclusive
+        Angstrom //!< positions in space, voxels whose centers lie inside the box are selected
+    };
+    RegionOfInterest() : units(Units::Voxels), lower({{0, 0, 0}}), upper({{0, 0, 0}}) {}
+    Units                units;
+    std::array<float, 3> lower; //!< lower corner along x, y and z
+    std::array<float, 3> upper; //!< upper corner along x, y and z
+};
+
+/*! \brief The voxels of the grid inside the region of interest.
+ *
+ * Positions in Aangstrom are converted with the voxel size and first voxel position
+ * of the header; the result is clipped to the grid.
+ * \throws std::runtime_error if no voxel lies inside the region
+ */
+GridRegion regionToGrid(const RegionOfInterest &roi, const MrcHeader &header);
+
+/*! \brief Read the voxels of a region of the grid, reordered to x, y, z.
+ *
+ * Only the rows of the sections that intersect the region are read, with positioned reads.
+ * Rows of a section that lie close together in the file are read in one go.
+ * Compressed files are decompressed up to the last row needed, skipped rows are dropped.
+ * \param[in] widenToFloat decode to float values instead of the type stored in the file
+ * \param[out] format the type of the returned values
+ * \returns the voxel bytes of the region
+ */
+std::vector<char> extractRegion(const std::string &filename, const GridRegion &region, bool widenToFloat,
+                                DataFormat * format);
+
+#endif /* end of include guard: REGION_H_ */
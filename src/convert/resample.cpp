@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include "convert/converter.h"
+#include "inviwo/datfile.h"
+#include "mrc/mrcheader.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+namespace
+{
+
+//! Lobes of the Lanczos window on either side of the center.
+constexpr double lanczosLobes_c = 3;
+//! Voxels per parallel task; smaller steps run on the calling thread.
+constexpr size_t voxelsPerTask_c = 1 << 16;
+
+/*! \brief The input voxels and weights that make up each output voxel along one axis.
+ *
+ * Every output voxel has numTaps taps with ascending indices; taps beyond the border
+ * repeat the border voxel, taps outside the filter window have zero weight.
+ */
+struct AxisFilter
+{
+    size_t              numTaps;
+    std::vector<size_t> index;  //!< numTaps input indices per output voxel
+    std::vector<float>  weight; //!< numTaps weights per output voxel, summing to one
+
+    size_t first(size_t output) const { return index[output * numTaps]; }
+    size_t last(size_t output) const { return index[output * numTaps + numTaps - 1]; }
+};
+
+double sinc(double x)
+{
+    return x == 0 ? 1 : std::sin(M_PI * x) / (M_PI * x);
+}
+
+/*! \brief Taps that resample numInput voxels of size inputSize to numOutput voxels of size outputSize.
+ *
+ * Both grids start at the same corner, so output voxel j is centered at input index
+ * (j + 1/2) outputSize / inputSize - 1/2.
+ */
+AxisFilter axis_filter(size_t numInput, double inputSize, size_t numOutput, double outputSize, ResampleWriter::Filter filter)
+{
+    // shrinking widens the sinc so it removes the frequencies the coarser grid cannot hold
+    const double scale  = filter == ResampleWriter::Filter::Sinc ? std::max(1.0, outputSize / inputSize) : 1.0;
+    const double radius = filter == ResampleWriter::Filter::Sinc ? lanczosLobes_c * scale : 1.0;
+    AxisFilter   result;
+    result.numTaps = filter == ResampleWriter::Filter::Sinc ? 2 * size_t(std::ceil(radius)) + 1 : 2;
+    result.index.resize(numOutput * result.numTaps);
+    result.weight.resize(numOutput * result.numTaps);
+    for (size_t j = 0; j < numOutput; ++j)
+    {
+        const double center = (j + 0.5) * outputSize / inputSize - 0.5;
+        const double lowest = filter == ResampleWriter::Filter::Sinc ? std::ceil(center - radius) : std::floor(center);
+        size_t     * index  = result.index.data() + j * result.numTaps;
+        float      * weight = result.weight.data() + j * result.numTaps;
+        double       sum    = 0;
+        for (size_t t = 0; t < result.numTaps; ++t)
+        {
+            const double position = lowest + double(t);
+            const double distance = std::abs(position - center) / scale;
+            double       w        = 0;
+            if (filter == ResampleWriter::Filter::Trilinear)
+            {
+                w = std::max(0.0, 1 - distance);
+            }
+            else if (distance < lanczosLobes_c)
+            {
+                w = sinc(distance) * sinc(distance / lanczosLobes_c);
+            }
+            index[t]  = size_t(std::min(std::max(position, 0.0), double(numInput - 1)));
+            weight[t] = float(w);
+            sum      += w;
+        }
+        for (size_t t = 0; t < result.numTaps; ++t)
+        {
+            weight[t] = sum != 0 ? float(weight[t] / sum) : (t == 0 ? 1.0f : 0.0f);
+        }
+    }
+    return result;
+}
+
+//! target[i] = weight * source[i], or target[i] += weight * source[i] when accumulating.
+void scale_add(const float * source, float weight, float * target, size_t count, bool accumulate)
+{
+    if (accumulate)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            target[i] += weight * source[i];
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            target[i] = weight * source[i];
+        }
+    }
+}
+
+std::string resampled_file_name(const std::string &baseName, const std::string &extension)
+{
+    return baseName + ".resampled" + extension;
+}
+
+}   // namespace
+
+class ResampleWriter::Impl
+{
+public:
+    Impl(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+         const std::array<float, 3> &voxelSize, Filter filter);
+
+    //! Resample consecutive input sections along y and x into planes.
+    void add_sections_(const float * sections, size_t numSections);
+    //! Combine and write the output sections whose input planes have all arrived.
+    void emit_ready_sections_();
+
+    MrcHeader             header_;
+    GridRegion            region_;
+    DataFormat            format_;
+    std::string           baseName_;
+    std::array<float, 3>  voxelSize_;
+    std::array<size_t, 3> size_;
+    std::array<AxisFilter, 3> filters_;
+    PosixFile             file_;
+
+    std::vector<float>              input_;      //!< consumed sections converted to float
+    std::deque<std::vector<float> > planes_;     //!< input sections resampled along y and x
+    size_t                          firstPlane_; //!< input section of planes_.front()
+    size_t                          numPlanes_;  //!< input sections resampled so far
+    size_t                          numEmitted_; //!< output sections written so far
+    std::vector<float>              output_;     //!< output sections being combined
+    std::vector<char>               converted_;  //!< output sections converted to the output type
+};
+
+ResampleWriter::Impl::Impl(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                           const std::array<float, 3> &voxelSize, Filter filter) :
+    header_(header), region_(region), format_(format), baseName_(baseName), voxelSize_(voxelSize),
+    file_(resampled_file_name(baseName, ".raw"), PosixFile::Mode::Write), firstPlane_(0), numPlanes_(0), numEmitted_(0)
+{
+    const std::array<float, 3> inputSize = mrcVoxelSize(header);
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        if (!(voxelSize[dim] > 0) || !std::isfinite(voxelSize[dim]))
+        {
+            throw std::runtime_error("The voxel size to resample to must be positive.");
+        }
+        // as many voxels of the target size as fit the box best, at least one
+        const double extent = double(region.size[dim]) * inputSize[dim];
+        size_[dim]    = std::max<size_t>(1, size_t(std::llround(extent / voxelSize[dim])));
+        filters_[dim] = axis_filter(region.size[dim], inputSize[dim], size_[dim], voxelSize[dim], filter);
+    }
+}
+
+void ResampleWriter::Impl::add_sections_(const float * sections, size_t numSections)
+{
+    const size_t inputVoxels = region_.size[0] * region_.size[1];
+    const size_t planeVoxels = size_[0] * size_[1];
+    const size_t firstNew    = planes_.size();
+    for (size_t s = 0; s < numSections; ++s)
+    {
+        planes_.emplace_back(planeVoxels);
+    }
+    const size_t rowsPerTask  = std::max<size_t>(1, voxelsPerTask_c / std::max<size_t>(region_.size[0], 1));
+    const size_t tasksPerPlane = (size_[1] + rowsPerTask - 1) / rowsPerTask;
+    const size_t numTasks     = numSections * tasksPerPlane;
+    parallelFor(numTasks, [&](size_t task) {
+                    const size_t       s       = task / tasksPerPlane;
+                    const float      * section = sections + s * inputVoxels;
+                    float            * plane   = planes_[firstNew + s].data();
+                    const AxisFilter  &alongX  = filters_[0];
+                    const AxisFilter  &alongY  = filters_[1];
+                    std::vector<float> row(region_.size[0]);
+                    const size_t       end     = std::min(size_[1], (task % tasksPerPlane + 1) * rowsPerTask);
+                    for (size_t y = (task % tasksPerPlane) * rowsPerTask; y < end; ++y)
+                    {
+                        // combine whole input rows along y, then pick the taps along x
+                        for (size_t t = 0; t < alongY.numTaps; ++t)
+                        {
+                            scale_add(section + alongY.index[y * alongY.numTaps + t] * region_.size[0],
+                                      alongY.weight[y * alongY.numTaps + t], row.data(), row.size(), t > 0);
+                        }
+                        float * target = plane + y * size_[0];
+                        for (size_t x = 0; x < size_[0]; ++x)
+                        {
+                            const size_t * index  = alongX.index.data() + x * alongX.numTaps;
+                            const float  * weight = alongX.weight.data() + x * alongX.numTaps;
+                            float          value  = 0;
+                            for (size_t t = 0; t < alongX.numTaps; ++t)
+                            {
+                                value += weight[t] * row[index[t]];
+                            }
+                            target[x] = value;
+                        }
+                    }
+                }, numSections * inputVoxels >= voxelsPerTask_c ? 0 : 1);
+    numPlanes_ += numSections;
+}
+
+void ResampleWriter::Impl::emit_ready_sections_()
+{
+    const AxisFilter &alongZ   = filters_[2];
+    size_t            numReady = 0;
+    while (numEmitted_ + numReady < size_[2] && alongZ.last(numEmitted_ + numReady) < numPlanes_)
+    {
+        ++numReady;
+    }
+    if (numReady == 0)
+    {
+        return;
+    }
+    const size_t planeVoxels   = size_[0] * size_[1];
+    const size_t chunksPerPlane = (planeVoxels + voxelsPerTask_c - 1) / voxelsPerTask_c;
+    output_.resize(numReady * planeVoxels);
+    parallelFor(numReady * chunksPerPlane, [&](size_t task) {
+                    const size_t k     = numEmitted_ + task / chunksPerPlane;
+                    const size_t begin = (task % chunksPerPlane) * voxelsPerTask_c;
+                    const size_t count = std::min(planeVoxels - begin, voxelsPerTask_c);
+                    float      * target = output_.data() + (task / chunksPerPlane) * planeVoxels + begin;
+                    for (size_t t = 0; t < alongZ.numTaps; ++t)
+                    {
+                        const std::vector<float> &plane = planes_[alongZ.index[k * alongZ.numTaps + t] - firstPlane_];
+                        scale_add(plane.data() + begin, alongZ.weight[k * alongZ.numTaps + t], target, count, t > 0);
+                    }
+                }, numReady * planeVoxels >= voxelsPerTask_c ? 0 : 1);
+
+    converted_.resize(output_.size() * formatBytes(format_));
+    fromFloat(output_.data(), format_, converted_.data(), output_.size());
+    file_.write(converted_.data(), converted_.size());
+    numEmitted_ += numReady;
+
+    // later output sections only need planes from their first tap on
+    const size_t firstNeeded = numEmitted_ < size_[2] ? alongZ.first(numEmitted_) : numPlanes_;
+    while (firstPlane_ < firstNeeded && !planes_.empty())
+    {
+        planes_.pop_front();
+        ++firstPlane_;
+    }
+}
+
+ResampleWriter::ResampleWriter(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                               const std::array<float, 3> &voxelSize, Filter filter) :
+    impl_(new Impl(header, region, format, baseName, voxelSize, filter))
+{
+}
+
+ResampleWriter::~ResampleWriter()
+{
+}
+
+std::array<size_t, 3> ResampleWriter::size() const
+{
+    return impl_->size_;
+}
+
+void ResampleWriter::consume(const Slab & slab)
+{
+    ScopedStage  stage(Stage::Derived, slab.data.size());
+    Impl        &impl         = *impl_;
+    const size_t inputVoxels  = impl.region_.size[0] * impl.region_.size[1];
+    const size_t numSections  = slab.data.size() / std::max<size_t>(inputVoxels * formatBytes(impl.format_), 1);
+    impl.input_.resize(numSections * inputVoxels);
+    toFloat(slab.data.data(), impl.format_, impl.input_.data(), impl.input_.size());
+    impl.add_sections_(impl.input_.data(), numSections);
+    impl.emit_ready_sections_();
+}
+
+void ResampleWriter::finish()
+{
+    ScopedStage stage(Stage::Derived);
+    Impl       &impl = *impl_;
+    if (impl.numEmitted_ != impl.size_[2])
+    {
+        throw std::runtime_error("The volume ended before all resampled sections were written.");
+    }
+    // the resampled voxels cover the box of the consumed ones, starting at the same corner
+    DatFile datFile = mrcDatFile(impl.header_, impl.format_, impl.file_.filename(), impl.region_);
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        datFile.resolution[dim]  = int(impl.size_[dim]);
+        datFile.basis[dim][dim]  = impl.voxelSize_[dim] * float(impl.size_[dim]);
+    }
+    datFile.write(resampled_file_name(impl.baseName_, ".dat"));
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Resampling of a volume to another voxel size, built while the volume streams by.
+ */
+
+#ifndef RESAMPLE_H_
+#define RESAMPLE_H_
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "convert/slab.h"
+#include "mrc/mrcgrid.h"
+#include "util/dataformat.h"
+
+struct MrcHeader;
+
+/*! \brief Writes a volume resampled to a target voxel size.
+ *
+ * The resampled volume covers the same box as the consumed one, with as many voxels of the
+ * target size as fit best, and voxels at the border repeating outwards. The filter is separable:
+ * each consumed section is resampled along y and x as it arrives, and a section of the output
+ * is combined from the few resampled sections around it once the last of them has arrived, so
+ * memory use does not grow with the volume size. Rows and sections are spread over all threads.
+ * Consumed slabs must be ordered x fastest, then y, then z.
+ */
+class ResampleWriter : public SlabSink
+{
+public:
+    enum class Filter
+    {
+        Trilinear, //!< linear interpolation between the two nearest voxels along each axis
+        Sinc       //!< Lanczos windowed sinc with three lobes, widened to low-pass filter when shrinking
+    };
+
+    /*! \brief Prepare writing baseName.resampled.raw and baseName.resampled.dat.
+     *
+     * The values keep the type of the consumed slabs; integer types round and clamp.
+     * \param[in] region    the part of the mrc grid that is consumed
+     * \param[in] voxelSize target voxel size along x, y and z in Aangstrom
+     */
+    ResampleWriter(const MrcHeader &header, const GridRegion &region, DataFormat format, const std::string &baseName,
+                   const std::array<float, 3> &voxelSize, Filter filter);
+    ~ResampleWriter();
+
+    void consume(const Slab & slab) override;
+    //! Write the .dat file of the resampled volume.
+    void finish() override;
+
+    //! Number of voxels along x, y and z of the resampled volume.
+    std::array<size_t, 3> size() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif /* end of include guard: RESAMPLE_H_ */
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "sequence.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+#include "mrc/mrcheader.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+#include "util/threadpool.h"
+#include "util/valuestatistics.h"
+
+namespace
+{
+
+//! Bytes of copied sections waiting to be written before consume() blocks.
+constexpr size_t bytesInFlight_c = 128 << 20;
+
+//! Space group of image stacks.
+constexpr int imageStackSpaceGroup_c = 0;
+//! Volume stacks use the space groups of single volumes plus 400.
+constexpr int firstVolumeStackSpaceGroup_c = 401;
+
+std::runtime_error uneven_split(size_t numSections, const std::string & into)
+{
+    return std::runtime_error("Cannot split " + std::to_string(numSections) + " sections into " + into
+                              + ", the volumes of a sequence must have the same size.");
+}
+
+}   // namespace
+
+SequenceLayout sequenceLayout(const MrcHeader &header, const SequenceOptions &options)
+{
+    SequenceLayout layout;
+    layout.numSections = size_t(std::max(header.num_crs[2], 0));
+    if (layout.numSections == 0)
+    {
+        throw std::runtime_error("A file without sections cannot be split into volumes.");
+    }
+    if (options.sectionsPerVolume > 0)
+    {
+        layout.sectionsPerVolume = std::min(options.sectionsPerVolume, layout.numSections);
+    }
+    else if (options.numVolumes > 0)
+    {
+        if (layout.numSections % options.numVolumes != 0)
+        {
+            throw uneven_split(layout.numSections, std::to_string(options.numVolumes) + " volumes");
+        }
+        layout.sectionsPerVolume = layout.numSections / options.numVolumes;
+    }
+    else if (header.space_group == imageStackSpaceGroup_c)
+    {
+        layout.sectionsPerVolume = 1;
+    }
+    else if (header.space_group >= firstVolumeStackSpaceGroup_c)
+    {
+        // the sections of one volume of a volume stack, MZ
+        const size_t mz = size_t(std::max(header.extend[2], 0));
+        layout.sectionsPerVolume = mz > 0 ? std::min(mz, layout.numSections) : layout.numSections;
+    }
+    else
+    {
+        throw std::runtime_error("The header describes a single volume (space group " + std::to_string(header.space_group)
+                                 + "), give the number of volumes with --sequence <n> or their size with --sequence-sections <n>.");
+    }
+    if (layout.numSections % layout.sectionsPerVolume != 0)
+    {
+        throw uneven_split(layout.numSections, "volumes of " + std::to_string(layout.sectionsPerVolume) + " sections");
+    }
+    return layout;
+}
+
+std::string sequenceVolumeName(const std::string & baseName, const SequenceLayout &layout, size_t volume)
+{
+    const size_t numDigits = std::max<size_t>(std::to_string(layout.numVolumes() - 1).size(), 3);
+    std::string  number    = std::to_string(volume);
+    return baseName + "." + std::string(numDigits - std::min(numDigits, number.size()), '0') + number;
+}
+
+class SequenceWriter::Impl
+{
+public:
+    //! A volume of the sequence while its sections are being written.
+    struct Volume
+    {
+        Volume(DataFormat format, size_t numSections) : statistics(isIntegerFormat(format)), remainingSections(numSections) {}
+        std::mutex                 mutex;             //!< guards statistics
+        ValueStatistics            statistics;
+        std::atomic<size_t>        remainingSections;
+    };
+
+    Impl(const std::string & rawFileName, const SequenceLayout &layout, const std::array<size_t, 3> &gridSize,
+         DataFormat format, bool statistics);
+    void consume_(const Slab & slab);
+    //! Copy the slab data, counting the bytes in flight until the last write of the copy has finished.
+    std::shared_ptr<const std::vector<char> > copy_(const std::vector<char> &data);
+    //! Write sections [first, first + count) of a volume from the copied slab data.
+    void write_(size_t volume, size_t first, size_t count, const char * values);
+
+    SequenceLayout          layout_;
+    DataFormat              format_;
+    bool                    measure_;
+    size_t                  sectionBytes_;
+    PosixFile               file_;
+    std::vector<std::unique_ptr<Volume> > volumes_;
+
+    std::mutex              inFlightMutex_;
+    std::condition_variable inFlightReleased_;
+    size_t                  bytesInFlight_;
+    //! declared last, so its destructor waits for all writes while the file and the volumes still exist
+    ThreadPool              pool_;
+};
+
+SequenceWriter::Impl::Impl(const std::string & rawFileName, const SequenceLayout &layout, const std::array<size_t, 3> &gridSize,
+                           DataFormat format, bool statistics)
+    : layout_(layout), format_(format), measure_(statistics),
+      sectionBytes_(gridSize[0] * gridSize[1] * formatBytes(format)), file_(rawFileName, PosixFile::Mode::Write), bytesInFlight_(0)
+{
+    if (gridSize[2] != layout.numSections)
+    {
+        throw std::runtime_error("The sections of a sequence must run along z.");
+    }
+    for (size_t volume = 0; volume < layout.numVolumes(); ++volume)
+    {
+        volumes_.emplace_back(new Volume(format, layout.sectionsPerVolume));
+    }
+}
+std::shared_ptr<const std::vector<char> > SequenceWriter::Impl::copy_(const std::vector<char> &data)
+{
+    const size_t bytes = data.size();
+    {
+        std::unique_lock<std::mutex> lock(inFlightMutex_);
+        inFlightReleased_.wait(lock, [this, bytes] { return bytesInFlight_ == 0 || bytesInFlight_ + bytes <= bytesInFlight_c; });
+        bytesInFlight_ += bytes;
+    }
+    return std::shared_ptr<const std::vector<char> >(new std::vector<char>(data), [this, bytes](const std::vector<char> * copy) {
+                                                         delete copy;
+                                                         {
+                                                             std::lock_guard<std::mutex> lock(inFlightMutex_);
+                                                             bytesInFlight_ -= bytes;
+                                                         }
+                                                         inFlightReleased_.notify_all();
+                                                     });
+}
+
+void SequenceWriter::Impl::consume_(const Slab & slab)
+{
+    if (slab.format != format_)
+    {
+        throw std::runtime_error("Slab values differ from the format of the sequence.");
+    }
+    std::shared_ptr<const std::vector<char> > data   = copy_(slab.data);
+    StageReport                             * report = StageReport::current();
+    const size_t end = slab.firstSection + slab.numSections;
+    for (size_t section = slab.firstSection; section < end; )
+    {
+        const size_t volume = section / layout_.sectionsPerVolume;
+        const size_t count  = std::min(end, layout_.firstSection(volume + 1)) - section;
+        const char * values = data->data() + (section - slab.firstSection) * sectionBytes_;
+        pool_.submit([this, volume, section, count, values, data, report]() {
+                         ReportScope scope(report);
+                         write_(volume, section, count, values);
+                     });
+        section += count;
+    }
+}
+
+void SequenceWriter::Impl::write_(size_t volume, size_t first, size_t count, const char * values)
+{
+    Volume &target = *volumes_[volume];
+    const size_t bytes = count * sectionBytes_;
+    if (measure_)
+    {
+        ScopedStage     stage(Stage::Statistics, bytes);
+        ValueStatistics part(isIntegerFormat(format_));
+        part.add(values, format_, bytes / formatBytes(format_));
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.statistics.merge(part);
+    }
+    {
+        ScopedStage stage(Stage::Write, bytes);
+        file_.writeAt(values, bytes, first * sectionBytes_);
+    }
+    target.remainingSections -= count;
+}
+
+SequenceWriter::SequenceWriter(const std::string & rawFileName, const SequenceLayout &layout, const std::array<size_t, 3> &gridSize,
+                               DataFormat format, bool statistics)
+    : impl_(new Impl(rawFileName, layout, gridSize, format, statistics))
+{
+}
+
+SequenceWriter::~SequenceWriter() = default;
+
+void SequenceWriter::consume(const Slab & slab)
+{
+    impl_->consume_(slab);
+}
+
+void SequenceWriter::finish()
+{
+    impl_->pool_.wait();
+    for (const std::unique_ptr<Impl::Volume> &volume : impl_->volumes_)
+    {
+        if (volume->remainingSections != 0)
+        {
+            throw std::runtime_error("The sequence ended before all sections of its volumes were written.");
+        }
+    }
+}
+
+const std::string &SequenceWriter::rawFileName() const
+{
+    return impl_->file_.filename();
+}
+
+size_t SequenceWriter::volumeBytes() const
+{
+    return impl_->layout_.sectionsPerVolume * impl_->sectionBytes_;
+}
+
+const ValueStatistics &SequenceWriter::statistics(size_t volume) const
+{
+    return impl_->volumes_[volume]->statistics;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Splits the sections of image stacks and volume stacks into a sequence of volumes.
+ */
+
+#ifndef SEQUENCE_H_
+#define SEQUENCE_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "convert/slab.h"
+#include "util/dataformat.h"
+
+struct MrcHeader;
+class ValueStatistics;
+
+//! How to split the sections of a file into volumes.
+struct SequenceOptions
+{
+    SequenceOptions() : numVolumes(0), sectionsPerVolume(0) {}
+    size_t numVolumes;        //!< number of volumes, zero to take the volume size from sectionsPerVolume or the header
+    size_t sectionsPerVolume; //!< sections per volume, zero to take it from numVolumes or the header
+};
+
+//! How the sections of a file divide into the volumes of a sequence, all with the same number of sections.
+struct SequenceLayout
+{
+    size_t numSections;       //!< sections in the file
+    size_t sectionsPerVolume; //!< sections of every volume, a divisor of numSections
+
+    size_t numVolumes() const { return numSections / sectionsPerVolume; }
+    size_t firstSection(size_t volume) const { return volume * sectionsPerVolume; }
+};
+
+/*! \brief Divide the sections of an mrc file into volumes of equal size.
+ *
+ * Without a count or size in the options, volume stacks (space group 401 and above) are split
+ * into the MZ sections of each volume, and image stacks (space group 0) into single images.
+ * The header of any other file describes a single volume, which needs a count or size.
+ * Inviwo plays back only sequences of volumes of the same size, so splits that leave a
+ * shorter last volume are rejected rather than padded with made-up values.
+ * \throws std::runtime_error if the sections do not divide into volumes of equal size, or if the
+ *         header of a single volume gives no split
+ */
+SequenceLayout sequenceLayout(const MrcHeader &header, const SequenceOptions &options);
+
+//! Name of a volume of the sequence, e.g. base.007 for the eighth of at most a thousand volumes.
+std::string sequenceVolumeName(const std::string & baseName, const SequenceLayout &layout, size_t volume);
+
+/*! \brief Writes the slabs of a volume stack in x, y, z order to one raw file and measures each volume of a sequence.
+ *
+ * The volumes follow each other in the raw file, as Inviwo reads sequences of a .dat file with a
+ * Sequences entry. The sections of each slab are copied and written by pool threads at their position
+ * in the raw file, so the writes and the statistics of the volumes overlap the sequential read of the
+ * input. The bytes waiting to be written are bounded; consume() blocks when the writes fall behind.
+ */
+class SequenceWriter : public SlabSink
+{
+public:
+    /*! \brief Prepare writing rawFileName.
+     *
+     * \param[in] gridSize   number of voxels along x, y and z of the whole stack
+     * \param[in] statistics measure the value statistics of each volume
+     */
+    SequenceWriter(const std::string & rawFileName, const SequenceLayout &layout, const std::array<size_t, 3> &gridSize,
+                   DataFormat format, bool statistics);
+    ~SequenceWriter();
+    void consume(const Slab & slab) override;
+    //! Wait for all writes; rethrows the first error of any of them.
+    void finish() override;
+
+    const std::string &rawFileName() const;
+    //! Bytes of each volume in the raw file.
+    size_t volumeBytes() const;
+    //! Statistics of the values of a volume, complete after finish().
+    const ValueStatistics &statistics(size_t volume) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif /* end of include guard: SEQUENCE_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Chunks of consecutive sections that flow through the streaming conversion.
+ */
+
+#ifndef SLAB_H_
+#define SLAB_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "util/dataformat.h"
+
+/*! \brief A number of consecutive sections of a volume.
+ *
+ * Within the slab, voxels are stored column fastest, then row, then section,
+ * or x fastest, then y, then z once the axes are reordered.
+ */
+struct Slab
+{
+    size_t            index;        //!< position of the slab in the stream, starting at zero
+    size_t            firstSection; //!< index of the first section in the volume
+    size_t            numSections;  //!< number of sections in this slab
+    DataFormat        format;       //!< type of the decoded voxel values
+    std::vector<char> data;         //!< decoded voxel bytes
+    std::vector<char> stored;       //!< scratch space, e.g. for the bytes as read from file when decoding widens the values
+};
+
+/*! \brief Receives the decoded slabs of a volume in order.
+ *
+ * Sinks are called from a single pipeline thread, one slab at a time,
+ * and must not keep references to the slab data after consume() returns.
+ */
+class SlabSink
+{
+public:
+    virtual ~SlabSink() {}
+    //! Process the next slab.
+    virtual void consume(const Slab & slab) = 0;
+    //! Called once after the last slab has been consumed.
+    virtual void finish() {}
+};
+
+#endif /* end of include guard: SLAB_H_ */
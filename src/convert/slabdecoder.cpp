@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "slabdecoder.h"
+#include "slab.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "convert/axisorder.h"
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcgrid.h"
+
+SlabDecoder::SlabDecoder(const MrcHeader &header, bool widenToFloat, bool reorderAxes) :
+    header_(header),
+    storedFormat_(mrcStoredFormat(header)),
+    format_(widenToFloat ? DataFormat::FLOAT32 : storedFormat_),
+    reorder_(reorderAxes && !mrcHasStandardAxisOrder(header))
+{
+    if (reorder_ && !sectionsRunAlongZ(header.crs_to_xyz))
+    {
+        throw std::runtime_error("Cannot reorder axes slab by slab, sections do not run along z.");
+    }
+}
+
+size_t SlabDecoder::storedSectionBytes() const
+{
+    return size_t(header_.num_crs[0]) * size_t(header_.num_crs[1]) * formatBytes(storedFormat_);
+}
+
+size_t SlabDecoder::sectionBytes() const
+{
+    return size_t(header_.num_crs[0]) * size_t(header_.num_crs[1]) * formatBytes(format_);
+}
+
+std::vector<char> &SlabDecoder::prepare(Slab * slab, size_t firstSection, size_t numSections) const
+{
+    slab->firstSection = firstSection;
+    slab->numSections  = numSections;
+    slab->format       = format_;
+    std::vector<char> &target = (format_ == storedFormat_) ? slab->data : slab->stored;
+    target.resize(numSections * storedSectionBytes());
+    return target;
+}
+
+void SlabDecoder::decode(Slab * slab, size_t numThreads) const
+{
+    const bool swap = header_.swap_bytes;
+    if (format_ == storedFormat_)
+    {
+        decodeVoxels(slab->data.data(), slab->data.size() / formatBytes(format_), format_, swap);
+    }
+    else
+    {
+        const size_t count = slab->stored.size() / formatBytes(storedFormat_);
+        slab->data.resize(count * formatBytes(format_));
+        widenVoxels(slab->stored.data(), reinterpret_cast<float *>(slab->data.data()), count, storedFormat_, swap);
+    }
+    if (reorder_)
+    {
+        // transpose columns and rows of each section into the scratch buffer, then swap roles
+        const std::array<size_t, 3> numCrs = {{ size_t(header_.num_crs[0]), size_t(header_.num_crs[1]), slab->numSections }};
+        slab->stored.resize(slab->data.size());
+        reorderToXyz(slab->data.data(), slab->stored.data(), numCrs, header_.crs_to_xyz, formatBytes(format_), numThreads);
+        std::swap(slab->data, slab->stored);
+    }
+}
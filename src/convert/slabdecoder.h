@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Turns slabs as read from an mrc file into native, x, y, z ordered slabs.
+ */
+
+#ifndef SLABDECODER_H_
+#define SLABDECODER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "mrc/mrcheader.h"
+#include "util/dataformat.h"
+
+struct Slab;
+
+/*! \brief Decodes slabs of sections independently of each other.
+ *
+ * Decoding fixes the endianess, optionally widens the values to float and
+ * reorders the axes. Slabs carry their own scratch space, so one decoder
+ * can serve several threads.
+ */
+class SlabDecoder
+{
+public:
+    /*! \brief Prepare decoding slabs of the file described by header.
+     *
+     * \throws std::runtime_error for unsupported data modes or if the axes
+     *         shall be reordered but the sections do not run along z
+     */
+    SlabDecoder(const MrcHeader &header, bool widenToFloat, bool reorderAxes);
+
+    //! Type of the values as stored in the file.
+    DataFormat storedFormat() const { return storedFormat_; }
+    //! Type of the decoded values.
+    DataFormat format() const { return format_; }
+    //! Number of bytes a section takes up in the file.
+    size_t storedSectionBytes() const;
+    //! Number of bytes a decoded section takes up.
+    size_t sectionBytes() const;
+
+    /*! \brief Set up slab to hold numSections sections starting at firstSection.
+     *
+     * \returns the buffer that needs to be filled with the stored bytes of these sections
+     */
+    std::vector<char> &prepare(Slab * slab, size_t firstSection, size_t numSections) const;
+    /*! \brief Decode the stored bytes of a prepared slab into Slab::data.
+     *
+     * \param[in] numThreads threads used for reordering, zero for threadBudget()
+     */
+    void decode(Slab * slab, size_t numThreads = 0) const;
+
+private:
+    MrcHeader  header_;
+    DataFormat storedFormat_;
+    DataFormat format_;
+    bool       reorder_;
+};
+
+#endif /* end of include guard: SLABDECODER_H_ */
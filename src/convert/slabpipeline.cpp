@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "slabpipeline.h"
+#include "slab.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "convert/slabdecoder.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcheader.h"
+#include "util/blockingqueue.h"
+#include "util/bufferpool.h"
+#include "util/datasource.h"
+#include "util/parallel.h"
+#include "util/stagereport.h"
+
+/*******************************************************************************
+ * SlabPipeline::Impl
+ */
+class SlabPipeline::Impl
+{
+    public:
+        Impl(const std::string & filename, const Options &options);
+
+        void read_slabs_();
+        void decode_slabs_();
+        void write_slabs_();
+
+        //! Run a stage, record its first error and stop all other stages on failure.
+        void run_stage_(void (Impl::*stage)(), BlockingQueue<Slab *> * output);
+        void abort_();
+
+        size_t num_sections_() const;
+
+        MrcFileView              view_;
+        Options                  options_;
+        SlabDecoder              decoder_;
+        std::vector<SlabSink *>  sinks_;
+
+        std::vector<Slab>        buffers_;
+        BlockingQueue<Slab *>    free_;
+        BlockingQueue<Slab *>    read_;
+        BlockingQueue<Slab *>    decoded_;
+
+        std::mutex               errorMutex_;
+        std::exception_ptr       error_;
+};
+
+SlabPipeline::Impl::Impl(const std::string & filename, const Options &options) :
+    view_(filename, MrcFileView::DataAccess::HeaderOnly),
+    options_(options),
+    decoder_(view_.header(), options.widenToFloat, options.reorderAxes)
+{
+    options_.sectionsPerSlab = std::max<size_t>(options_.sectionsPerSlab, 1);
+    options_.slabsInFlight   = std::max<size_t>(options_.slabsInFlight, 1);
+}
+
+size_t SlabPipeline::Impl::num_sections_() const
+{
+    return view_.header().num_crs[2];
+}
+
+void SlabPipeline::Impl::read_slabs_()
+{
+    const size_t sectionBytes = decoder_.storedSectionBytes();
+    const size_t numSections  = num_sections_();
+    size_t       index        = 0;
+    for (size_t first = 0; first < numSections; first += options_.sectionsPerSlab)
+    {
+        Slab * slab;
+        if (!free_.pop(&slab))
+        {
+            return;
+        }
+        slab->index = index++;
+        std::vector<char> &target = decoder_.prepare(slab, first, std::min(options_.sectionsPerSlab, numSections - first));
+        {
+            ScopedStage stage(Stage::Read, target.size());
+            view_.source().readAt(target.data(), target.size(), view_.dataOffset() + first * sectionBytes);
+        }
+        read_.push(slab);
+    }
+}
+
+void SlabPipeline::Impl::decode_slabs_()
+{
+    Slab * slab;
+    while (read_.pop(&slab))
+    {
+        {
+            ScopedStage stage(Stage::Decode);
+            decoder_.decode(slab);
+            stage.addBytes(slab->data.size());
+        }
+        decoded_.push(slab);
+    }
+}
+
+void SlabPipeline::Impl::write_slabs_()
+{
+    Slab * slab;
+    while (decoded_.pop(&slab))
+    {
+        for (SlabSink * sink : sinks_)
+        {
+            sink->consume(*slab);
+        }
+        free_.push(slab);
+    }
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (error_)
+        {
+            return;
+        }
+    }
+    for (SlabSink * sink : sinks_)
+    {
+        sink->finish();
+    }
+}
+
+void SlabPipeline::Impl::run_stage_(void (Impl::*stage)(), BlockingQueue<Slab *> * output)
+{
+    try
+    {
+        (this->*stage)();
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            if (!error_)
+            {
+                error_ = std::current_exception();
+            }
+        }
+        abort_();
+    }
+    if (output != nullptr)
+    {
+        output->close();
+    }
+}
+
+void SlabPipeline::Impl::abort_()
+{
+    free_.close();
+    read_.close();
+    decoded_.close();
+}
+
+/*******************************************************************************
+ * SlabPipeline
+ */
+
+SlabPipeline::SlabPipeline(const std::string & filename, const Options &options) :
+    impl_(new SlabPipeline::Impl(filename, options))
+{
+}
+
+SlabPipeline::~SlabPipeline()
+{
+}
+
+const MrcHeader & SlabPipeline::header() const
+{
+    return impl_->view_.header();
+}
+
+DataFormat SlabPipeline::format() const
+{
+    return impl_->decoder_.format();
+}
+
+void SlabPipeline::addSink(SlabSink * sink)
+{
+    impl_->sinks_.push_back(sink);
+}
+
+void SlabPipeline::run()
+{
+    Impl &impl = *impl_;
+    impl.buffers_.resize(impl.options_.slabsInFlight);
+    for (Slab &slab : impl.buffers_)
+    {
+        slab.data = BufferPool::shared().acquire(impl.options_.sectionsPerSlab * impl.decoder_.sectionBytes());
+        impl.free_.push(&slab);
+    }
+    // scratch space is sized on demand, if the slabs are widened or reordered at all
+    for (Slab &slab : impl.buffers_)
+    {
+        slab.stored = BufferPool::shared().acquire(0);
+    }
+
+    // the stages report to the file being converted on the calling thread and share its thread budget
+    StageReport * report  = StageReport::current();
+    const size_t  budget  = threadBudget();
+    std::thread reader([&impl, report, budget] {
+                           ReportScope scope(report);
+                           ThreadBudgetScope budgetScope(budget);
+                           impl.run_stage_(&Impl::read_slabs_, &impl.read_);
+                       });
+    std::thread decoder([&impl, report, budget] {
+                            ReportScope scope(report);
+                            ThreadBudgetScope budgetScope(budget);
+                            impl.run_stage_(&Impl::decode_slabs_, &impl.decoded_);
+                        });
+    std::thread writer([&impl, report, budget] {
+                           ReportScope scope(report);
+                           ThreadBudgetScope budgetScope(budget);
+                           impl.run_stage_(&Impl::write_slabs_, nullptr);
+                       });
+    reader.join();
+    decoder.join();
+    writer.join();
+
+    for (Slab &slab : impl.buffers_)
+    {
+        BufferPool::shared().release(std::move(slab.data));
+        BufferPool::shared().release(std::move(slab.stored));
+    }
+    impl.buffers_.clear();
+    if (impl.error_)
+    {
+        std::rethrow_exception(impl.error_);
+    }
+}
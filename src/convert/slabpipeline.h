@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Streams the voxel data of an mrc file slab by slab through reader, decoder and writer threads.
+ */
+
+#ifndef SLABPIPELINE_H_
+#define SLABPIPELINE_H_
+
+#include <memory>
+#include <string>
+
+#include "util/dataformat.h"
+
+struct MrcHeader;
+class SlabSink;
+
+/*! \brief Bounded-memory conversion of mrc voxel data.
+ *
+ * A reader thread reads slabs of consecutive sections from the file, a decoder thread
+ * converts them to native endianess, optionally widening them to float and reordering
+ * the axes to x, y, z order, and a writer thread hands them to the sinks in order.
+ * Slab buffers are recycled, so at most Options::slabsInFlight slabs are held in memory,
+ * independent of the volume size.
+ */
+class SlabPipeline
+{
+public:
+    struct Options
+    {
+        Options() : sectionsPerSlab(1), slabsInFlight(4), widenToFloat(false), reorderAxes(true) {}
+        size_t sectionsPerSlab; //!< number of sections read at once
+        size_t slabsInFlight;   //!< number of slab buffers shared by all stages, at least one
+        bool   widenToFloat;    //!< decode all values to float instead of keeping the stored type
+        bool   reorderAxes;     //!< reorder each slab to x fastest, then y, then z
+    };
+
+    /*! \brief Prepare streaming the voxel data of filename.
+     *
+     * \throws std::runtime_error if the axes shall be reordered but the sections do not run
+     *         along z, because then slabs of sections are no slabs of the reordered volume
+     */
+    explicit SlabPipeline(const std::string & filename, const Options &options = Options());
+    ~SlabPipeline();
+
+    const MrcHeader & header() const;
+    //! Type of the voxel values handed to the sinks.
+    DataFormat format() const;
+    //! Add a sink that receives every decoded slab; the sink must outlive run().
+    void addSink(SlabSink * sink);
+    //! Stream all slabs through the sinks, call at most once; rethrows the first error of any stage.
+    void run();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif /* end of include guard: SLABPIPELINE_H_ */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "statisticssink.h"
+
+#include "util/stagereport.h"
+
+StatisticsSink::StatisticsSink(DataFormat format, bool quantiles) :
+    statistics_(isIntegerFormat(format)), countQuantiles_(quantiles)
+{
+}
+
+void StatisticsSink::consume(const Slab & slab)
+{
+    ScopedStage stage(Stage::Statistics, slab.data.size());
+    const size_t count = slab.data.size() / formatBytes(slab.format);
+    statistics_.merge(computeStatistics(slab.data.data(), slab.format, count));
+    if (countQuantiles_)
+    {
+        // a histogram per thread would cost more than counting small slabs here
+        quantiles_.add(slab.data.data(), slab.format, count);
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Accumulates value statistics of the slabs streaming by.
+ */
+
+#ifndef STATISTICSSINK_H_
+#define STATISTICSSINK_H_
+
+#include "convert/slab.h"
+#include "util/quantiles.h"
+#include "util/valuestatistics.h"
+
+/*! \brief Computes the statistics of every consumed slab in parallel and merges them.
+ *
+ * The slabs are summarized on their way to the writer, so the statistics
+ * need no second pass over the file.
+ */
+class StatisticsSink : public SlabSink
+{
+public:
+    //! \param[in] quantiles also count the values in a QuantileHistogram
+    explicit StatisticsSink(DataFormat format, bool quantiles = false);
+    void consume(const Slab & slab) override;
+
+    //! Statistics of all values consumed so far.
+    const ValueStatistics &statistics() const { return statistics_; }
+    //! Quantile histogram of all values consumed so far, empty unless requested on construction.
+    const QuantileHistogram &quantiles() const { return quantiles_; }
+
+private:
+    ValueStatistics   statistics_;
+    bool              countQuantiles_;
+    QuantileHistogram quantiles_;
+};
+
+#endif /* end of include guard: STATISTICSSINK_H_ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "watch.h"
+
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "convert/conversioncache.h"
+#include "convert/converter.h"
+#include "mrc/mrcfile.h"
+
+namespace
+{
+
+//! Interval at which the watch checks for a stop signal while waiting for files.
+constexpr int pollMilliseconds_c = 200;
+//! Bytes of inotify events read at once.
+constexpr size_t eventBufferBytes_c = 64 << 10;
+
+volatile sig_atomic_t stopRequested = 0;
+
+void request_stop(int)
+{
+    stopRequested = 1;
+}
+
+std::string path_in(const std::string &directory, const char * name)
+{
+    return directory.empty() || directory.back() == '/' ? directory + name : directory + "/" + name;
+}
+
+//! The mrc files directly in directory, sorted by name.
+std::set<std::string> list_mrc_files(const std::string &directory)
+{
+    DIR * stream = opendir(directory.c_str());
+    if (stream == nullptr)
+    {
+        throw std::runtime_error("Cannot read directory \"" + directory + "\": " + strerror(errno));
+    }
+    std::set<std::string> files;
+    while (const dirent * entry = readdir(stream))
+    {
+        const std::string path = path_in(directory, entry->d_name);
+        struct stat       status;
+        if (MrcFileView::hasMrcExtension(entry->d_name) && stat(path.c_str(), &status) == 0 && S_ISREG(status.st_mode))
+        {
+            files.insert(path);
+        }
+    }
+    closedir(stream);
+    return files;
+}
+
+/*! \brief Add the mrc files of the events waiting on fd to files.
+ *
+ * \returns false if events were lost because the queue of the kernel overflowed
+ */
+bool read_events(int fd, const std::string &directory, std::set<std::string> * files)
+{
+    alignas(inotify_event) char buffer[eventBufferBytes_c];
+    bool                        complete = true;
+    while (true)
+    {
+        const ssize_t size = read(fd, buffer, sizeof(buffer));
+        if (size <= 0)
+        {
+            if (size < 0 && errno != EAGAIN && errno != EINTR)
+            {
+                throw std::runtime_error("Cannot watch \"" + directory + "\": " + strerror(errno));
+            }
+            return complete;
+        }
+        for (ssize_t offset = 0; offset < size; )
+        {
+            const inotify_event * event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                complete = false;
+            }
+            else if (event->len > 0 && !(event->mask & IN_ISDIR) && MrcFileView::hasMrcExtension(event->name))
+            {
+                files->insert(path_in(directory, event->name));
+            }
+        }
+    }
+}
+
+void convert_files(const std::set<std::string> &files, const ConversionOptions &options, size_t numThreads, ConversionCache * cache)
+{
+    if (files.empty())
+    {
+        return;
+    }
+    const std::vector<std::string> filenames(files.begin(), files.end());
+    const size_t                   numFailed = convertCached(filenames, options, numThreads, cache);
+    if (numFailed > 0)
+    {
+        fprintf(stderr, "Failed to convert %zu of %zu files\n", numFailed, filenames.size());
+    }
+}
+
+void watch(int fd, const std::string &directory, const ConversionOptions &options, size_t numThreads, ConversionCache * cache)
+{
+    convert_files(list_mrc_files(directory), options, numThreads, cache);
+    fprintf(stderr, "Watching \"%s\" for mrc files\n", directory.c_str());
+    while (!stopRequested)
+    {
+        pollfd waiting {fd, POLLIN, 0};
+        if (poll(&waiting, 1, pollMilliseconds_c) <= 0)
+        {
+            continue;
+        }
+        std::set<std::string> files;
+        if (!read_events(fd, directory, &files))
+        {
+            fprintf(stderr, "Missed events of \"%s\", checking all its files\n", directory.c_str());
+            files = list_mrc_files(directory);
+        }
+        convert_files(files, options, numThreads, cache);
+    }
+}
+
+}   // namespace
+
+void watchDirectory(const std::string &directory, const ConversionOptions &options, size_t numThreads, ConversionCache * cache)
+{
+    if (!options.outputBase.empty())
+    {
+        throw std::runtime_error("--output names the outputs of a single file, not of a watched directory.");
+    }
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0 || inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR) < 0)
+    {
+        const std::runtime_error error("Cannot watch \"" + directory + "\": " + strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        throw error;
+    }
+
+    struct sigaction stop;
+    std::memset(&stop, 0, sizeof(stop));
+    stop.sa_handler = &request_stop;
+    struct sigaction previousInterrupt, previousTerminate;
+    sigaction(SIGINT, &stop, &previousInterrupt);
+    sigaction(SIGTERM, &stop, &previousTerminate);
+    stopRequested = 0;
+    try
+    {
+        watch(fd, directory, options, numThreads, cache);
+    }
+    catch (...)
+    {
+        sigaction(SIGINT, &previousInterrupt, nullptr);
+        sigaction(SIGTERM, &previousTerminate, nullptr);
+        close(fd);
+        throw;
+    }
+    sigaction(SIGINT, &previousInterrupt, nullptr);
+    sigaction(SIGTERM, &previousTerminate, nullptr);
+    close(fd);
+}
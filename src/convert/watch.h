@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Conversion of the mrc files that appear in a drop directory.
+ */
+
+#ifndef WATCH_H_
+#define WATCH_H_
+
+#include <cstddef>
+#include <string>
+
+class ConversionCache;
+struct ConversionOptions;
+
+/*! \brief Convert the mrc files in a directory, then every mrc file written to it, until SIGINT or SIGTERM.
+ *
+ * Files count as written when the writer closes them or when they are moved into the directory,
+ * as inotify reports with IN_CLOSE_WRITE and IN_MOVED_TO, so files are not converted half-written;
+ * write large files under another name and rename them when done, if they are written in several goes.
+ * Subdirectories are not watched. Files reported while a conversion runs are converted together afterwards.
+ *
+ * All files go through convertCached(), so files that did not change are skipped, e.g. when the
+ * conversion itself writes statistics back into the mrc header, and the manifest is saved after every batch.
+ * \param[in] numThreads number of threads converting a batch, zero for all hardware threads
+ * \throws std::runtime_error if the directory cannot be watched
+ */
+void watchDirectory(const std::string &directory, const ConversionOptions &options, size_t numThreads, ConversionCache * cache);
+
+#endif /* end of include guard: WATCH_H_ */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "datfile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "util/inputfiles.h"
+
+namespace
+{
+
+std::string base_name(const std::string & path)
+{
+    const size_t lastSlash = path.find_last_of('/');
+    return lastSlash == std::string::npos ? path : path.substr(lastSlash + 1);
+}
+
+std::string directory_name(const std::string & path)
+{
+    const size_t lastSlash = path.find_last_of('/');
+    return lastSlash == std::string::npos ? std::string() : path.substr(0, lastSlash + 1);
+}
+
+std::string trimmed(const std::string & text)
+{
+    const size_t first = text.find_first_not_of(" \t\r");
+    const size_t last  = text.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+}
+
+std::string lower_case(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return text;
+}
+
+//! Parse exactly N numbers separated by blanks.
+template <typename T, size_t N>
+std::array<T, N> parse_numbers(const std::string & key, const std::string & value)
+{
+    std::istringstream stream(value);
+    std::array<T, N>   numbers;
+    for (T &number : numbers)
+    {
+        if (!(stream >> number))
+        {
+            throw std::runtime_error("\"" + key + "\" expects " + std::to_string(N) + " numbers.");
+        }
+    }
+    return numbers;
+}
+
+}   // namespace
+
+void DatFile::write(const std::string & filename) const
+{
+    std::ofstream headerStream(filename,  std::ios::out);
+    if (!headerStream)
+    {
+        throw std::runtime_error("Cannot open \"" + filename + "\" for writing.");
+    }
+    // Inviwo looks for a relative raw file next to the .dat file
+    const bool besideDatFile = directory_name(rawFile) == directory_name(filename);
+    headerStream << "Rawfile: "  << (besideDatFile ? base_name(rawFile) : absolutePath(rawFile)) << std::endl;
+    headerStream << "Resolution: " << resolution[0] << " " << resolution[1] << " " << resolution[2] << std::endl;
+    headerStream << "Format: " << format << std::endl;
+    for (size_t i = 0; i < basis.size(); ++i)
+    {
+        headerStream << "BasisVector" << i + 1 << ": " << basis[i][0] << " " << basis[i][1] << " " << basis[i][2] << std::endl;
+    }
+    headerStream << "Offset: " << offset[0] << " " << offset[1] << " " << offset[2] << std::endl;
+    if (byteOffset > 0)
+    {
+        headerStream << "ByteOffset: " << byteOffset << std::endl;
+    }
+    if (bigEndian)
+    {
+        headerStream << "ByteOrder: BigEndian" << std::endl;
+    }
+    if (sequences > 1)
+    {
+        headerStream << "Sequences: " << sequences << std::endl;
+    }
+    if (hasRange)
+    {
+        // enough digits that the range of float values survives the round trip
+        const std::streamsize precision = headerStream.precision(std::numeric_limits<float>::max_digits10);
+        headerStream << "DataRange: " << dataRange[0] << " " << dataRange[1] << std::endl;
+        headerStream << "ValueRange: " << valueRange[0] << " " << valueRange[1] << std::endl;
+        headerStream.precision(precision);
+    }
+    for (const std::pair<std::string, std::string> &entry : metaData)
+    {
+        headerStream << entry.first << ": " << entry.second << std::endl;
+    }
+}
+
+DatFile DatFile::read(const std::string & filename)
+{
+    std::ifstream headerStream(filename);
+    if (!headerStream)
+    {
+        throw std::runtime_error("Cannot open \"" + filename + "\" for reading.");
+    }
+    DatFile     datFile;
+    bool        hasResolution = false;
+    bool        hasFormat     = false;
+    bool        hasBasis      = false;
+    std::string line;
+    while (std::getline(headerStream, line))
+    {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos || trimmed(line).empty() || trimmed(line)[0] == '#')
+        {
+            continue;
+        }
+        const std::string key   = trimmed(line.substr(0, colon));
+        const std::string value = trimmed(line.substr(colon + 1));
+        const std::string name  = lower_case(key);
+        if (name == "rawfile")
+        {
+            datFile.rawFile = (!value.empty() && value[0] == '/') ? value : directory_name(filename) + value;
+        }
+        else if (name == "resolution" || name == "dimension")
+        {
+            datFile.resolution = parse_numbers<int, 3>(key, value);
+            hasResolution      = true;
+        }
+        else if (name == "format")
+        {
+            datFile.format = value;
+            hasFormat      = true;
+        }
+        else if (name == "basisvector1" || name == "basisvector2" || name == "basisvector3")
+        {
+            datFile.basis[name.back() - '1'] = parse_numbers<float, 3>(key, value);
+            hasBasis                         = true;
+        }
+        else if (name == "offset")
+        {
+            datFile.offset = parse_numbers<float, 3>(key, value);
+        }
+        else if (name == "datarange")
+        {
+            datFile.dataRange = parse_numbers<double, 2>(key, value);
+            datFile.hasRange  = true;
+        }
+        else if (name == "valuerange")
+        {
+            datFile.valueRange = parse_numbers<double, 2>(key, value);
+        }
+        else if (name == "byteoffset")
+        {
+            datFile.byteOffset = parse_numbers<size_t, 1>(key, value)[0];
+        }
+        else if (name == "byteorder")
+        {
+            datFile.bigEndian = lower_case(value) == "bigendian";
+        }
+        else if (name == "sequences")
+        {
+            datFile.sequences = std::max<size_t>(parse_numbers<size_t, 1>(key, value)[0], 1);
+        }
+        else
+        {
+            datFile.metaData.emplace_back(key, value);
+        }
+    }
+    if (datFile.rawFile.empty() || !hasResolution || !hasFormat)
+    {
+        throw std::runtime_error("\"" + filename + "\" lacks Rawfile, Resolution or Format.");
+    }
+    if (!hasBasis)
+    {
+        // unit voxels
+        for (size_t i = 0; i < 3; ++i)
+        {
+            datFile.basis[i]    = {{ 0, 0, 0 }};
+            datFile.basis[i][i] = float(datFile.resolution[i]);
+        }
+    }
+    return datFile;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Description of an Inviwo .dat volume header.
+ */
+
+#ifndef DATFILE_H_
+#define DATFILE_H_
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*! \brief The key-value header that accompanies an Inviwo raw volume file.
+ */
+struct DatFile
+{
+    DatFile() : resolution(), basis(), offset(), hasRange(false), dataRange(), valueRange(), byteOffset(0), bigEndian(false), sequences(1) {}
+    std::string                          rawFile;    //!< path of the raw voxel file
+    std::array<int, 3>                   resolution; //!< number of voxels along x, y and z
+    std::string                          format;     //!< Inviwo data format name, e.g. FLOAT32
+    std::array<std::array<float, 3>, 3>  basis;      //!< spanning vectors of the volume
+    std::array<float, 3>                 offset;     //!< world position of the volume corner
+    bool                                 hasRange;   //!< write DataRange and ValueRange, so Inviwo need not scan the volume
+    std::array<double, 2>                dataRange;  //!< smallest and largest value in the raw file
+    std::array<double, 2>                valueRange; //!< dataRange in the units of the measured quantity
+    size_t                               byteOffset; //!< number of bytes before the voxel data in the raw file
+    bool                                 bigEndian;  //!< the raw file holds big-endian values
+    size_t                               sequences;  //!< number of volumes of this resolution one after the other in the raw file, played back as a sequence
+    std::vector<std::pair<std::string, std::string> > metaData; //!< further key-value lines, kept by Inviwo as meta data
+
+    /*! \brief Write the header to filename.
+     *
+     * A raw file in the directory of the .dat file is referred to by its name,
+     * which is where Inviwo looks for it; a raw file elsewhere by its absolute path,
+     * e.g. an mrc file whose voxel data the .dat file describes in place.
+     */
+    void write(const std::string & filename) const;
+
+    /*! \brief Read the header from filename.
+     *
+     * Keys are matched in any case. A relative raw file is resolved against the directory
+     * of the .dat file. Keys without a field of their own go to metaData.
+     * \throws std::runtime_error if the file cannot be read or lacks Rawfile, Resolution or Format
+     */
+    static DatFile read(const std::string & filename);
+};
+
+#endif /* end of include guard: DATFILE_H_ */
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "rawfilewriter.h"
+
+#include "util/stagereport.h"
+
+RawFileWriter::RawFileWriter(const std::string & filename) : file_(filename, PosixFile::Mode::Write)
+{
+}
+
+void RawFileWriter::consume(const Slab & slab)
+{
+    ScopedStage stage(Stage::Write, slab.data.size());
+    file_.write(slab.data.data(), slab.data.size());
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Writes streamed slabs to an Inviwo raw file.
+ */
+
+#ifndef RAWFILEWRITER_H_
+#define RAWFILEWRITER_H_
+
+#include <string>
+
+#include "convert/slab.h"
+#include "util/posixfile.h"
+
+/*! \brief Appends the bytes of each consumed slab to a raw file.
+ */
+class RawFileWriter : public SlabSink
+{
+public:
+    explicit RawFileWriter(const std::string & filename);
+    void consume(const Slab & slab) override;
+
+private:
+    PosixFile file_;
+};
+
+#endif /* end of include guard: RAWFILEWRITER_H_ */
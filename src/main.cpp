@@ -16,36 +16,260 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
  *
  */
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
 #include <string>
-#include <fstream>
+#include <vector>
 
+#include "convert/batch.h"
+#include "convert/commandline.h"
+#include "convert/conversioncache.h"
+#include "convert/conversionservice.h"
+#include "convert/converter.h"
+#include "convert/inviwotomrc.h"
+#include "convert/watch.h"
+#include "mrc/mrccatalog.h"
 #include "mrc/mrcfile.h"
-#include "mrc/mrcheader.h"
+#include "util/inputfiles.h"
 
-int main(int argc, const char *argv[]) {
+namespace
+{
 
-	std::string filename(argv[1]);
-	const MrcFileView mrcfile(filename);
+void print_usage(const char * program)
+{
+	fprintf(stderr,
+	        "Usage: %s [options] <file.mrc | directory | 'pattern'>...\n"
+	        "Several files, directories or quoted glob patterns are converted as one batch.\n"
+	        "Usage: %s --catalog <json|csv> [--threads <n>] <file.mrc | directory | 'pattern'>...\n"
+	        "Print the header information of all files as JSON lines or comma separated values, without converting.\n"
+	        "Usage: %s --to-mrc [--mrc-endianness <native|little|big>] [--stats] <file.dat | directory | 'pattern'>...\n"
+	        "Convert Inviwo volumes back to mrc files, file.dat to file.mrc.\n"
+	        "Usage: %s --serve <socket> [--threads <n>] [--pool-mb <n>] [options]\n"
+	        "Convert the files of jobs sent to a Unix domain socket, one line of tab separated options and\n"
+	        "input file per job, answering each job with a line of JSON; the options apply to all jobs.\n"
+	        "Usage: %s --submit <socket> [options] <file.mrc | directory | 'pattern'>...\n"
+	        "Send a job per file to a running service and print the answers.\n"
+	        "Usage: %s --watch <directory> [--cache <manifest>] [--threads <n>] [options]\n"
+	        "Convert the mrc files in a directory and every mrc file written to it, until interrupted;\n"
+	        "files that did not change since they were converted are skipped.\n"
+	        "Options:\n"
+	        "%s"
+	        "  --threads <n>        number of threads converting a batch, reading headers or serving jobs (default all)\n"
+	        "  --pool-mb <n>        megabytes of buffers the service keeps for reuse between jobs (default 1024)\n"
+	        "  --mrc-endianness <native|little|big>\n"
+	        "                       byte order of the mrc files written with --to-mrc (default native)\n",
+	        program, program, program, program, program, program, conversionOptionsUsage());
+}
+
+CatalogFormat parse_catalog_format(const char * option, const char * value)
+{
+	const std::string name(value != nullptr ? value : "");
+	if (name == "json")
+	{
+		return CatalogFormat::JsonLines;
+	}
+	if (name == "csv")
+	{
+		return CatalogFormat::Csv;
+	}
+	throw std::runtime_error(std::string(option) + " expects json or csv.");
+}
+
+MrcFileWriter::Endianness parse_endianness(const char * option, const char * value)
+{
+	const std::string name(value != nullptr ? value : "");
+	if (name == "native")
+	{
+		return MrcFileWriter::Endianness::Native;
+	}
+	if (name == "little")
+	{
+		return MrcFileWriter::Endianness::Little;
+	}
+	if (name == "big")
+	{
+		return MrcFileWriter::Endianness::Big;
+	}
+	throw std::runtime_error(std::string(option) + " expects native, little or big.");
+}
+
+bool has_dat_extension(const std::string & filename)
+{
+	const std::string extension = ".dat";
+	return filename.size() > extension.size() && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+}   // namespace
+
+int main(int argc, const char *argv[]) try {
 
-	std::string rawFileName = filename + ".raw";
-	std::ofstream rawDataStream(rawFileName,  std::ios::out | std::ios::binary);
-    rawDataStream.write(reinterpret_cast<const char*>(mrcfile.data().data()), sizeof(float) * mrcfile.data().size());
-	rawDataStream.close();
-    fprintf(stderr,"Dumped voxel data into \"%s\"\n",rawFileName.c_str());
+	ConversionOptions options;
+	size_t numThreads = 0;
+	bool catalog = false;
+	CatalogFormat catalogFormat = CatalogFormat::JsonLines;
+	bool toMrc = false;
+	MrcFileWriter::Endianness endianness = MrcFileWriter::Endianness::Native;
+	std::string serveSocket;
+	std::string submitSocket;
+	std::string watchDirectoryName;
+	std::string cacheFile;
+	size_t poolMegabytes = 1024;
+	// the conversion options as given, forwarded with the jobs of --submit
+	std::vector<std::string> conversionArguments;
+	std::vector<std::string> inputs;
+	const std::vector<std::string> arguments(argv + 1, argv + argc);
+	for (size_t i = 0; i < arguments.size(); ++i)
+	{
+		const std::string &argument = arguments[i];
+		const char * value = i + 1 < arguments.size() ? arguments[i + 1].c_str() : nullptr;
+		const size_t first = i;
+		if (parseConversionOption(arguments, &i, &options))
+		{
+			conversionArguments.insert(conversionArguments.end(), arguments.begin() + first, arguments.begin() + i + 1);
+		}
+		else if (argument == "--catalog")
+		{
+			catalog = true;
+			catalogFormat = parse_catalog_format(argument.c_str(), value);
+			++i;
+		}
+		else if (argument == "--to-mrc")
+		{
+			toMrc = true;
+		}
+		else if (argument == "--mrc-endianness")
+		{
+			endianness = parse_endianness(argument.c_str(), value);
+			++i;
+		}
+		else if (argument == "--serve" || argument == "--submit")
+		{
+			if (value == nullptr)
+			{
+				throw std::runtime_error(argument + " expects the path of a socket.");
+			}
+			(argument == "--serve" ? serveSocket : submitSocket) = value;
+			++i;
+		}
+		else if (argument == "--watch" || argument == "--cache")
+		{
+			if (value == nullptr)
+			{
+				throw std::runtime_error(argument + (argument == "--watch" ? " expects a directory." : " expects the path of a manifest."));
+			}
+			(argument == "--watch" ? watchDirectoryName : cacheFile) = value;
+			++i;
+		}
+		else if (argument == "--pool-mb")
+		{
+			poolMegabytes = parseCount(argument.c_str(), value, 0);
+			++i;
+		}
+		else if (argument == "--threads")
+		{
+			numThreads = parseCount(argument.c_str(), value);
+			++i;
+		}
+		else if (argument.compare(0, 2, "--") == 0)
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+		else
+		{
+			inputs.push_back(argument);
+		}
+	}
+	if (!serveSocket.empty())
+	{
+		ServiceOptions serviceOptions;
+		serviceOptions.numWorkers = numThreads;
+		serviceOptions.poolBytes = poolMegabytes << 20;
+		serviceOptions.defaults = options;
+		serveConversions(serveSocket, serviceOptions);
+		return 0;
+	}
+	// entries recorded with other conversion options do not count
+	std::string optionsKey;
+	for (const std::string &argument : conversionArguments)
+	{
+		optionsKey += argument + "\t";
+	}
+	if (!watchDirectoryName.empty())
+	{
+		// without a manifest, the cache in memory still skips files that did not change since they were converted
+		ConversionCache cache(cacheFile, optionsKey);
+		watchDirectory(watchDirectoryName, options, numThreads, &cache);
+		return 0;
+	}
+	if (inputs.empty())
+	{
+		print_usage(argv[0]);
+		return 1;
+	}
 
+	if (toMrc)
+	{
+		const std::vector<std::string> datFilenames = findInputFiles(inputs, &has_dat_extension, numThreads);
+		size_t numFailed = 0;
+		for (const std::string & datFilename : datFilenames)
+		{
+			try
+			{
+				convertInviwoToMrc(datFilename, endianness, options.reportStages);
+			}
+			catch (const std::exception & e)
+			{
+				fprintf(stderr,"Error converting %s: %s\n", datFilename.c_str(), e.what());
+				++numFailed;
+			}
+		}
+		fprintf(stderr,"Converted %zu of %zu files\n", datFilenames.size() - numFailed, datFilenames.size());
+		return numFailed > 0 ? 1 : 0;
+	}
 
-	const auto & header = mrcfile.header();
-	std::string headerFileName = filename + ".dat";
-	std::ofstream headerStream(headerFileName,  std::ios::out);
-	headerStream << "Rawfile: "  << rawFileName << std::endl;
-	headerStream << "Resolution: " << header.extend[0] << " " << header.extend[1] << " " << header.extend[2] << std::endl;
-	headerStream << "Format: " << "FLOAT32" << std::endl;
-	headerStream << "BasisVector1: " << header.cell_length[0] << " 0 0" << std::endl;
-	headerStream << "BasisVector2: " << "0 " << header.cell_length[1] << " 0" << std::endl;
-	headerStream << "BasisVector3: " << "0 0 " << header.cell_length[2] << std::endl;
-	headerStream.close();
-	fprintf(stderr,"Converted header to \"%s\"\n",headerFileName.c_str());
+	const std::vector<std::string> filenames = findInputFiles(inputs, &MrcFileView::hasMrcExtension, numThreads);
+	if (!options.outputBase.empty() && filenames.size() > 1)
+	{
+		throw std::runtime_error("--output names the outputs of a single file.");
+	}
+	if (!submitSocket.empty())
+	{
+		return submitConversions(submitSocket, conversionArguments, filenames) > 0 ? 1 : 0;
+	}
+	if (catalog)
+	{
+		printMrcCatalog(filenames, catalogFormat, numThreads);
+		return 0;
+	}
+	if (!cacheFile.empty())
+	{
+		ConversionCache cache(cacheFile, optionsKey);
+		const size_t numFailed = convertCached(filenames, options, numThreads, &cache);
+		fprintf(stderr,"Converted %zu of %zu files\n", filenames.size() - numFailed, filenames.size());
+		if (numFailed > 0)
+		{
+			return 1;
+		}
+	}
+	else if (filenames.size() == 1 && inputs.front() == filenames.front())
+	{
+		convertMrcToInviwo(filenames.front(), options);
+	}
+	else
+	{
+		const size_t numFailed = convertBatch(filenames, options, numThreads);
+		fprintf(stderr,"Converted %zu of %zu files\n", filenames.size() - numFailed, filenames.size());
+		if (numFailed > 0)
+		{
+			return 1;
+		}
+	}
 
 	fprintf(stderr,"Done\n");
 	return 0;
+} catch (const std::exception & e) {
+	fprintf(stderr,"Error: %s\n", e.what());
+	return 1;
 }
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "mrccatalog.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#include "mrc/mrcdecode.h"
+#include "mrc/mrcfile.h"
+#include "mrc/mrcgrid.h"
+#include "util/byteswap.h"
+#include "util/datasource.h"
+#include "util/json.h"
+#include "util/parallel.h"
+
+namespace
+{
+
+//! Headers are read for this many files at a time before their lines are printed.
+constexpr size_t filesPerBlock_c = 4096;
+
+//! Bytes per voxel of a data mode, including the complex modes 3 and 4, zero for unknown modes.
+size_t mode_bytes(int mode)
+{
+    switch (mode)
+    {
+        case 0:  return 1;
+        case 1:  return 2;
+        case 2:  return 4;
+        case 3:  return 4;
+        case 4:  return 8;
+        case 6:  return 2;
+        case 12: return 2;
+        default: return 0;
+    }
+}
+
+std::string type_name(const MrcHeader &header)
+{
+    switch (header.mrc_data_mode)
+    {
+        case 3:  return "complex-int16";
+        case 4:  return "complex-float32";
+        default: return mode_bytes(header.mrc_data_mode) > 0 ? formatName(mrcStoredFormat(header)) : "unknown";
+    }
+}
+
+//! The used labels without trailing blanks.
+std::vector<std::string> used_labels(const MrcHeader &header)
+{
+    std::vector<std::string> labels;
+    const size_t             numLabels = std::min(size_t(std::max(header.num_labels, 0)), header.labels.size());
+    for (size_t i = 0; i < numLabels; ++i)
+    {
+        const std::string &label = header.labels[i];
+        const size_t       end   = label.find_last_not_of(std::string(" \0", 2));
+        labels.push_back(end == std::string::npos ? std::string() : label.substr(0, end + 1));
+    }
+    return labels;
+}
+
+//! A field of comma separated values, quoted if it contains separators, quotes or line breaks.
+std::string csv_field(const std::string & text)
+{
+    if (text.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        quoted += c;
+        if (c == '"')
+        {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+template <typename T>
+std::string json_array(const T &values)
+{
+    std::string text = "[";
+    for (const auto &value : values)
+    {
+        text += (text.size() > 1 ? "," : "") + jsonNumber(value);
+    }
+    return text + "]";
+}
+
+//! The header values of an entry that was read, as pairs of name and JSON value, shared by both formats.
+std::vector<std::pair<std::string, std::string> > header_values(const MrcCatalogEntry &entry)
+{
+    const MrcHeader                   &header = entry.header;
+    const std::array<size_t, 3>        gridSize  = mrcGridSize(header);
+    const std::array<float, 3>         voxelSize = mrcVoxelSize(header);
+    const std::array<int, 3>           axisOrder {{ header.crs_to_xyz[0] + 1, header.crs_to_xyz[1] + 1, header.crs_to_xyz[2] + 1 }};
+    std::vector<std::pair<std::string, std::string> > values {
+        {"mode", jsonNumber(header.mrc_data_mode)},
+        {"type", jsonString(type_name(header))},
+        {"endianness", jsonString(entry.bigEndian ? "big" : "little")},
+        {"num_crs", json_array(header.num_crs)},
+        {"size", json_array(gridSize)},
+        {"axis_order", json_array(axisOrder)},
+        {"voxel_size", json_array(voxelSize)},
+        {"cell_length", json_array(header.cell_length)},
+        {"cell_angles", json_array(header.cell_angles)},
+        {"crs_start", json_array(header.crs_start)},
+        {"min", jsonNumber(header.min_value)},
+        {"max", jsonNumber(header.max_value)},
+        {"mean", jsonNumber(header.mean_value)},
+        {"rms", jsonNumber(header.rms_value)},
+        {"space_group", jsonNumber(header.space_group)},
+        {"extended_header_bytes", jsonNumber(double(entry.dataOffset) - 1024)},
+        {"data_offset", jsonNumber(double(entry.dataOffset))},
+        {"data_bytes", jsonNumber(double(entry.dataBytes))},
+    };
+    return values;
+}
+
+}   // namespace
+
+const char * MrcCatalogEntry::sizeCheck() const
+{
+    if (!error.empty() || dataBytes == 0 || availableBytes == DataSource::unknownSize)
+    {
+        return "unknown";
+    }
+    if (availableBytes < dataOffset + dataBytes)
+    {
+        return "truncated";
+    }
+    return availableBytes > dataOffset + dataBytes ? "trailing" : "ok";
+}
+
+MrcCatalogEntry mrcCatalogEntry(const std::string & filename)
+{
+    MrcCatalogEntry entry;
+    entry.filename       = filename;
+    entry.compressed     = false;
+    entry.fileBytes      = 0;
+    entry.availableBytes = DataSource::unknownSize;
+    entry.dataOffset     = 0;
+    entry.dataBytes      = 0;
+    entry.bigEndian      = false;
+    try
+    {
+        const MrcFileView view(filename, MrcFileView::DataAccess::HeaderOnly);
+        entry.header         = view.header();
+        entry.compressed     = view.source().isSequential();
+        entry.availableBytes = view.source().size();
+        entry.dataOffset     = view.dataOffset();
+        entry.bigEndian      = hostIsBigEndian() != entry.header.swap_bytes;
+        const std::array<size_t, 3> numCrs = mrcNumCrs(entry.header);
+        if (std::all_of(entry.header.num_crs.begin(), entry.header.num_crs.end(), [](int n) { return n > 0; }))
+        {
+            entry.dataBytes = numCrs[0] * numCrs[1] * numCrs[2] * mode_bytes(entry.header.mrc_data_mode);
+        }
+        if (entry.compressed)
+        {
+            struct stat status;
+            entry.fileBytes = stat(filename.c_str(), &status) == 0 ? status.st_size : 0;
+        }
+        else
+        {
+            entry.fileBytes = entry.availableBytes;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        entry.error = e.what();
+    }
+    return entry;
+}
+
+std::string catalogJson(const MrcCatalogEntry &entry)
+{
+    std::ostringstream line;
+    line << "{\"file\":" << jsonString(entry.filename);
+    if (!entry.error.empty())
+    {
+        line << ",\"error\":" << jsonString(entry.error) << "}";
+        return line.str();
+    }
+    line << ",\"compressed\":" << (entry.compressed ? "true" : "false") << ",\"file_bytes\":" << entry.fileBytes
+         << ",\"size_check\":\"" << entry.sizeCheck() << "\"";
+    for (const std::pair<std::string, std::string> &value : header_values(entry))
+    {
+        line << ",\"" << value.first << "\":" << value.second;
+    }
+    line << ",\"labels\":[";
+    const std::vector<std::string> labels = used_labels(entry.header);
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        line << (i > 0 ? "," : "") << jsonString(labels[i]);
+    }
+    line << "]}";
+    return line.str();
+}
+
+std::string catalogCsvHeader()
+{
+    return "file,error,compressed,file_bytes,size_check,mode,type,endianness,nc,nr,ns,nx,ny,nz,mapc,mapr,maps,"
+           "voxel_x,voxel_y,voxel_z,cell_a,cell_b,cell_c,alpha,beta,gamma,nc_start,nr_start,ns_start,"
+           "min,max,mean,rms,space_group,extended_header_bytes,data_offset,data_bytes,labels";
+}
+
+std::string catalogCsv(const MrcCatalogEntry &entry)
+{
+    std::ostringstream line;
+    line << csv_field(entry.filename) << "," << csv_field(entry.error);
+    if (!entry.error.empty())
+    {
+        // keep the number of columns
+        line << std::string(36, ',');
+        return line.str();
+    }
+    line << "," << (entry.compressed ? "true" : "false") << "," << entry.fileBytes << "," << entry.sizeCheck();
+    for (const std::pair<std::string, std::string> &value : header_values(entry))
+    {
+        std::string field = value.second;
+        if (field.front() == '"')
+        {
+            // names hold no characters that JSON escapes
+            field = field.substr(1, field.size() - 2);
+        }
+        else if (field.front() == '[')
+        {
+            // vectors take one column per component
+            field = field.substr(1, field.size() - 2);
+        }
+        // values that are not finite stay empty
+        for (size_t null = field.find("null"); null != std::string::npos; null = field.find("null"))
+        {
+            field.erase(null, 4);
+        }
+        line << "," << field;
+    }
+    const std::vector<std::string> labels = used_labels(entry.header);
+    std::string                    joined;
+    for (const std::string &label : labels)
+    {
+        joined += (joined.empty() ? "" : " | ") + label;
+    }
+    line << "," << csv_field(joined);
+    return line.str();
+}
+
+void printMrcCatalog(const std::vector<std::string> &filenames, CatalogFormat format, size_t numThreads)
+{
+    if (format == CatalogFormat::Csv)
+    {
+        printf("%s\n", catalogCsvHeader().c_str());
+    }
+    std::vector<MrcCatalogEntry> entries;
+    for (size_t first = 0; first < filenames.size(); first += filesPerBlock_c)
+    {
+        entries.resize(std::min(filesPerBlock_c, filenames.size() - first));
+        parallelFor(entries.size(), [&filenames, &entries, first](size_t i) {
+                entries[i] = mrcCatalogEntry(filenames[first + i]);
+            }, numThreads);
+        for (const MrcCatalogEntry &entry : entries)
+        {
+            printf("%s\n", (format == CatalogFormat::Csv ? catalogCsv(entry) : catalogJson(entry)).c_str());
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Catalogs of the headers of many mrc files.
+ */
+
+#ifndef MRCCATALOG_H_
+#define MRCCATALOG_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "mrc/mrcheader.h"
+
+//! What the header of an mrc file tells about its volume, for deciding what to convert.
+struct MrcCatalogEntry
+{
+    std::string filename;
+    std::string error;           //!< why the header could not be read, empty if it was read
+    bool        compressed;      //!< the file is compressed with gzip, bzip2 or zstd
+    size_t      fileBytes;       //!< size of the file on disk
+    size_t      availableBytes;  //!< size of the decompressed file, DataSource::unknownSize if unknown before decompressing
+    MrcHeader   header;          //!< the main header, without extended header
+    size_t      dataOffset;      //!< byte offset of the voxel data
+    size_t      dataBytes;       //!< bytes of voxel data the header describes, zero for unknown modes
+    bool        bigEndian;       //!< the file stores big-endian values
+
+    /*! \brief How the file size compares to the size the header describes.
+     *
+     * "ok" if they agree, "truncated" if the file is shorter, "trailing" if it is longer,
+     * "unknown" if the mode or the decompressed size is unknown.
+     */
+    const char * sizeCheck() const;
+};
+
+/*! \brief Read the catalog entry of a file from its main header.
+ *
+ * Reads only the 1024 byte main header, see MrcFileView::DataAccess::HeaderOnly.
+ * Failures are recorded in the entry instead of thrown.
+ */
+MrcCatalogEntry mrcCatalogEntry(const std::string & filename);
+
+//! Output formats of a catalog.
+enum class CatalogFormat
+{
+    JsonLines, //!< one JSON object per file
+    Csv        //!< a header line, then one line of comma separated values per file
+};
+
+/*! \brief Print the catalog of the files to stdout.
+ *
+ * Reads the headers on numThreads threads, a block of files at a time, so scanning
+ * many files is bound by the metadata requests and memory does not grow with their number.
+ * Files are listed in the given order.
+ * \param[in] numThreads number of threads reading headers, zero for all hardware threads
+ */
+void printMrcCatalog(const std::vector<std::string> &filenames, CatalogFormat format, size_t numThreads);
+
+//! The entry as a single line of JSON.
+std::string catalogJson(const MrcCatalogEntry &entry);
+
+//! The names of the columns of catalogCsv().
+std::string catalogCsvHeader();
+
+//! The entry as a line of comma separated values.
+std::string catalogCsv(const MrcCatalogEntry &entry);
+
+#endif /* end of include guard: MRCCATALOG_H_ */
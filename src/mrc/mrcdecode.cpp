@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Implements decoding kernels for the scalar mrc data modes.
+ */
+#include "mrcdecode.h"
+#include "mrcheader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "util/byteswap.h"
+
+namespace
+{
+
+//! IMOD marks its files with this value in header word 39.
+constexpr int32_t imodStamp_c = 1146047817;
+
+//! Converts a stored value of type Stored to float.
+template <typename Stored>
+struct Widen
+{
+    static float apply(Stored value) { return static_cast<float>(value); }
+};
+
+//! Half precision values are stored as their 16 bit pattern.
+struct Half
+{
+    uint16_t bits;
+};
+
+template <>
+struct Widen<Half>
+{
+    static float apply(Half value) { return halfToFloat(value.bits); }
+};
+
+template <typename Stored>
+void widen_kernel(const void * stored, float * result, size_t count, bool swap)
+{
+    const unsigned char * source = static_cast<const unsigned char *>(stored);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Stored value;
+        std::memcpy(&value, source + i * sizeof(Stored), sizeof(Stored));
+        if (sizeof(Stored) > 1 && swap)
+        {
+            value = swapBytes(value);
+        }
+        result[i] = Widen<Stored>::apply(value);
+    }
+}
+
+int32_t extra_word_as_int(const MrcHeader &header, size_t index)
+{
+    int32_t value;
+    std::memcpy(&value, &header.extra[index], sizeof(value));
+    return value;
+}
+
+void set_extra_word(MrcHeader * header, size_t index, int32_t value)
+{
+    std::memcpy(&header->extra[index], &value, sizeof(value));
+}
+
+}   // namespace
+
+DataFormat mrcStoredFormat(const MrcHeader &header)
+{
+    switch (static_cast<MrcHeader::MrcDataMode>(header.mrc_data_mode))
+    {
+        case MrcHeader::MrcDataMode::int8:
+        {
+            // extra[1] and extra[2] are header words 39 and 40, IMOD stamp and flags
+            const bool imodUnsigned = extra_word_as_int(header, 1) == imodStamp_c
+                && (extra_word_as_int(header, 2) & 1) == 0;
+            return imodUnsigned ? DataFormat::UINT8 : DataFormat::INT8;
+        }
+        case MrcHeader::MrcDataMode::int16:   return DataFormat::INT16;
+        case MrcHeader::MrcDataMode::float32: return DataFormat::FLOAT32;
+        case MrcHeader::MrcDataMode::uInt16:  return DataFormat::UINT16;
+        case MrcHeader::MrcDataMode::float16: return DataFormat::FLOAT16;
+        default:
+            throw std::runtime_error("Unsupported mrc data mode " + std::to_string(header.mrc_data_mode) + ".");
+    }
+}
+
+bool mrcIsComplex(const MrcHeader &header)
+{
+    return header.mrc_data_mode == int(MrcHeader::MrcDataMode::complexInt32)
+           || header.mrc_data_mode == int(MrcHeader::MrcDataMode::complexFloat64);
+}
+
+void mrcSetStoredFormat(MrcHeader * header, DataFormat format)
+{
+    switch (format)
+    {
+        case DataFormat::INT8:
+            header->mrc_data_mode = int(MrcHeader::MrcDataMode::int8);
+            if (extra_word_as_int(*header, 1) == imodStamp_c)
+            {
+                set_extra_word(header, 2, extra_word_as_int(*header, 2) | 1);
+            }
+            break;
+        case DataFormat::UINT8:
+            header->mrc_data_mode = int(MrcHeader::MrcDataMode::int8);
+            set_extra_word(header, 1, imodStamp_c);
+            set_extra_word(header, 2, extra_word_as_int(*header, 2) & ~1);
+            break;
+        case DataFormat::INT16:   header->mrc_data_mode = int(MrcHeader::MrcDataMode::int16); break;
+        case DataFormat::UINT16:  header->mrc_data_mode = int(MrcHeader::MrcDataMode::uInt16); break;
+        case DataFormat::FLOAT16: header->mrc_data_mode = int(MrcHeader::MrcDataMode::float16); break;
+        case DataFormat::FLOAT32: header->mrc_data_mode = int(MrcHeader::MrcDataMode::float32); break;
+    }
+}
+
+void decodeVoxels(void * data, size_t count, DataFormat format, bool swap)
+{
+    if (swap)
+    {
+        swapBytes(data, count, formatBytes(format));
+    }
+}
+
+void widenVoxels(const void * stored, float * result, size_t count, DataFormat format, bool swap)
+{
+    switch (format)
+    {
+        case DataFormat::INT8:    widen_kernel<int8_t>(stored, result, count, swap); break;
+        case DataFormat::UINT8:   widen_kernel<uint8_t>(stored, result, count, swap); break;
+        case DataFormat::INT16:   widen_kernel<int16_t>(stored, result, count, swap); break;
+        case DataFormat::UINT16:  widen_kernel<uint16_t>(stored, result, count, swap); break;
+        case DataFormat::FLOAT16: widen_kernel<Half>(stored, result, count, swap); break;
+        case DataFormat::FLOAT32: widen_kernel<float>(stored, result, count, swap); break;
+    }
+}
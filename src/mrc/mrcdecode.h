@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Decoding of mrc voxel data into native types.
+ */
+
+#ifndef MRCDECODE_H_
+#define MRCDECODE_H_
+
+#include <cstddef>
+
+#include "util/dataformat.h"
+
+struct MrcHeader;
+
+/*! \brief The type of the voxel values as stored in the file.
+ *
+ * Mode 0 bytes are signed as defined by MRC2014, unless the IMOD stamp
+ * in the extra header words marks them as unsigned.
+ * \throws std::runtime_error for modes that hold no scalar real data, including the complex modes, see mrcIsComplex()
+ */
+DataFormat mrcStoredFormat(const MrcHeader &header);
+
+//! True if the file stores the complex values of a Fourier transform, data modes 3 and 4.
+bool mrcIsComplex(const MrcHeader &header);
+
+/*! \brief Set the data mode that stores values of the given format, the inverse of mrcStoredFormat().
+ *
+ * Unsigned bytes are mode 0 with the IMOD stamp and flags that mark them unsigned;
+ * signed bytes set the IMOD flag for signed bytes if the header carries the IMOD stamp.
+ */
+void mrcSetStoredFormat(MrcHeader * header, DataFormat format);
+
+/*! \brief Convert count stored values to native endianess in place.
+ *
+ * The values keep their type, so decoding is a no-op unless swapBytes is set.
+ */
+void decodeVoxels(void * data, size_t count, DataFormat format, bool swapBytes);
+
+/*! \brief Convert count stored values to float.
+ *
+ * Integers keep their value, half precision floats are converted exactly.
+ * \param[in] stored the values as read from the file
+ * \param[out] result count floats
+ */
+void widenVoxels(const void * stored, float * result, size_t count, DataFormat format, bool swapBytes);
+
+#endif /* end of include guard: MRCDECODE_H_ */
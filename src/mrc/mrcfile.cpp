@@ -21,17 +21,40 @@
  * \author Christian Blau <cblau@gwdg.de>
  */
 #include "mrcfile.h"
+#include "mrcdecode.h"
 #include "mrcheader.h"
 
-#include <cstdio>
+#include "util/byteswap.h"
+#include "util/datasource.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+#include <cctype>
+#include <cstring>
 
 #include <algorithm>
-#include <complex>
+#include <array>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <set>
 #include <type_traits>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+
+//! File extensions of the formats that can be read.
+const std::vector<std::string> &mrc_file_types()
+{
+    static const std::vector<std::string> fileTypes {"mrc", "ccp4", "imod", "map"};
+    return fileTypes;
+}
+
+}   // namespace
+
 /*******************************************************************************
  * MrcFileView::Impl
  */
@@ -46,6 +69,19 @@ class MrcFileView::Impl
         void read_mrc_data_();
         void read_mrc_header_();
 
+        /*! \brief Map the file and view the voxel data in place.
+         *
+         * Only possible if the data is native-endian, needs no widening and is properly aligned.
+         * \returns true if the data is viewed in the mapped file */
+        bool map_mrc_data_();
+
+        //! Number of voxels stored in the file, columns * rows * sections.
+        size_t num_voxels_() const;
+        //! Byte offset of the voxel data, after main and extended header.
+        size_t data_offset_() const;
+        //! Format of the voxel data in memory.
+        DataFormat format_() const;
+
         /*! \brief Guess, whether endianess differs between input file and reading architecture .
          *
          * If the number of columns in the density file is negative or larger than 65534,
@@ -54,35 +90,16 @@ class MrcFileView::Impl
 
         bool has_skew_matrix();
 
+        //! Read the next value of the header.
         template <typename T> void read(T * result)
         {
-            fread(result, sizeof(T), 1, file_);
+            std::memcpy(result, headerBytes_.data() + headerPosition_, sizeof(T));
+            headerPosition_ += sizeof(T);
             // swap bytes for correct endianness
             if (header_.swap_bytes)
             {
-                // byte swap for real numbers
-                if (std::is_same<T, double>())
-                {
-                    int64_t int_tmp = int64_t(*result);
-                    *result = (int_tmp & 0xFF00000000000000) >> 7*8 | (int_tmp & 0x00FF000000000000) >> 5*8 |
-                        (int_tmp & 0x0000FF0000000000) >> 3*8 | (int_tmp & 0x000000FF00000000) >> 1*8 |
-                        (int_tmp & 0x00000000FF000000) << 1*8 | (int_tmp & 0x0000000000FF0000) << 3*8 |
-                        (int_tmp & 0x000000000000FF00) << 5*8 | (int_tmp & 0x00000000000000FF) << 7*8;
-                }
-
-                // byte swap for real numbers
-                if (std::is_same<T, float>())
-                {
-                    int32_t int_tmp = int32_t(*result);
-                    *result = (int_tmp & 0xFF000000) >> 24 | (int_tmp & 0x00FF0000) >> 8 | (int_tmp & 0x0000FF00) << 8 | (int_tmp & 0x000000FF) << 24;
-                }
-                if (std::is_same<T, int16_t>())
-                {
-                    int16_t int_tmp = int16_t(*result);
-                    *result = (int_tmp & 0xFF00) >> 8 | (int_tmp & 0x00FF) << 8;
-                }
+                *result = swapBytes(*result);
             }
-
         }
 
         void read_float32_rvec_(std::array<float,3> * result);
@@ -90,11 +107,17 @@ class MrcFileView::Impl
 
         bool colummn_row_section_order_valid_(std::array<int, 3> crs_to_xyz);
 
-        FILE                          *file_;
+        std::unique_ptr<DataSource>    source_;
         size_t                         file_size_;
+        std::vector<char>              headerBytes_;         //!< the main header, read with a single positioned read
+        size_t                         headerPosition_;      //!< position of the next header value to read
+        bool                           readExtendedHeader_;  //!< read the extended header into the header, not only skip it
+        size_t                         extendedHeaderBytes_; //!< size of the extended header, limited to the file size
         constexpr static size_t        numLabels_c   = 10;
         constexpr static size_t        labelSize_c   = 80;
         constexpr static size_t        headerBytes_c = 1024;
+        //! Voxel data is read and byte-swapped in blocks of this size, so each block is swapped while still in cache
+        constexpr static size_t        readBlockBytes_c = 1 << 20;
         constexpr static size_t XX = 0;
         constexpr static size_t YY = 1;
         constexpr static size_t ZZ = 2;
@@ -102,8 +125,12 @@ class MrcFileView::Impl
 
         const std::vector<std::string> filetypes;
 
-        MrcHeader           header_;
-        std::vector<float>  data_;
+        MrcHeader             header_;
+        bool                  widen_;
+        std::vector<char>     data_;
+        void                 *mapped_;
+        size_t                mapped_size_;
+        ArrayRef<const char>  view_;
 
 };
 
@@ -137,6 +164,13 @@ bool MrcFileView::Impl::colummn_row_section_order_valid_(std::array<int, 3> crs_
 
 void MrcFileView::Impl::read_mrc_header_()
 {
+        // plain files already hold the header in headerBytes_ after opening
+        if (headerBytes_.size() != headerBytes_c)
+        {
+            headerBytes_.resize(headerBytes_c);
+            source_->readAt(headerBytes_.data(), headerBytes_.size(), 0);
+        }
+        headerPosition_ = 0;
         check_swap_bytes();
         read_file_size();
 
@@ -240,8 +274,7 @@ void MrcFileView::Impl::read_mrc_header_()
     /* 24 | NSYMBT | signed int | 80n
      * # of bytes in symmetry table (multiple of 80)
      * emdb convention 0 */
-    int numBytesExtendedHeader;
-    read(&numBytesExtendedHeader);
+    read(&header_.num_bytes_extened_header);
 
     if (header_.is_crystallographic)
     {
@@ -325,67 +358,134 @@ void MrcFileView::Impl::read_mrc_header_()
 
         for (auto &label : header_.labels)
         {
-            std::array<char, labelSize_c>  labelToRead;
-            fread(labelToRead.data(), 1, labelSize_c, file_);
-            label = std::string(labelToRead.data(), labelSize_c);
+            label = std::string(headerBytes_.data() + headerPosition_, labelSize_c);
+            headerPosition_ += labelSize_c;
         }
 
     /* 257-257+NSYMBT | anything
      */
-    header_.extended_header.resize(numBytesExtendedHeader);
+    const size_t maxExtendedHeaderBytes = file_size_ > headerBytes_c ? file_size_ - headerBytes_c : 0;
+    extendedHeaderBytes_ = std::min(size_t(std::max(header_.num_bytes_extened_header, 0)), maxExtendedHeaderBytes);
+    if (readExtendedHeader_)
+    {
+        header_.extended_header.resize(extendedHeaderBytes_);
+        source_->readAt(header_.extended_header.data(), header_.extended_header.size(), headerBytes_c);
+    }
 
 };
 
+size_t MrcFileView::Impl::num_voxels_() const
+{
+    return size_t(header_.num_crs[XX]) * size_t(header_.num_crs[YY]) * size_t(header_.num_crs[ZZ]);
+}
+
+size_t MrcFileView::Impl::data_offset_() const
+{
+    return headerBytes_c + extendedHeaderBytes_;
+}
+
+DataFormat MrcFileView::Impl::format_() const
+{
+    return widen_ ? DataFormat::FLOAT32 : mrcStoredFormat(header_);
+}
+
+bool MrcFileView::Impl::map_mrc_data_()
+{
+    const DataFormat stored    = mrcStoredFormat(header_);
+    const size_t     dataBytes = num_voxels_() * formatBytes(stored);
+    // decompressed data has no file to map
+    const PosixFile *file      = dynamic_cast<const PosixFile *>(source_.get());
+    if (file == nullptr
+        || header_.swap_bytes
+        || stored != format_()
+        || data_offset_() % formatBytes(stored) != 0
+        || file_size_ < data_offset_() + dataBytes
+        || dataBytes == 0)
+    {
+        return false;
+    }
+
+    // pages are read when first touched, so later stages include most of the reading time of mapped files
+    ScopedStage stage(Stage::Read);
+    // mmap offsets must be page aligned, so map from the start of the file
+    void * mapped = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, file->descriptor(), 0);
+    countSystemCalls();
+    if (mapped == MAP_FAILED)
+    {
+        return false;
+    }
+    madvise(mapped, file_size_, MADV_SEQUENTIAL);
+    countSystemCalls();
+    stage.addBytes(dataBytes);
+    mapped_      = mapped;
+    mapped_size_ = file_size_;
+
+    view_ = ArrayRef<const char>(static_cast<const char *>(mapped_) + data_offset_(), dataBytes);
+    return true;
+}
+
 void MrcFileView::Impl::read_mrc_data_()
 {
-    data_.resize(header_.extend[XX] * header_.extend[YY] * header_.extend[ZZ]);
+    const DataFormat stored      = mrcStoredFormat(header_);
+    const DataFormat format      = format_();
+    const size_t     storedBytes = formatBytes(stored);
+    const size_t     numVoxels   = num_voxels_();
+    data_.resize(numVoxels * formatBytes(format));
+
+    // widening reads each block into a scratch buffer, otherwise decoding works in place
+    std::vector<char> block(stored != format ? readBlockBytes_c : 0);
 
-    for (float & d : data_)
+    const size_t valuesPerBlock = readBlockBytes_c / storedBytes;
+    for (size_t first = 0; first < numVoxels; first += valuesPerBlock)
     {
-        read(&d);
+        const size_t count  = std::min(valuesPerBlock, numVoxels - first);
+        char *       target = data_.data() + first * formatBytes(format);
+        char *       source = block.empty() ? target : block.data();
+        {
+            ScopedStage stage(Stage::Read, count * storedBytes);
+            source_->readAt(source, count * storedBytes, data_offset_() + first * storedBytes);
+        }
+        ScopedStage stage(Stage::Decode, count * formatBytes(format));
+        if (block.empty())
+        {
+            decodeVoxels(target, count, stored, header_.swap_bytes);
+        }
+        else
+        {
+            widenVoxels(source, reinterpret_cast<float *>(target), count, stored, header_.swap_bytes);
+        }
     }
+    view_ = data_;
 }
 
 void MrcFileView::Impl::read_file_size()
 {
-    fpos_t current;
-    fgetpos(file_, &current);
-    fseek(file_, 0, SEEK_END);
-    file_size_ = ftell(file_);
-    fsetpos(file_, &current);
+    file_size_ = source_->size();
 }
 
 void MrcFileView::Impl::check_swap_bytes()
 {
-
-    fpos_t      current;
     header_.swap_bytes = false;
     int32_t number_columns;
-    fgetpos(file_, &current);
-
-    fseek(file_, 0, SEEK_SET);
-    read(&number_columns);
+    std::memcpy(&number_columns, headerBytes_.data(), sizeof(number_columns));
     if (number_columns <= 0 || number_columns >= 65536)
     {
         header_.swap_bytes = true;
     }
-
-    // rewind the file
-    fsetpos(file_, &current);
-
 }
 
-MrcFileView::Impl::Impl() : file_(nullptr), file_size_(0), filetypes({"mrc", "ccp4", "imod", "map"}
-                                                                 )
+MrcFileView::Impl::Impl() : file_size_(0), headerPosition_(0), readExtendedHeader_(true), extendedHeaderBytes_(0), filetypes(mrc_file_types()),
+    widen_(false), mapped_(nullptr), mapped_size_(0)
 {
     header_.setEMDBDefaults();
 };
 
 MrcFileView::Impl::~Impl()
 {
-    if (file_ != nullptr)
+    if (mapped_ != nullptr)
     {
-        fclose(file_);
+        munmap(mapped_, mapped_size_);
+        countSystemCalls();
     }
 };
 
@@ -395,12 +495,29 @@ MrcFileView::Impl::~Impl()
  * MrcFileView
  */
 
-MrcFileView::MrcFileView(const std::string & filename):
+MrcFileView::MrcFileView(const std::string & filename, DataAccess access, Conversion conversion):
 impl_(new MrcFileView::Impl)
 {
-    impl_->file_ = fopen(filename.c_str(), "r");
-    impl_->read_mrc_header_();
-    impl_->read_mrc_data_();
+    impl_->widen_              = (conversion == Conversion::WidenToFloat);
+    impl_->readExtendedHeader_ = (access != DataAccess::HeaderOnly);
+    {
+        ScopedStage stage(Stage::Open);
+        impl_->headerBytes_.resize(Impl::headerBytes_c);
+        impl_->source_ = openDataSource(filename, &impl_->headerBytes_);
+    }
+    {
+        ScopedStage stage(Stage::Header);
+        impl_->read_mrc_header_();
+        stage.addBytes(Impl::headerBytes_c + impl_->header_.extended_header.size());
+    }
+    if (access == DataAccess::HeaderOnly || access == DataAccess::HeaderAndExtendedHeader)
+    {
+        return;
+    }
+    if (access == DataAccess::Decode || !impl_->map_mrc_data_())
+    {
+        impl_->read_mrc_data_();
+    }
 }
 
 MrcFileView::~MrcFileView()
@@ -412,7 +529,55 @@ const MrcHeader & MrcFileView::header() const
     return impl_->header_;
 }
 
-const std::vector<float> & MrcFileView::data() const
+DataFormat MrcFileView::format() const
+{
+    return impl_->format_();
+}
+
+ArrayRef<const char> MrcFileView::bytes() const
+{
+    return impl_->view_;
+}
+
+ArrayRef<const float> MrcFileView::data() const
+{
+    if (impl_->view_.empty())
+    {
+        return ArrayRef<const float>();
+    }
+    if (format() != DataFormat::FLOAT32)
+    {
+        throw std::logic_error("Voxel data is not float, use bytes() or widen on construction.");
+    }
+    const float * begin = reinterpret_cast<const float *>(impl_->view_.data());
+    return ArrayRef<const float>(begin, impl_->view_.size() / sizeof(float));
+}
+
+bool MrcFileView::isMapped() const
 {
-    return impl_->data_;
+    return impl_->mapped_ != nullptr;
+}
+
+size_t MrcFileView::dataOffset() const
+{
+    return impl_->data_offset_();
+}
+
+const DataSource & MrcFileView::source() const
+{
+    return *impl_->source_;
+}
+
+bool MrcFileView::hasMrcExtension(const std::string & filename)
+{
+    const std::string uncompressed = stripCompressionExtension(filename);
+    const size_t      dot          = uncompressed.find_last_of('.');
+    if (dot == std::string::npos)
+    {
+        return false;
+    }
+    std::string extension = uncompressed.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    const std::vector<std::string> &fileTypes = mrc_file_types();
+    return std::find(fileTypes.begin(), fileTypes.end(), extension) != fileTypes.end();
 }
@@ -26,28 +26,78 @@
 #define MRCFILE_H_
 
 #include <memory>
-#include <vector>
+#include <string>
+
+#include "util/arrayref.h"
+#include "util/dataformat.h"
+
 struct MrcHeader;
+class DataSource;
 
  /*! \brief View an Mrc File.
  *
- * Read float valued volume data files
+ * Read scalar real valued volume data files
  * according to the electron microscopy data bank (EMDB) standard.
  *
  * The formatting guraranties compliance with 3D EM maps described in
  * "EMDB Map Distribution Format Description Version 1.01 (c) emdatabank.org 2014"
  *
  * However, other ccp4, mrc, imod and map formats might be compatible.
+ *
+ * Voxel values keep the type they are stored with (modes 0, 1, 2, 6 and 12),
+ * unless widening to float is requested.
+ *
+ * Opening a plain file reads the main header with the same positioned read that recognizes
+ * compression, so a header-only view costs a single read of 1024 bytes.
+ *
+ * Native-endian data that needs no widening is memory-mapped and viewed in place,
+ * so no voxel data is copied to the heap. Only files that need byte swapping or
+ * widening are decoded into memory owned by the view.
+ *
+ * Files compressed with gzip, bzip2 or zstd, e.g. emd_1234.map.gz as distributed by EMDB,
+ * are decompressed on the fly, see openDataSource(); their data is always decoded.
+ *
  * \param[in] filename name of the file from which to read the griddata, typically *.cpp4, *.mrc or *.map
- * \returns MrcFileView into float-valued, real-space data on a grid.
+ * \returns MrcFileView into real-space data on a grid.
  */
 class MrcFileView
 {
 public:
-    explicit MrcFileView(const std::string & filename);
+    //! How to access the voxel data.
+    enum class DataAccess
+    {
+        MapIfPossible,          //!< view the mapped file where no conversion is needed, decode otherwise
+        Decode,                 //!< always decode the data into owned memory
+        HeaderOnly,             //!< read only the 1024 byte main header, data() and the extended header stay empty
+        HeaderAndExtendedHeader //!< read the main and the extended header, data() stays empty
+    };
+    //! Type of the voxel values in memory.
+    enum class Conversion
+    {
+        Native,       //!< keep the type stored in the file
+        WidenToFloat  //!< convert all values to float
+    };
+    explicit MrcFileView(const std::string & filename, DataAccess access = DataAccess::MapIfPossible,
+                         Conversion conversion = Conversion::Native);
     ~MrcFileView();
     const MrcHeader & header() const;
-    const std::vector<float> & data() const;
+    //! Type of the voxel values in memory; throws for unsupported data modes.
+    DataFormat format() const;
+    //! Read-only view of the voxel bytes in column, row, section order.
+    ArrayRef<const char> bytes() const;
+    //! Read-only view of float voxel data; throws std::logic_error unless format() is FLOAT32.
+    ArrayRef<const float> data() const;
+    //! True if data() points directly into the memory-mapped file.
+    bool isMapped() const;
+    //! Byte offset of the voxel data in the decompressed file, after main and extended header.
+    size_t dataOffset() const;
+    /*! \brief The file the view reads from, e.g. to stream the voxel data after the header.
+     *
+     * Reads from compressed files must not start before dataOffset() once the header is read.
+     */
+    const DataSource & source() const;
+    //! True if filename ends in one of the extensions of the readable formats, e.g. .mrc, .map or .map.gz.
+    static bool hasMrcExtension(const std::string & filename);
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "mrcfilewriter.h"
+#include "mrcdecode.h"
+#include "mrcheader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "util/byteswap.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+#include "util/valuestatistics.h"
+
+namespace
+{
+
+constexpr size_t headerBytes_c = 1024;
+constexpr size_t labelSize_c   = 80;
+//! Values that need swapping are swapped and written in blocks of this size, so each block is written while still in cache.
+constexpr size_t swapBlockBytes_c = 4 << 20;
+
+//! Writes header words at their position, the counterpart of MrcFileView::Impl::read().
+class HeaderWords
+{
+    public:
+        HeaderWords(std::vector<char> * bytes, bool swap) : bytes_(bytes), swap_(swap) {}
+
+        //! Write value to header word number word, counting from one as the format description does.
+        template <typename T> void put(size_t word, T value)
+        {
+            static_assert(sizeof(T) == 4, "Header words are 4 bytes.");
+            if (swap_)
+            {
+                value = swapBytes(value);
+            }
+            std::memcpy(bytes_->data() + 4 * (word - 1), &value, sizeof(value));
+        }
+        template <typename T, size_t N> void put(size_t firstWord, const std::array<T, N> &values)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                put(firstWord + i, values[i]);
+            }
+        }
+        //! Write text padded with blanks to size bytes, starting at header word word.
+        void put_text(size_t word, const std::string &text, size_t size)
+        {
+            char * target = bytes_->data() + 4 * (word - 1);
+            std::memset(target, ' ', size);
+            std::memcpy(target, text.data(), std::min(text.size(), size));
+        }
+
+    private:
+        std::vector<char> * bytes_;
+        bool                swap_;
+};
+
+}   // namespace
+
+std::vector<char> mrcHeaderBytes(const MrcHeader &header, bool swapBytes)
+{
+    std::vector<char> bytes(headerBytes_c, 0);
+    HeaderWords       words(&bytes, swapBytes);
+    words.put(1, header.num_crs);
+    words.put(4, int32_t(header.mrc_data_mode));
+    words.put(5, header.crs_start);
+    words.put(8, header.extend);
+    words.put(11, header.cell_length);
+    words.put(14, header.cell_angles);
+    words.put(17, std::array<int32_t, 3> {{ header.crs_to_xyz[0] + 1, header.crs_to_xyz[1] + 1, header.crs_to_xyz[2] + 1 }});
+    words.put(20, header.min_value);
+    words.put(21, header.max_value);
+    words.put(22, header.mean_value);
+    words.put(23, int32_t(header.space_group));
+    words.put(24, int32_t(header.num_bytes_extened_header));
+    if (header.is_crystallographic)
+    {
+        words.put(25, int32_t(header.has_skew_matrix ? 1 : 0));
+        if (header.has_skew_matrix)
+        {
+            words.put(26, header.skew_matrix);
+            words.put(35, header.skew_translation);
+        }
+    }
+    else
+    {
+        words.put(25, header.extraskew);
+    }
+    words.put(38, header.extra);
+    words.put_text(53, header.format_identifier, 4);
+    words.put(54, int32_t(header.machine_stamp));
+    words.put(55, header.rms_value);
+    words.put(56, int32_t(header.num_labels));
+    for (size_t i = 0; i < header.labels.size(); ++i)
+    {
+        words.put_text(57 + i * labelSize_c / 4, header.labels[i], labelSize_c);
+    }
+    return bytes;
+}
+
+/*******************************************************************************
+ * MrcFileWriter::Impl
+ */
+class MrcFileWriter::Impl
+{
+    public:
+        Impl(const std::string & filename, const MrcHeader &header, DataFormat format, Endianness endianness);
+
+        //! Position of the next value in the file.
+        size_t write_offset_() const;
+
+        PosixFile         file_;
+        MrcHeader         header_;
+        DataFormat        format_;
+        bool              swap_;
+        size_t            numValues_;  //!< number of values the grid holds
+        size_t            numWritten_; //!< number of values written so far
+        ValueStatistics   statistics_;
+        std::vector<char> swapped_;    //!< block of values with swapped bytes
+};
+
+MrcFileWriter::Impl::Impl(const std::string & filename, const MrcHeader &header, DataFormat format, Endianness endianness) :
+    file_(filename, PosixFile::Mode::Write),
+    header_(header),
+    format_(format),
+    swap_((endianness == Endianness::Big && !hostIsBigEndian()) || (endianness == Endianness::Little && hostIsBigEndian())),
+    numValues_(size_t(std::max(header.num_crs[0], 0)) * size_t(std::max(header.num_crs[1], 0)) * size_t(std::max(header.num_crs[2], 0))),
+    numWritten_(0),
+    statistics_(isIntegerFormat(format))
+{
+    mrcSetStoredFormat(&header_, format_);
+    header_.swap_bytes               = swap_;
+    header_.num_bytes_extened_header = int(header_.extended_header.size());
+    header_.format_identifier        = "MAP ";
+    // MACHST is the byte sequence 0x44 0x41 0x00 0x00 for little-endian and 0x11 0x11 0x00 0x00 for big-endian files
+    const bool          bigEndian = hostIsBigEndian() != swap_;
+    const char          stamp[4]  = { bigEndian ? '\x11' : '\x44', bigEndian ? '\x11' : '\x41', 0, 0 };
+    int32_t             machineStamp;
+    std::memcpy(&machineStamp, stamp, sizeof(machineStamp));
+    // the header words are swapped on writing, which restores the byte sequence
+    header_.machine_stamp = swap_ ? swapBytes(machineStamp) : machineStamp;
+    file_.writeAt(header_.extended_header.data(), header_.extended_header.size(), headerBytes_c);
+}
+
+size_t MrcFileWriter::Impl::write_offset_() const
+{
+    return headerBytes_c + header_.extended_header.size() + numWritten_ * formatBytes(format_);
+}
+
+/*******************************************************************************
+ * MrcFileWriter
+ */
+
+MrcFileWriter::MrcFileWriter(const std::string & filename, const MrcHeader &header, DataFormat format, Endianness endianness) :
+    impl_(new MrcFileWriter::Impl(filename, header, format, endianness))
+{
+}
+
+MrcFileWriter::~MrcFileWriter()
+{
+}
+
+void MrcFileWriter::write(const void * values, size_t count)
+{
+    Impl &impl = *impl_;
+    if (count > impl.numValues_ - impl.numWritten_)
+    {
+        throw std::runtime_error("More values than the grid of \"" + impl.file_.filename() + "\" holds.");
+    }
+    const size_t valueBytes = formatBytes(impl.format_);
+    {
+        ScopedStage stage(Stage::Statistics, count * valueBytes);
+        impl.statistics_.merge(computeStatistics(values, impl.format_, count));
+    }
+    ScopedStage stage(Stage::Write, count * valueBytes);
+    if (!impl.swap_ || valueBytes == 1)
+    {
+        impl.file_.writeAt(values, count * valueBytes, impl.write_offset_());
+        impl.numWritten_ += count;
+        return;
+    }
+    const char * source         = static_cast<const char *>(values);
+    const size_t valuesPerBlock = swapBlockBytes_c / valueBytes;
+    impl.swapped_.resize(std::min(count, valuesPerBlock) * valueBytes);
+    for (size_t first = 0; first < count; first += valuesPerBlock)
+    {
+        const size_t blockCount = std::min(valuesPerBlock, count - first);
+        std::memcpy(impl.swapped_.data(), source + first * valueBytes, blockCount * valueBytes);
+        swapBytes(impl.swapped_.data(), blockCount, valueBytes);
+        impl.file_.writeAt(impl.swapped_.data(), blockCount * valueBytes, impl.write_offset_());
+        impl.numWritten_ += blockCount;
+    }
+}
+
+void MrcFileWriter::consume(const Slab & slab)
+{
+    if (slab.format != impl_->format_)
+    {
+        throw std::logic_error("Slab format differs from the format of the mrc file.");
+    }
+    write(slab.data.data(), slab.data.size() / formatBytes(slab.format));
+}
+
+void MrcFileWriter::finish()
+{
+    Impl &impl = *impl_;
+    if (impl.numWritten_ != impl.numValues_)
+    {
+        throw std::runtime_error("Wrote " + std::to_string(impl.numWritten_) + " of " + std::to_string(impl.numValues_)
+                                 + " values of \"" + impl.file_.filename() + "\".");
+    }
+    const bool measured = impl.statistics_.count() > 0;
+    impl.header_.min_value  = measured ? impl.statistics_.min() : 0;
+    impl.header_.max_value  = measured ? impl.statistics_.max() : 0;
+    impl.header_.mean_value = measured ? float(impl.statistics_.mean()) : 0;
+    impl.header_.rms_value  = measured ? float(impl.statistics_.rms()) : 0;
+    ScopedStage stage(Stage::Write, headerBytes_c);
+    const std::vector<char> header = mrcHeaderBytes(impl.header_, impl.swap_);
+    impl.file_.writeAt(header.data(), header.size(), 0);
+}
+
+const ValueStatistics &MrcFileWriter::statistics() const
+{
+    return impl_->statistics_;
+}
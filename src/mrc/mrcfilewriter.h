@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Writing of mrc files.
+ */
+
+#ifndef MRCFILEWRITER_H_
+#define MRCFILEWRITER_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "convert/slab.h"
+#include "util/dataformat.h"
+
+struct MrcHeader;
+class ValueStatistics;
+
+/*! \brief Writes an mrc file from a header and voxel values that arrive in order.
+ *
+ * Values are appended in column, row, section order with large positioned writes, either
+ * in bulk with write() or slab by slab as a SlabSink. The density statistics are measured
+ * in the same pass and the header, with min, max, mean and rms filled in, is written by
+ * finish(), so the data is never read back.
+ *
+ * The data mode follows from the value format, see mrcSetStoredFormat(). Values are
+ * written with the chosen byte order, swapped with the vectorized routines of byteswap.h
+ * when it differs from the byte order of the machine.
+ */
+class MrcFileWriter : public SlabSink
+{
+public:
+    //! Byte order of the written file.
+    enum class Endianness
+    {
+        Native, //!< the byte order of this machine
+        Little, //!< little-endian, as written by most EM software
+        Big     //!< big-endian
+    };
+    /*! \brief Create the file and prepare to write values of the given format.
+     *
+     * \param[in] header grid size, cell, axis order, origin, labels and extended header of the volume;
+     *                   mode, statistics and machine stamp are set by the writer
+     * \throws std::runtime_error if the file cannot be created
+     */
+    MrcFileWriter(const std::string & filename, const MrcHeader &header, DataFormat format,
+                  Endianness endianness = Endianness::Native);
+    ~MrcFileWriter();
+
+    //! Append count native-endian values of the format given on construction.
+    void write(const void * values, size_t count);
+    //! Append the values of a slab, which must have the format given on construction.
+    void consume(const Slab & slab) override;
+    /*! \brief Write the header with the measured statistics.
+     *
+     * \throws std::runtime_error if the number of written values differs from the grid size in the header
+     */
+    void finish() override;
+
+    //! Statistics of the values written so far.
+    const ValueStatistics &statistics() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/*! \brief The 1024 bytes of the main header of an mrc file.
+ *
+ * The inverse of reading the header with MrcFileView: every header word is written
+ * from the corresponding field, with swapped bytes if swapBytes is set.
+ */
+std::vector<char> mrcHeaderBytes(const MrcHeader &header, bool swapBytes);
+
+#endif /* end of include guard: MRCFILEWRITER_H_ */
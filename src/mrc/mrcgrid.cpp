@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "mrcgrid.h"
+#include "mrcheader.h"
+
+std::array<size_t, 3> mrcNumCrs(const MrcHeader &header)
+{
+    return {{ size_t(header.num_crs[0]), size_t(header.num_crs[1]), size_t(header.num_crs[2]) }};
+}
+
+std::array<size_t, 3> mrcGridSize(const MrcHeader &header)
+{
+    std::array<size_t, 3> gridSize;
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        gridSize[header.crs_to_xyz[crs]] = header.num_crs[crs];
+    }
+    return gridSize;
+}
+
+std::array<float, 3> mrcVoxelSize(const MrcHeader &header)
+{
+    const std::array<size_t, 3> gridSize = mrcGridSize(header);
+    std::array<float, 3>        voxelSize;
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        const float intervals = header.extend[dim] > 0 ? header.extend[dim] : float(gridSize[dim]);
+        voxelSize[dim] = intervals > 0 ? header.cell_length[dim] / intervals : 1.0f;
+    }
+    return voxelSize;
+}
+
+bool mrcHasStandardAxisOrder(const MrcHeader &header)
+{
+    return header.crs_to_xyz[0] == 0 && header.crs_to_xyz[1] == 1 && header.crs_to_xyz[2] == 2;
+}
+
+GridRegion mrcFullGrid(const MrcHeader &header)
+{
+    GridRegion region;
+    region.begin = {{ 0, 0, 0 }};
+    region.size  = mrcGridSize(header);
+    return region;
+}
+
+std::array<float, 3> mrcFirstVoxelPosition(const MrcHeader &header)
+{
+    // extra holds header words 38-52, the MRC2014 origin is in words 50-52
+    const std::array<float, 3> origin = {{ header.extra[12], header.extra[13], header.extra[14] }};
+    if (origin[0] != 0 || origin[1] != 0 || origin[2] != 0)
+    {
+        return origin;
+    }
+
+    const std::array<float, 3> voxelSize = mrcVoxelSize(header);
+    std::array<float, 3>       position;
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        const int dim = header.crs_to_xyz[crs];
+        position[dim] = header.crs_start[crs] * voxelSize[dim];
+    }
+    return position;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Grid geometry derived from the mrc header.
+ */
+
+#ifndef MRCGRID_H_
+#define MRCGRID_H_
+
+#include <array>
+#include <cstddef>
+
+struct MrcHeader;
+
+//! A box of voxels in the x, y, z ordered grid.
+struct GridRegion
+{
+    std::array<size_t, 3> begin; //!< index of the first voxel along x, y and z
+    std::array<size_t, 3> size;  //!< number of voxels along x, y and z
+};
+
+//! Number of voxels along columns, rows and sections, as stored in the file.
+std::array<size_t, 3> mrcNumCrs(const MrcHeader &header);
+
+//! Number of voxels along x, y and z, taking the axis order MAPC, MAPR, MAPS into account.
+std::array<size_t, 3> mrcGridSize(const MrcHeader &header);
+
+/*! \brief Voxel spacing along x, y and z in Aangstrom.
+ *
+ * The unit cell length divided by the number of intervals per unit cell (X_LENGTH / NX).
+ * Falls back to the number of stored voxels along an axis if NX, NY or NZ are not set.
+ */
+std::array<float, 3> mrcVoxelSize(const MrcHeader &header);
+
+//! True if columns, rows and sections run along x, y and z.
+bool mrcHasStandardAxisOrder(const MrcHeader &header);
+
+//! The region covering all voxels in the file.
+GridRegion mrcFullGrid(const MrcHeader &header);
+
+/*! \brief Position of the center of the first stored voxel in Aangstrom.
+ *
+ * The MRC2014 origin (header words 50-52) if it is set, otherwise the grid start
+ * NCSTART, NRSTART, NSSTART times the voxel size, following the EMDB convention that
+ * the center of grid point (0,0,0) is the Cartesian origin.
+ */
+std::array<float, 3> mrcFirstVoxelPosition(const MrcHeader &header);
+
+#endif /* end of include guard: MRCGRID_H_ */
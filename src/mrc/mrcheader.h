@@ -43,16 +43,18 @@
 struct MrcHeader{
     bool                       swap_bytes;               //!< swap bytes upon reading/writing (applied, when endianess is different between file and machine architecture)
     int                        space_group;              //!< space group as defined by IUCr conventions (Table 12.3.4.1 Standard space-group symbols, pages 824-831, International Tables for Crystallography, Volume A, fifth edition)
-    /*!\brief The mrc standard defines modes 0-4.
+    /*!\brief The mrc standard defines modes 0-4, MRC2014 adds modes 6 and 12.
      *
      * MODE = 0: 8 bits, density stored as a signed byte (range -128 to 127, ISO/IEC 10967)
      * MODE = 1: 16 bits, density stored as a signed integer (range -32768 to 32767, ISO/IEC 10967)
      * MODE = 2: 32 bits, density stored as a floating point number (IEEE 754)
      * MODE = 3: 32 bits, Fourier transform stored as complex signed integers (ISO/IEC 10967)
      * MODE = 4: 64 bits, Fourier transform stored as complex floating point numbers (IEEE 754)
+     * MODE = 6: 16 bits, density stored as an unsigned integer (range 0 to 65535)
+     * MODE = 12: 16 bits, density stored as a half precision floating point number (IEEE 754)
      */
-    enum class                    MrcDataMode : int { uInt8 = 0, int16 = 1, float32 = 2, complexInt32 = 3, complexFloat64 = 4 };
-    int                           mrc_data_mode;            //!< data mode, currently only mode 2 is supported (32-bit float real values)
+    enum class                    MrcDataMode : int { int8 = 0, int16 = 1, float32 = 2, complexInt32 = 3, complexFloat64 = 4, uInt16 = 6, float16 = 12 };
+    int                           mrc_data_mode;            //!< data mode, modes 0, 1, 2, 6 and 12 hold real values that can be converted
     int                           machine_stamp;            //!< endianess of map writing architecture (big endian: 0x44410000 , little endian: 0x11110000)
     std::string                   format_identifier;        //!< for all density formats: four 1-byte chars reading "MAP " (a little pointless, I know)
 
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "mrcstatistics.h"
+
+#include <stdexcept>
+
+#include "mrc/mrcheader.h"
+#include "util/byteswap.h"
+#include "util/decompressingsource.h"
+#include "util/posixfile.h"
+#include "util/valuestatistics.h"
+
+namespace
+{
+
+//! Byte offsets of header words 20 to 22, DMIN, DMAX and DMEAN.
+constexpr size_t densityRangeOffset_c = 19 * 4;
+//! Byte offset of header word 55, RMS.
+constexpr size_t rmsOffset_c          = 54 * 4;
+
+}   // namespace
+
+void mrcWriteStatistics(const std::string &filename, const MrcHeader &header, const ValueStatistics &statistics)
+{
+    float range[3] = { statistics.min(), statistics.max(), float(statistics.mean()) };
+    float rms      = float(statistics.rms());
+    if (header.swap_bytes)
+    {
+        for (float &value : range)
+        {
+            value = swapBytes(value);
+        }
+        rms = swapBytes(rms);
+    }
+    PosixFile     file(filename, PosixFile::Mode::Update);
+    unsigned char magic[4];
+    DecompressingSource::Codec codec;
+    if (DecompressingSource::detectCodec(magic, file.readAtMost(magic, sizeof(magic), 0), &codec))
+    {
+        throw std::runtime_error("Cannot correct the header of compressed file \"" + filename + "\" in place.");
+    }
+    file.writeAt(range, sizeof(range), densityRangeOffset_c);
+    file.writeAt(&rms, sizeof(rms), rmsOffset_c);
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Correction of the density statistics in the header of an mrc file.
+ */
+
+#ifndef MRCSTATISTICS_H_
+#define MRCSTATISTICS_H_
+
+#include <string>
+
+struct MrcHeader;
+class ValueStatistics;
+
+/*! \brief Overwrite DMIN, DMAX, DMEAN and RMS in the header of an mrc file in place.
+ *
+ * The values are written with the byte order of the file; nothing else in the file changes.
+ * \param[in] header the header as read from the file
+ * \throws std::runtime_error if the file cannot be written or is compressed
+ */
+void mrcWriteStatistics(const std::string &filename, const MrcHeader &header, const ValueStatistics &statistics);
+
+#endif /* end of include guard: MRCSTATISTICS_H_ */
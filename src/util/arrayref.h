@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Non-owning view on contiguous memory.
+ */
+
+#ifndef ARRAYREF_H_
+#define ARRAYREF_H_
+
+#include <cstddef>
+#include <vector>
+
+/*! \brief Pointer plus extent into contiguous memory that is owned elsewhere.
+ *
+ * Works like a span: copying the view is cheap and never copies the data.
+ * The view is only valid as long as the memory it refers to.
+ *
+ * \tparam T value type, use a const type for read-only views
+ */
+template <typename T>
+class ArrayRef
+{
+public:
+    typedef T           value_type;
+    typedef T          *iterator;
+    typedef std::size_t size_type;
+
+    //! Empty view.
+    ArrayRef() : begin_(nullptr), end_(nullptr) {}
+    //! View on [begin, end).
+    ArrayRef(T * begin, T * end) : begin_(begin), end_(end) {}
+    //! View on size elements starting at data.
+    ArrayRef(T * data, size_type size) : begin_(data), end_(data + size) {}
+    //! View on all elements of a vector.
+    template <typename U>
+    ArrayRef(std::vector<U> &v) : begin_(v.data()), end_(v.data() + v.size()) {}
+    //! Read-only view on all elements of a vector.
+    template <typename U>
+    ArrayRef(const std::vector<U> &v) : begin_(v.data()), end_(v.data() + v.size()) {}
+
+    T * data() const { return begin_; }
+    size_type size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    iterator begin() const { return begin_; }
+    iterator end() const { return end_; }
+    T &operator[](size_type i) const { return begin_[i]; }
+
+private:
+    T * begin_;
+    T * end_;
+};
+
+#endif /* end of include guard: ARRAYREF_H_ */
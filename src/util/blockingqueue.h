@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Queue to hand work items between threads.
+ */
+
+#ifndef BLOCKINGQUEUE_H_
+#define BLOCKINGQUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/*! \brief First-in first-out queue where consumers wait for items.
+ *
+ * After close(), pop() drains the remaining items and then returns false,
+ * which lets consumer threads finish without extra sentinel values.
+ */
+template <typename T>
+class BlockingQueue
+{
+public:
+    BlockingQueue() : closed_(false) {}
+
+    void push(T value)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(std::move(value));
+        }
+        available_.notify_one();
+    }
+
+    //! Wait for the next item; returns false once the queue is closed and empty.
+    bool pop(T * value)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty())
+        {
+            return false;
+        }
+        *value = std::move(items_.front());
+        items_.pop_front();
+        return true;
+    }
+
+    //! Wake all waiting consumers; no further items are expected.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        available_.notify_all();
+    }
+
+private:
+    std::mutex              mutex_;
+    std::condition_variable available_;
+    std::deque<T>           items_;
+    bool                    closed_;
+};
+
+#endif /* end of include guard: BLOCKINGQUEUE_H_ */
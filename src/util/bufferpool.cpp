@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "bufferpool.h"
+
+#include <algorithm>
+
+BufferPool & BufferPool::shared()
+{
+    static BufferPool pool;
+    return pool;
+}
+
+BufferPool::BufferPool() : capacity_(0), pooledBytes_(0)
+{
+}
+
+void BufferPool::setCapacity(size_t bytes)
+{
+    std::vector<std::vector<char> > dropped;
+    std::lock_guard<std::mutex>     lock(mutex_);
+    capacity_ = bytes;
+    // buffers are kept sorted by capacity, drop the largest first
+    while (pooledBytes_ > capacity_)
+    {
+        pooledBytes_ -= buffers_.back().capacity();
+        dropped.push_back(std::move(buffers_.back()));
+        buffers_.pop_back();
+    }
+}
+
+std::vector<char> BufferPool::acquire(size_t size)
+{
+    std::vector<char> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto fits = std::lower_bound(buffers_.begin(), buffers_.end(), size,
+                                           [](const std::vector<char> &pooled, size_t bytes) { return pooled.capacity() < bytes; });
+        if (fits != buffers_.end())
+        {
+            buffer        = std::move(*fits);
+            pooledBytes_ -= buffer.capacity();
+            buffers_.erase(fits);
+        }
+    }
+    buffer.resize(size);
+    return buffer;
+}
+
+void BufferPool::release(std::vector<char> buffer)
+{
+    // buffers the pool has no room for are freed after the lock is released
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffer.capacity() == 0 || pooledBytes_ + buffer.capacity() > capacity_)
+    {
+        return;
+    }
+    pooledBytes_ += buffer.capacity();
+    const auto position = std::upper_bound(buffers_.begin(), buffers_.end(), buffer.capacity(),
+                                           [](size_t bytes, const std::vector<char> &pooled) { return bytes < pooled.capacity(); });
+    buffers_.insert(position, std::move(buffer));
+}
+
+size_t BufferPool::pooledBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooledBytes_;
+}
+
+char * PooledBuffer::resize(size_t size)
+{
+    if (size > buffer_.capacity())
+    {
+        BufferPool::shared().release(std::move(buffer_));
+        buffer_ = BufferPool::shared().acquire(size);
+    }
+    buffer_.resize(size);
+    return buffer_.data();
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Reuse of large byte buffers across conversions in one process.
+ */
+
+#ifndef BUFFERPOOL_H_
+#define BUFFERPOOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/*! \brief Keeps released byte buffers so later conversions reuse their memory.
+ *
+ * Freshly allocated large buffers come straight from the kernel and fault in every page
+ * on first touch; a process converting many files, like the conversion service, avoids
+ * that by taking its slab and volume buffers from the pool. Pooling is off until a
+ * capacity is set, so single conversions free their memory as before.
+ */
+class BufferPool
+{
+public:
+    //! The pool shared by all conversions in the process.
+    static BufferPool & shared();
+
+    //! Keep at most bytes of released buffers, dropping the largest ones beyond that.
+    void setCapacity(size_t bytes);
+
+    /*! \brief A buffer of size bytes.
+     *
+     * Reuses the smallest pooled buffer large enough, without clearing the bytes it held,
+     * so only bytes beyond its previous size are zero-initialized.
+     */
+    std::vector<char> acquire(size_t size);
+    //! Return a buffer for reuse; freed if the pool is full.
+    void release(std::vector<char> buffer);
+
+    //! Bytes held by the buffers in the pool.
+    size_t pooledBytes() const;
+
+private:
+    BufferPool();
+
+    mutable std::mutex              mutex_;
+    std::vector<std::vector<char> > buffers_;
+    size_t                          capacity_;
+    size_t                          pooledBytes_;
+};
+
+/*! \brief A buffer from the shared pool for the duration of a scope.
+ */
+class PooledBuffer
+{
+public:
+    PooledBuffer() {}
+    explicit PooledBuffer(size_t size) : buffer_(BufferPool::shared().acquire(size)) {}
+    ~PooledBuffer() { BufferPool::shared().release(std::move(buffer_)); }
+    PooledBuffer(const PooledBuffer &)            = delete;
+    PooledBuffer &operator=(const PooledBuffer &) = delete;
+
+    std::vector<char> & get() { return buffer_; }
+    //! Resize to size bytes, exchanging the buffer for a large enough pooled one if needed.
+    char * resize(size_t size);
+
+private:
+    std::vector<char> buffer_;
+};
+
+#endif /* end of include guard: BUFFERPOOL_H_ */
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Implements vectorized byte swapping with runtime CPU dispatch.
+ */
+#include "byteswap.h"
+
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BYTESWAP_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+/*! \brief Shuffle control that reverses the bytes within each ValueSize-byte lane of 16 bytes.
+ *
+ * AVX2 shuffles only within 128-bit lanes, so the same pattern serves both instruction sets.
+ */
+template <size_t ValueSize>
+struct ShuffleMask
+{
+    static void fill(unsigned char * mask)
+    {
+        for (size_t i = 0; i < 16; ++i)
+        {
+            mask[i] = static_cast<unsigned char>((i / ValueSize) * ValueSize + (ValueSize - 1 - i % ValueSize));
+        }
+    }
+};
+
+template <size_t ValueSize>
+void swap_scalar(unsigned char * data, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        unsigned char * value = data + i * ValueSize;
+        for (size_t b = 0; b < ValueSize / 2; ++b)
+        {
+            const unsigned char tmp    = value[b];
+            value[b]                   = value[ValueSize - 1 - b];
+            value[ValueSize - 1 - b]   = tmp;
+        }
+    }
+}
+
+template <>
+void swap_scalar<2>(unsigned char * data, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint16_t value;
+        std::memcpy(&value, data + 2 * i, 2);
+        value = static_cast<uint16_t>((value >> 8) | (value << 8));
+        std::memcpy(data + 2 * i, &value, 2);
+    }
+}
+
+template <>
+void swap_scalar<4>(unsigned char * data, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t value;
+        std::memcpy(&value, data + 4 * i, 4);
+        value = (value >> 24) | ((value >> 8) & 0x0000FF00u) | ((value << 8) & 0x00FF0000u) | (value << 24);
+        std::memcpy(data + 4 * i, &value, 4);
+    }
+}
+
+#ifdef BYTESWAP_HAVE_X86_SIMD
+
+template <size_t ValueSize>
+__attribute__((target("ssse3")))
+void swap_ssse3(unsigned char * data, size_t count)
+{
+    alignas(16) unsigned char maskBytes[16];
+    ShuffleMask<ValueSize>::fill(maskBytes);
+    const __m128i mask   = _mm_load_si128(reinterpret_cast<const __m128i *>(maskBytes));
+    const size_t  bytes  = count * ValueSize;
+    size_t        offset = 0;
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        __m128i * p = reinterpret_cast<__m128i *>(data + offset);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+    }
+    swap_scalar<ValueSize>(data + offset, (bytes - offset) / ValueSize);
+}
+
+template <size_t ValueSize>
+__attribute__((target("avx2")))
+void swap_avx2(unsigned char * data, size_t count)
+{
+    alignas(16) unsigned char maskBytes[16];
+    ShuffleMask<ValueSize>::fill(maskBytes);
+    const __m128i laneMask = _mm_load_si128(reinterpret_cast<const __m128i *>(maskBytes));
+    const __m256i mask     = _mm256_broadcastsi128_si256(laneMask);
+    const size_t  bytes    = count * ValueSize;
+    size_t        offset   = 0;
+    // two registers per iteration keep both shuffle ports busy
+    for (; offset + 64 <= bytes; offset += 64)
+    {
+        __m256i * p0 = reinterpret_cast<__m256i *>(data + offset);
+        __m256i * p1 = reinterpret_cast<__m256i *>(data + offset + 32);
+        const __m256i v0 = _mm256_loadu_si256(p0);
+        const __m256i v1 = _mm256_loadu_si256(p1);
+        _mm256_storeu_si256(p0, _mm256_shuffle_epi8(v0, mask));
+        _mm256_storeu_si256(p1, _mm256_shuffle_epi8(v1, mask));
+    }
+    for (; offset + 16 <= bytes; offset += 16)
+    {
+        __m128i * p = reinterpret_cast<__m128i *>(data + offset);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), laneMask));
+    }
+    swap_scalar<ValueSize>(data + offset, (bytes - offset) / ValueSize);
+}
+
+#endif
+
+typedef void (*KernelFunction)(unsigned char *, size_t);
+
+bool cpu_supports(SwapKernel kernel)
+{
+#ifdef BYTESWAP_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    switch (kernel)
+    {
+        case SwapKernel::Scalar: return true;
+        case SwapKernel::Ssse3: return __builtin_cpu_supports("ssse3");
+        case SwapKernel::Avx2: return __builtin_cpu_supports("avx2");
+    }
+    return false;
+#else
+    return kernel == SwapKernel::Scalar;
+#endif
+}
+
+template <size_t ValueSize>
+KernelFunction kernel_function(SwapKernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef BYTESWAP_HAVE_X86_SIMD
+        case SwapKernel::Ssse3: return &swap_ssse3<ValueSize>;
+        case SwapKernel::Avx2: return &swap_avx2<ValueSize>;
+#endif
+        default: return &swap_scalar<ValueSize>;
+    }
+}
+
+//! Pick the widest kernel the CPU supports, decided once per value size.
+template <size_t ValueSize>
+KernelFunction select_kernel()
+{
+    for (SwapKernel kernel : { SwapKernel::Avx2, SwapKernel::Ssse3 })
+    {
+        if (cpu_supports(kernel))
+        {
+            return kernel_function<ValueSize>(kernel);
+        }
+    }
+    return &swap_scalar<ValueSize>;
+}
+
+template <size_t ValueSize>
+void swap_dispatch(void * data, size_t count)
+{
+    static const KernelFunction kernel = select_kernel<ValueSize>();
+    kernel(static_cast<unsigned char *>(data), count);
+}
+
+}   // namespace
+
+void swapBytes16(void * data, size_t count)
+{
+    swap_dispatch<2>(data, count);
+}
+
+void swapBytes32(void * data, size_t count)
+{
+    swap_dispatch<4>(data, count);
+}
+
+void swapBytes64(void * data, size_t count)
+{
+    swap_dispatch<8>(data, count);
+}
+
+void swapBytes(void * data, size_t count, size_t valueSize)
+{
+    switch (valueSize)
+    {
+        case 2: swapBytes16(data, count); break;
+        case 4: swapBytes32(data, count); break;
+        case 8: swapBytes64(data, count); break;
+        default: break;
+    }
+}
+
+bool swapKernelSupported(SwapKernel kernel)
+{
+    return cpu_supports(kernel);
+}
+
+void swapBytesWith(SwapKernel kernel, void * data, size_t count, size_t valueSize)
+{
+    if (!cpu_supports(kernel))
+    {
+        throw std::logic_error("The byte swap kernel is not supported on this machine.");
+    }
+    unsigned char * bytes = static_cast<unsigned char *>(data);
+    switch (valueSize)
+    {
+        case 2: kernel_function<2>(kernel)(bytes, count); break;
+        case 4: kernel_function<4>(kernel)(bytes, count); break;
+        case 8: kernel_function<8>(kernel)(bytes, count); break;
+        default: break;
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Endianness conversion for single values and whole buffers.
+ */
+
+#ifndef BYTESWAP_H_
+#define BYTESWAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//! True if the machine stores the most significant byte of a value first.
+inline bool hostIsBigEndian()
+{
+    const uint32_t one = 1;
+    unsigned char  first;
+    std::memcpy(&first, &one, 1);
+    return first == 0;
+}
+
+/*! \brief Reverse the byte order of a value by its bit pattern.
+ *
+ * Works for any trivially copyable type of size 1, 2, 4 or 8 bytes,
+ * in particular for floating point values.
+ */
+template <typename T>
+T swapBytes(T value)
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "Can only swap bytes of 1, 2, 4 or 8 byte types.");
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T) / 2; ++i)
+    {
+        const unsigned char tmp  = bytes[i];
+        bytes[i]                 = bytes[sizeof(T) - 1 - i];
+        bytes[sizeof(T) - 1 - i] = tmp;
+    }
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/*! \brief Reverse the byte order of count consecutive 16-bit values in place.
+ *
+ * Uses AVX2 or SSSE3 shuffles when the CPU supports them, scalar code otherwise.
+ * data needs no particular alignment.
+ */
+void swapBytes16(void * data, size_t count);
+
+//! Reverse the byte order of count consecutive 32-bit values in place, see swapBytes16().
+void swapBytes32(void * data, size_t count);
+
+//! Reverse the byte order of count consecutive 64-bit values in place, see swapBytes16().
+void swapBytes64(void * data, size_t count);
+
+//! Reverse the byte order of count values of valueSize bytes each in place; valueSize 1 is a no-op.
+void swapBytes(void * data, size_t count, size_t valueSize);
+
+//! The implementations behind swapBytes16(), swapBytes32() and swapBytes64().
+enum class SwapKernel
+{
+    Scalar, //!< portable code, also swaps the tails of the vector kernels
+    Ssse3,  //!< 16-byte shuffles
+    Avx2    //!< 32-byte shuffles
+};
+
+//! True if this build and the CPU support the kernel.
+bool swapKernelSupported(SwapKernel kernel);
+
+/*! \brief Reverse the byte order of count values of valueSize bytes each in place with a given kernel.
+ *
+ * swapBytes() picks the widest supported kernel by itself; this is for checking the kernels against each other.
+ * \throws std::logic_error if the kernel is not supported, see swapKernelSupported()
+ */
+void swapBytesWith(SwapKernel kernel, void * data, size_t count, size_t valueSize);
+
+#endif /* end of include guard: BYTESWAP_H_ */
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "dataformat.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+
+template <typename T>
+void to_float(const void * values, float * result, size_t count)
+{
+    const T * typed = static_cast<const T *>(values);
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = static_cast<float>(typed[i]);
+    }
+}
+
+template <typename T>
+void from_float(const float * values, void * result, size_t count)
+{
+    const float lowest  = static_cast<float>(std::numeric_limits<T>::lowest());
+    const float highest = static_cast<float>(std::numeric_limits<T>::max());
+    T *         typed   = static_cast<T *>(result);
+    for (size_t i = 0; i < count; ++i)
+    {
+        typed[i] = static_cast<T>(std::min(std::max(std::nearbyint(values[i]), lowest), highest));
+    }
+}
+
+}   // namespace
+
+size_t formatBytes(DataFormat format)
+{
+    switch (format)
+    {
+        case DataFormat::INT8:    return 1;
+        case DataFormat::UINT8:   return 1;
+        case DataFormat::INT16:   return 2;
+        case DataFormat::UINT16:  return 2;
+        case DataFormat::FLOAT16: return 2;
+        case DataFormat::FLOAT32: return 4;
+    }
+    return 0;
+}
+
+const char * formatName(DataFormat format)
+{
+    switch (format)
+    {
+        case DataFormat::INT8:    return "INT8";
+        case DataFormat::UINT8:   return "UINT8";
+        case DataFormat::INT16:   return "INT16";
+        case DataFormat::UINT16:  return "UINT16";
+        case DataFormat::FLOAT16: return "FLOAT16";
+        case DataFormat::FLOAT32: return "FLOAT32";
+    }
+    return "";
+}
+
+bool formatFromName(const std::string & name, DataFormat * format)
+{
+    std::string upperCase(name);
+    std::transform(upperCase.begin(), upperCase.end(), upperCase.begin(), ::toupper);
+    for (DataFormat candidate : {DataFormat::INT8, DataFormat::UINT8, DataFormat::INT16, DataFormat::UINT16, DataFormat::FLOAT16, DataFormat::FLOAT32})
+    {
+        if (upperCase == formatName(candidate))
+        {
+            *format = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+float halfToFloat(uint16_t half)
+{
+    const uint32_t sign     = uint32_t(half & 0x8000) << 16;
+    uint32_t       exponent = (half >> 10) & 0x1F;
+    uint32_t       mantissa = half & 0x03FF;
+    uint32_t       bits;
+    if (exponent == 0x1F)
+    {
+        // infinity or NaN, keep the payload
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0)
+    {
+        bits = sign;
+    }
+    else
+    {
+        // subnormal half, normalize the mantissa
+        exponent = 127 - 15 + 1;
+        while ((mantissa & 0x0400) == 0)
+        {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x03FF) << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+bool isIntegerFormat(DataFormat format)
+{
+    return format != DataFormat::FLOAT16 && format != DataFormat::FLOAT32;
+}
+
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const int32_t  exponent = int32_t((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t       mantissa = bits & 0x007FFFFF;
+
+    if (((bits >> 23) & 0xFF) == 0xFF)
+    {
+        // infinity stays infinity, NaN stays a quiet NaN
+        return sign | 0x7C00 | (mantissa != 0 ? 0x0200 : 0);
+    }
+    if (exponent >= 0x1F)
+    {
+        return sign | 0x7C00;
+    }
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            return sign;
+        }
+        // subnormal half, shift in the implicit leading one
+        mantissa |= 0x00800000;
+        const uint32_t shift     = uint32_t(14 - exponent);
+        uint32_t       half      = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway   = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+        {
+            ++half;
+        }
+        return sign | static_cast<uint16_t>(half);
+    }
+    uint32_t half = (uint32_t(exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        // may carry into the exponent, which correctly rounds up to infinity
+        ++half;
+    }
+    return sign | static_cast<uint16_t>(half);
+}
+
+void toFloat(const void * values, DataFormat format, float * result, size_t count)
+{
+    switch (format)
+    {
+        case DataFormat::INT8:    to_float<int8_t>(values, result, count); break;
+        case DataFormat::UINT8:   to_float<uint8_t>(values, result, count); break;
+        case DataFormat::INT16:   to_float<int16_t>(values, result, count); break;
+        case DataFormat::UINT16:  to_float<uint16_t>(values, result, count); break;
+        case DataFormat::FLOAT32: std::memcpy(result, values, count * sizeof(float)); break;
+        case DataFormat::FLOAT16:
+        {
+            const uint16_t * halfs = static_cast<const uint16_t *>(values);
+            for (size_t i = 0; i < count; ++i)
+            {
+                result[i] = halfToFloat(halfs[i]);
+            }
+            break;
+        }
+    }
+}
+
+void fromFloat(const float * values, DataFormat format, void * result, size_t count)
+{
+    switch (format)
+    {
+        case DataFormat::INT8:    from_float<int8_t>(values, result, count); break;
+        case DataFormat::UINT8:   from_float<uint8_t>(values, result, count); break;
+        case DataFormat::INT16:   from_float<int16_t>(values, result, count); break;
+        case DataFormat::UINT16:  from_float<uint16_t>(values, result, count); break;
+        case DataFormat::FLOAT32: std::memcpy(result, values, count * sizeof(float)); break;
+        case DataFormat::FLOAT16:
+        {
+            uint16_t * halfs = static_cast<uint16_t *>(result);
+            for (size_t i = 0; i < count; ++i)
+            {
+                halfs[i] = floatToHalf(values[i]);
+            }
+            break;
+        }
+    }
+}
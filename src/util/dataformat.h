@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Voxel value types and their Inviwo names.
+ */
+
+#ifndef DATAFORMAT_H_
+#define DATAFORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//! Scalar voxel value types, named after the corresponding Inviwo data formats.
+enum class DataFormat
+{
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    FLOAT16,
+    FLOAT32
+};
+
+//! Number of bytes of a single voxel value.
+size_t formatBytes(DataFormat format);
+
+//! Name of the format in Inviwo .dat files.
+const char * formatName(DataFormat format);
+
+/*! \brief The format with the given name in Inviwo .dat files, in any case.
+ *
+ * \returns false if no format has this name
+ */
+bool formatFromName(const std::string & name, DataFormat * format);
+
+//! True for the formats that hold integer values.
+bool isIntegerFormat(DataFormat format);
+
+//! Convert IEEE 754 half precision bits to float, including subnormals, infinities and NaN.
+float halfToFloat(uint16_t half);
+
+//! Convert float to IEEE 754 half precision bits, rounding to nearest even.
+uint16_t floatToHalf(float value);
+
+//! Convert count native-endian values of the given format to float.
+void toFloat(const void * values, DataFormat format, float * result, size_t count);
+
+/*! \brief Convert count floats to values of the given format.
+ *
+ * Integer formats round to the nearest integer and clamp to the range of the type.
+ */
+void fromFloat(const float * values, DataFormat format, void * result, size_t count);
+
+#endif /* end of include guard: DATAFORMAT_H_ */
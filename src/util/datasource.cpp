@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "datasource.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+#include "util/decompressingsource.h"
+#include "util/posixfile.h"
+
+namespace
+{
+
+//! File extensions of the compressed formats that can be read.
+const std::vector<std::string> &compression_extensions()
+{
+    static const std::vector<std::string> extensions {".gz", ".bz2", ".zst"};
+    return extensions;
+}
+
+//! Length of the compression extension that filename ends with, zero if none.
+size_t compression_extension_length(const std::string &filename)
+{
+    std::string lowerCase(filename);
+    std::transform(lowerCase.begin(), lowerCase.end(), lowerCase.begin(), ::tolower);
+    for (const std::string &extension : compression_extensions())
+    {
+        if (lowerCase.size() > extension.size()
+            && lowerCase.compare(lowerCase.size() - extension.size(), extension.size(), extension) == 0)
+        {
+            return extension.size();
+        }
+    }
+    return 0;
+}
+
+}   // namespace
+
+const size_t DataSource::unknownSize;
+
+std::unique_ptr<DataSource> openDataSource(const std::string &filename)
+{
+    std::vector<char> magic(4);
+    return openDataSource(filename, &magic);
+}
+
+std::unique_ptr<DataSource> openDataSource(const std::string &filename, std::vector<char> * prefix)
+{
+    std::unique_ptr<PosixFile> file(new PosixFile(filename, PosixFile::Mode::Read));
+    // the magic bytes of the compressed formats are no longer than four bytes
+    prefix->resize(std::max<size_t>(prefix->size(), 4));
+    prefix->resize(file->readAtMost(prefix->data(), prefix->size(), 0));
+    DecompressingSource::Codec codec;
+    if (DecompressingSource::detectCodec(reinterpret_cast<const unsigned char *>(prefix->data()), prefix->size(), &codec))
+    {
+        prefix->clear();
+        return std::unique_ptr<DataSource>(new DecompressingSource(std::move(file), codec));
+    }
+    return file;
+}
+
+bool hasCompressionExtension(const std::string &filename)
+{
+    return compression_extension_length(filename) > 0;
+}
+
+std::string stripCompressionExtension(const std::string &filename)
+{
+    return filename.substr(0, filename.size() - compression_extension_length(filename));
+}
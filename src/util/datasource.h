@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Uniform positioned reading from plain and compressed files.
+ */
+
+#ifndef DATASOURCE_H_
+#define DATASOURCE_H_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \brief Bytes that are read at given offsets.
+ *
+ * Plain files allow reading at any offset. Compressed files are decompressed as a stream,
+ * so they only allow reading at or beyond the end of the previous read; skipped bytes are
+ * decompressed and dropped.
+ */
+class DataSource
+{
+public:
+    //! Returned by size() if the size is not known before all data is read.
+    static const size_t unknownSize = std::numeric_limits<size_t>::max();
+
+    virtual ~DataSource() {}
+    //! Read exactly size bytes at offset; throws std::runtime_error if the data ends before.
+    virtual void readAt(void * buffer, size_t size, size_t offset) const = 0;
+    //! True if offsets passed to readAt() must not decrease.
+    virtual bool isSequential() const = 0;
+    //! Number of bytes that can be read, or unknownSize.
+    virtual size_t size() const = 0;
+    virtual const std::string &filename() const = 0;
+};
+
+/*! \brief Open a file for reading, decompressing gzip, bzip2 and zstd data on the fly.
+ *
+ * The compression is recognized by the first bytes of the file, not by its name.
+ * \throws std::runtime_error if the file cannot be opened or the program was built without support for its compression
+ */
+std::unique_ptr<DataSource> openDataSource(const std::string &filename);
+
+/*! \brief Open a file like openDataSource() and read the start of a plain file with the same read.
+ *
+ * The size of prefix on entry is the number of bytes to read from the start of the file, at
+ * least the four needed to recognize the compression.
+ * Plain files shrink prefix to the bytes that were read, so a header at the start of the
+ * file needs no further read; compressed files leave prefix empty.
+ */
+std::unique_ptr<DataSource> openDataSource(const std::string &filename, std::vector<char> * prefix);
+
+//! True if filename ends in .gz, .bz2 or .zst, in any case.
+bool hasCompressionExtension(const std::string &filename);
+
+//! filename without a trailing .gz, .bz2 or .zst, e.g. emd_1234.map for emd_1234.map.gz.
+std::string stripCompressionExtension(const std::string &filename);
+
+#endif /* end of include guard: DATASOURCE_H_ */
@@ -0,0 +1,692 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "decompressingsource.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "util/blockingqueue.h"
+#include "util/parallel.h"
+#include "util/posixfile.h"
+#include "util/stagereport.h"
+
+#ifdef MRCTOINVIWO_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef MRCTOINVIWO_HAVE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef MRCTOINVIWO_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace
+{
+
+//! Size of the decompressed chunks handed to the reader.
+constexpr size_t chunkBytes_c      = 4 << 20;
+//! Number of chunks that are decompressed ahead of the reader, plus one being read.
+constexpr size_t chunksInFlight_c  = 4;
+//! Compressed bytes read at once when decompressing as a stream.
+constexpr size_t inputBytes_c      = 1 << 20;
+//! Largest independent part that is decompressed on its own; larger ones are streamed.
+constexpr size_t maxPartBytes_c    = 4 * chunkBytes_c;
+
+const char * codec_name(DecompressingSource::Codec codec)
+{
+    switch (codec)
+    {
+        case DecompressingSource::Codec::Gzip:  return "gzip";
+        case DecompressingSource::Codec::Bzip2: return "bzip2";
+        case DecompressingSource::Codec::Zstd:  return "zstd";
+    }
+    return "";
+}
+
+uint32_t little_endian_32(const unsigned char * bytes)
+{
+    return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+uint16_t little_endian_16(const unsigned char * bytes)
+{
+    return uint16_t(bytes[0] | (bytes[1] << 8));
+}
+
+//! An independently compressed part of the file and where its data goes in the chunk.
+struct Part
+{
+    size_t fileOffset;
+    size_t compressedBytes;
+    size_t outputOffset;
+    size_t outputBytes;
+};
+
+}   // namespace
+
+/*******************************************************************************
+ * DecompressingSource::Impl
+ */
+class DecompressingSource::Impl
+{
+    public:
+        Impl(std::unique_ptr<PosixFile> file, Codec codec);
+        ~Impl();
+
+        //! Decompress the whole file into chunks; runs on the background thread.
+        void produce_();
+
+        //! An empty chunk to fill, or nullptr once the reader is gone.
+        std::vector<char> * acquire_();
+        //! Hand a filled chunk to the reader, or drop an empty one.
+        void publish_(std::vector<char> * chunk);
+
+        /*! \brief Decompress a batch of independent parts in parallel.
+         *
+         * \param[in] decompress decompresses one part, given its compressed bytes and output
+         * \returns false if the reader is gone
+         */
+        template <typename Decompress>
+        bool decompress_parts_(const std::vector<Part> &parts, Decompress decompress);
+
+        void gunzip_();
+        //! Decompress BGZF blocks in parallel, until the end or data that is not BGZF; returns the offset reached.
+        size_t gunzip_blocks_();
+        void gunzip_stream_(size_t offset);
+        void bunzip2_stream_();
+        void unzstd_();
+        void unzstd_stream_(size_t offset);
+
+        std::unique_ptr<PosixFile>          file_;
+        Codec                               codec_;
+        std::vector<std::vector<char> >     buffers_;
+        BlockingQueue<std::vector<char> *>  free_;
+        BlockingQueue<std::vector<char> *>  filled_;
+        std::exception_ptr                  error_;   //!< set by the producer before it closes filled_
+        std::thread                         producer_;
+
+        std::vector<char>                 * current_;  //!< chunk being read
+        size_t                              chunkPosition_;
+        size_t                              position_; //!< decompressed offset of the next byte
+};
+
+DecompressingSource::Impl::Impl(std::unique_ptr<PosixFile> file, Codec codec) :
+    file_(std::move(file)), codec_(codec), buffers_(chunksInFlight_c),
+    current_(nullptr), chunkPosition_(0), position_(0)
+{
+    for (std::vector<char> &buffer : buffers_)
+    {
+        free_.push(&buffer);
+    }
+    // reads of the compressed file count for the file being converted on the calling thread
+    StageReport * report = StageReport::current();
+    producer_ = std::thread([this, report] {
+            ReportScope scope(report);
+            try
+            {
+                produce_();
+            }
+            catch (...)
+            {
+                error_ = std::current_exception();
+            }
+            filled_.close();
+        });
+}
+
+DecompressingSource::Impl::~Impl()
+{
+    free_.close();
+    filled_.close();
+    producer_.join();
+}
+
+std::vector<char> * DecompressingSource::Impl::acquire_()
+{
+    std::vector<char> * chunk;
+    return free_.pop(&chunk) ? chunk : nullptr;
+}
+
+void DecompressingSource::Impl::publish_(std::vector<char> * chunk)
+{
+    if (chunk->empty())
+    {
+        free_.push(chunk);
+        return;
+    }
+    filled_.push(chunk);
+}
+
+void DecompressingSource::Impl::produce_()
+{
+    switch (codec_)
+    {
+        case Codec::Gzip:  gunzip_(); break;
+        case Codec::Bzip2: bunzip2_stream_(); break;
+        case Codec::Zstd:  unzstd_(); break;
+    }
+}
+
+template <typename Decompress>
+bool DecompressingSource::Impl::decompress_parts_(const std::vector<Part> &parts, Decompress decompress)
+{
+    std::vector<char> * chunk = acquire_();
+    if (chunk == nullptr)
+    {
+        return false;
+    }
+    const Part &last = parts.back();
+    chunk->resize(last.outputOffset + last.outputBytes);
+    parallelFor(parts.size(), [&](size_t index) {
+            const Part          &part = parts[index];
+            std::vector<char>    compressed(part.compressedBytes);
+            file_->readAt(compressed.data(), compressed.size(), part.fileOffset);
+            decompress(compressed, chunk->data() + part.outputOffset, part.outputBytes);
+        });
+    publish_(chunk);
+    return true;
+}
+
+#ifdef MRCTOINVIWO_HAVE_ZLIB
+
+void DecompressingSource::Impl::gunzip_()
+{
+    gunzip_stream_(gunzip_blocks_());
+}
+
+size_t DecompressingSource::Impl::gunzip_blocks_()
+{
+    // a BGZF block is a gzip member with only the extra field set, holding the block size in subfield "BC"
+    constexpr size_t headerBytes  = 18;
+    constexpr size_t trailerBytes = 8;
+    size_t           offset       = 0;
+    for (;;)
+    {
+        std::vector<Part> parts;
+        size_t            outputBytes = 0;
+        while (outputBytes < chunkBytes_c)
+        {
+            unsigned char header[headerBytes];
+            if (file_->readAtMost(header, headerBytes, offset) < headerBytes
+                || header[0] != 0x1f || header[1] != 0x8b || header[2] != 8 || header[3] != 4
+                || little_endian_16(header + 10) != 6 || header[12] != 'B' || header[13] != 'C'
+                || little_endian_16(header + 14) != 2)
+            {
+                break;
+            }
+            const size_t  blockBytes = size_t(little_endian_16(header + 16)) + 1;
+            unsigned char trailer[trailerBytes];
+            if (blockBytes < headerBytes + trailerBytes
+                || file_->readAtMost(trailer, trailerBytes, offset + blockBytes - trailerBytes) < trailerBytes)
+            {
+                break;
+            }
+            const size_t blockOutputBytes = little_endian_32(trailer + 4);
+            parts.push_back({ offset, blockBytes, outputBytes, blockOutputBytes });
+            outputBytes += blockOutputBytes;
+            offset      += blockBytes;
+        }
+        if (parts.empty())
+        {
+            return offset;
+        }
+        const bool running = decompress_parts_(parts, [this](const std::vector<char> &block, char * output, size_t outputBytes) {
+                if (outputBytes == 0)
+                {
+                    // e.g. the empty block that marks the end of a BGZF file
+                    return;
+                }
+                z_stream stream;
+                std::memset(&stream, 0, sizeof(stream));
+                // raw deflate data, the member header and trailer are handled here
+                if (inflateInit2(&stream, -15) != Z_OK)
+                {
+                    throw std::runtime_error("Cannot initialize gzip decompression.");
+                }
+                stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(block.data() + headerBytes));
+                stream.avail_in  = uInt(block.size() - headerBytes - trailerBytes);
+                stream.next_out  = reinterpret_cast<Bytef *>(output);
+                stream.avail_out = uInt(outputBytes);
+                const int result = inflate(&stream, Z_FINISH);
+                inflateEnd(&stream);
+                const uint32_t crc = uint32_t(crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef *>(output), uInt(outputBytes)));
+                if (result != Z_STREAM_END || stream.avail_out != 0
+                    || crc != little_endian_32(reinterpret_cast<const unsigned char *>(block.data() + block.size() - trailerBytes)))
+                {
+                    throw std::runtime_error("Corrupt BGZF block in \"" + file_->filename() + "\".");
+                }
+            });
+        if (!running)
+        {
+            return std::numeric_limits<size_t>::max();
+        }
+    }
+}
+
+void DecompressingSource::Impl::gunzip_stream_(size_t offset)
+{
+    if (offset >= file_->size())
+    {
+        return;
+    }
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // window bits 15 + 32 accept gzip and zlib headers
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+        throw std::runtime_error("Cannot initialize gzip decompression.");
+    }
+    std::unique_ptr<z_stream, int (*)(z_stream *)> cleanup(&stream, &inflateEnd);
+
+    std::vector<unsigned char> input(inputBytes_c);
+    std::vector<char>        * chunk       = nullptr;
+    bool                       memberEnded = false;
+    for (;;)
+    {
+        if (chunk == nullptr)
+        {
+            if ((chunk = acquire_()) == nullptr)
+            {
+                return;
+            }
+            chunk->resize(chunkBytes_c);
+            stream.next_out  = reinterpret_cast<Bytef *>(chunk->data());
+            stream.avail_out = uInt(chunk->size());
+        }
+        if (stream.avail_in == 0)
+        {
+            const size_t numRead = file_->readAtMost(input.data(), input.size(), offset);
+            offset += numRead;
+            if (numRead == 0)
+            {
+                break;
+            }
+            stream.next_in  = input.data();
+            stream.avail_in = uInt(numRead);
+        }
+        const int result = inflate(&stream, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+        {
+            // another member may follow
+            memberEnded = true;
+            inflateReset(&stream);
+        }
+        else if (result == Z_OK)
+        {
+            memberEnded = false;
+        }
+        else if (result == Z_DATA_ERROR && memberEnded)
+        {
+            // trailing padding after the last member, as gzip tolerates
+            break;
+        }
+        else if (result != Z_BUF_ERROR)
+        {
+            throw std::runtime_error("Corrupt gzip data in \"" + file_->filename() + "\".");
+        }
+        if (stream.avail_out == 0)
+        {
+            publish_(chunk);
+            chunk = nullptr;
+        }
+    }
+    if (chunk != nullptr)
+    {
+        chunk->resize(chunk->size() - stream.avail_out);
+        publish_(chunk);
+    }
+    if (!memberEnded)
+    {
+        throw std::runtime_error("Truncated gzip data in \"" + file_->filename() + "\".");
+    }
+}
+
+#else
+
+void DecompressingSource::Impl::gunzip_()
+{
+}
+
+#endif
+
+#ifdef MRCTOINVIWO_HAVE_BZIP2
+
+void DecompressingSource::Impl::bunzip2_stream_()
+{
+    bz_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK)
+    {
+        throw std::runtime_error("Cannot initialize bzip2 decompression.");
+    }
+    std::unique_ptr<bz_stream, int (*)(bz_stream *)> cleanup(&stream, &BZ2_bzDecompressEnd);
+
+    std::vector<char>   input(inputBytes_c);
+    std::vector<char> * chunk       = nullptr;
+    size_t              offset      = 0;
+    bool                streamEnded = false;
+    for (;;)
+    {
+        if (chunk == nullptr)
+        {
+            if ((chunk = acquire_()) == nullptr)
+            {
+                return;
+            }
+            chunk->resize(chunkBytes_c);
+            stream.next_out  = chunk->data();
+            stream.avail_out = unsigned(chunk->size());
+        }
+        if (stream.avail_in == 0)
+        {
+            const size_t numRead = file_->readAtMost(input.data(), input.size(), offset);
+            offset += numRead;
+            if (numRead == 0)
+            {
+                break;
+            }
+            stream.next_in  = input.data();
+            stream.avail_in = unsigned(numRead);
+        }
+        const int result = BZ2_bzDecompress(&stream);
+        if (result == BZ_STREAM_END)
+        {
+            // concatenated streams, as written by parallel bzip2 compressors, continue with a fresh decoder
+            char * const   nextIn   = stream.next_in;
+            const unsigned availIn  = stream.avail_in;
+            char * const   nextOut  = stream.next_out;
+            const unsigned availOut = stream.avail_out;
+            BZ2_bzDecompressEnd(&stream);
+            std::memset(&stream, 0, sizeof(stream));
+            if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK)
+            {
+                throw std::runtime_error("Cannot initialize bzip2 decompression.");
+            }
+            stream.next_in   = nextIn;
+            stream.avail_in  = availIn;
+            stream.next_out  = nextOut;
+            stream.avail_out = availOut;
+            streamEnded      = true;
+        }
+        else if (result == BZ_OK)
+        {
+            streamEnded = false;
+        }
+        else if (result == BZ_DATA_ERROR_MAGIC && streamEnded)
+        {
+            // trailing garbage after the last stream
+            break;
+        }
+        else
+        {
+            throw std::runtime_error("Corrupt bzip2 data in \"" + file_->filename() + "\".");
+        }
+        if (stream.avail_out == 0)
+        {
+            publish_(chunk);
+            chunk = nullptr;
+        }
+    }
+    if (chunk != nullptr)
+    {
+        chunk->resize(chunk->size() - stream.avail_out);
+        publish_(chunk);
+    }
+    if (!streamEnded)
+    {
+        throw std::runtime_error("Truncated bzip2 data in \"" + file_->filename() + "\".");
+    }
+}
+
+#else
+
+void DecompressingSource::Impl::bunzip2_stream_()
+{
+}
+
+#endif
+
+#ifdef MRCTOINVIWO_HAVE_ZSTD
+
+void DecompressingSource::Impl::unzstd_()
+{
+    // frames that state their decompressed size are decompressed in parallel
+    std::vector<char> window;
+    size_t            offset = 0;
+    for (;;)
+    {
+        window.resize(maxPartBytes_c);
+        window.resize(file_->readAtMost(window.data(), window.size(), offset));
+        if (window.empty())
+        {
+            return;
+        }
+
+        std::vector<Part> parts;
+        size_t            position    = 0;
+        size_t            outputBytes = 0;
+        while (position < window.size() && outputBytes < chunkBytes_c)
+        {
+            const size_t             frameBytes  = ZSTD_findFrameCompressedSize(window.data() + position, window.size() - position);
+            const unsigned long long contentSize = ZSTD_getFrameContentSize(window.data() + position, window.size() - position);
+            if (ZSTD_isError(frameBytes) || contentSize == ZSTD_CONTENTSIZE_UNKNOWN
+                || contentSize == ZSTD_CONTENTSIZE_ERROR || contentSize > maxPartBytes_c)
+            {
+                break;
+            }
+            parts.push_back({ offset + position, frameBytes, outputBytes, size_t(contentSize) });
+            position    += frameBytes;
+            outputBytes += size_t(contentSize);
+        }
+        if (parts.empty())
+        {
+            unzstd_stream_(offset);
+            return;
+        }
+        const bool running = decompress_parts_(parts, [this](const std::vector<char> &frame, char * output, size_t outputBytes) {
+                const size_t result = ZSTD_decompress(output, outputBytes, frame.data(), frame.size());
+                if (ZSTD_isError(result) || result != outputBytes)
+                {
+                    throw std::runtime_error("Corrupt zstd frame in \"" + file_->filename() + "\".");
+                }
+            });
+        if (!running)
+        {
+            return;
+        }
+        offset += position;
+    }
+}
+
+void DecompressingSource::Impl::unzstd_stream_(size_t offset)
+{
+    std::unique_ptr<ZSTD_DStream, size_t (*)(ZSTD_DStream *)> stream(ZSTD_createDStream(), &ZSTD_freeDStream);
+    if (!stream || ZSTD_isError(ZSTD_initDStream(stream.get())))
+    {
+        throw std::runtime_error("Cannot initialize zstd decompression.");
+    }
+
+    std::vector<char>   input(ZSTD_DStreamInSize());
+    ZSTD_inBuffer       in          = { input.data(), 0, 0 };
+    std::vector<char> * chunk       = nullptr;
+    ZSTD_outBuffer      out         = { nullptr, 0, 0 };
+    bool                frameEnded  = true;
+    for (;;)
+    {
+        if (chunk == nullptr)
+        {
+            if ((chunk = acquire_()) == nullptr)
+            {
+                return;
+            }
+            chunk->resize(chunkBytes_c);
+            out = { chunk->data(), chunk->size(), 0 };
+        }
+        if (in.pos == in.size)
+        {
+            const size_t numRead = file_->readAtMost(input.data(), input.size(), offset);
+            offset += numRead;
+            if (numRead == 0)
+            {
+                break;
+            }
+            in = { input.data(), numRead, 0 };
+        }
+        // decompresses concatenated frames one after the other, returns zero at the end of each frame
+        const size_t result = ZSTD_decompressStream(stream.get(), &out, &in);
+        if (ZSTD_isError(result))
+        {
+            throw std::runtime_error("Corrupt zstd data in \"" + file_->filename() + "\": " + ZSTD_getErrorName(result));
+        }
+        frameEnded = result == 0;
+        if (out.pos == out.size)
+        {
+            publish_(chunk);
+            chunk = nullptr;
+        }
+    }
+    if (chunk != nullptr)
+    {
+        chunk->resize(out.pos);
+        publish_(chunk);
+    }
+    if (!frameEnded)
+    {
+        throw std::runtime_error("Truncated zstd data in \"" + file_->filename() + "\".");
+    }
+}
+
+#else
+
+void DecompressingSource::Impl::unzstd_()
+{
+}
+
+#endif
+
+/*******************************************************************************
+ * DecompressingSource
+ */
+
+DecompressingSource::DecompressingSource(std::unique_ptr<PosixFile> file, Codec codec)
+{
+    bool supported = false;
+    switch (codec)
+    {
+#ifdef MRCTOINVIWO_HAVE_ZLIB
+        case Codec::Gzip:  supported = true; break;
+#endif
+#ifdef MRCTOINVIWO_HAVE_BZIP2
+        case Codec::Bzip2: supported = true; break;
+#endif
+#ifdef MRCTOINVIWO_HAVE_ZSTD
+        case Codec::Zstd:  supported = true; break;
+#endif
+        default: break;
+    }
+    if (!supported)
+    {
+        throw std::runtime_error("\"" + file->filename() + "\" is " + codec_name(codec)
+                                 + " compressed, but this program was built without " + codec_name(codec) + " support.");
+    }
+    impl_.reset(new Impl(std::move(file), codec));
+}
+
+DecompressingSource::~DecompressingSource()
+{
+}
+
+const std::string &DecompressingSource::filename() const
+{
+    return impl_->file_->filename();
+}
+
+void DecompressingSource::readAt(void * buffer, size_t size, size_t offset) const
+{
+    Impl &impl = *impl_;
+    if (offset < impl.position_)
+    {
+        throw std::runtime_error("Cannot read backwards in compressed file \"" + filename() + "\".");
+    }
+    char * destination = static_cast<char *>(buffer);
+    while (size > 0)
+    {
+        if (impl.current_ == nullptr || impl.chunkPosition_ == impl.current_->size())
+        {
+            if (impl.current_ != nullptr)
+            {
+                impl.free_.push(impl.current_);
+                impl.current_ = nullptr;
+            }
+            if (!impl.filled_.pop(&impl.current_))
+            {
+                impl.current_ = nullptr;
+                if (impl.error_)
+                {
+                    std::rethrow_exception(impl.error_);
+                }
+                throw std::runtime_error("Unexpected end of file in \"" + filename() + "\".");
+            }
+            impl.chunkPosition_ = 0;
+        }
+        const size_t available = impl.current_->size() - impl.chunkPosition_;
+        if (offset > impl.position_)
+        {
+            // skip decompressed bytes up to offset
+            const size_t skipped = std::min(available, offset - impl.position_);
+            impl.chunkPosition_ += skipped;
+            impl.position_      += skipped;
+            continue;
+        }
+        const size_t count = std::min(available, size);
+        std::memcpy(destination, impl.current_->data() + impl.chunkPosition_, count);
+        destination         += count;
+        size                -= count;
+        offset              += count;
+        impl.chunkPosition_ += count;
+        impl.position_      += count;
+    }
+}
+
+bool DecompressingSource::detectCodec(const unsigned char * bytes, size_t size, Codec * codec)
+{
+    if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b)
+    {
+        *codec = Codec::Gzip;
+        return true;
+    }
+    if (size >= 3 && bytes[0] == 'B' && bytes[1] == 'Z' && bytes[2] == 'h')
+    {
+        *codec = Codec::Bzip2;
+        return true;
+    }
+    if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd)
+    {
+        *codec = Codec::Zstd;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Streaming decompression of gzip, bzip2 and zstd files behind the DataSource interface.
+ */
+
+#ifndef DECOMPRESSINGSOURCE_H_
+#define DECOMPRESSINGSOURCE_H_
+
+#include <memory>
+#include <string>
+
+#include "util/datasource.h"
+
+class PosixFile;
+
+/*! \brief Decompresses a file on a background thread while it is read.
+ *
+ * Decompressed data is handed over in a few recycled chunks, so memory use does not
+ * depend on the file size. Where the format marks independent parts with their sizes,
+ * the parts of a chunk are decompressed on all hardware threads: the blocks of BGZF
+ * gzip files, as written by bgzip, and zstd frames with known content size, as written
+ * by pzstd or zstd --block-size. Other gzip, bzip2 and zstd data, including concatenated
+ * members and streams, is decompressed by the background thread alone.
+ */
+class DecompressingSource : public DataSource
+{
+public:
+    enum class Codec
+    {
+        Gzip,
+        Bzip2,
+        Zstd
+    };
+
+    //! Start decompressing file; throws std::runtime_error if the program was built without support for codec.
+    DecompressingSource(std::unique_ptr<PosixFile> file, Codec codec);
+    ~DecompressingSource();
+
+    //! Read decompressed bytes; offset must not lie before the end of the previous read.
+    void readAt(void * buffer, size_t size, size_t offset) const override;
+    bool isSequential() const override { return true; }
+    size_t size() const override { return unknownSize; }
+    const std::string &filename() const override;
+
+    //! The codec whose magic number starts the given bytes; returns false for uncompressed data.
+    static bool detectCodec(const unsigned char * bytes, size_t size, Codec * codec);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif /* end of include guard: DECOMPRESSINGSOURCE_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "hash.h"
+
+#include <cstring>
+
+namespace
+{
+
+//! Odd multipliers with well-spread bits, from the finalizer of MurmurHash3.
+constexpr uint64_t multiplier1_c = 0xff51afd7ed558ccdULL;
+constexpr uint64_t multiplier2_c = 0xc4ceb9fe1a85ec53ULL;
+
+uint64_t mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= multiplier1_c;
+    value ^= value >> 33;
+    value *= multiplier2_c;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t rotate_left(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+}   // namespace
+
+uint64_t hashBytes(const void * data, size_t size, uint64_t seed)
+{
+    const unsigned char * bytes = static_cast<const unsigned char *>(data);
+    uint64_t              hash  = seed ^ (uint64_t(size) * multiplier2_c);
+    size_t                i     = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = rotate_left(hash ^ (word * multiplier1_c), 31) * multiplier2_c;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes + i, size - i);
+    hash ^= tail * multiplier1_c;
+    return mix(hash);
+}
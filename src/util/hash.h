@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Fast non-cryptographic hashing of byte buffers.
+ */
+
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/*! \brief A 64-bit hash of size bytes at data, continuing from seed.
+ *
+ * Mixes eight bytes per step, so hashing runs at memory speed. Detects accidental changes,
+ * not deliberate collisions. Passing the hash of one buffer as seed of the next hashes both in turn.
+ */
+uint64_t hashBytes(const void * data, size_t size, uint64_t seed = 0);
+
+#endif /* end of include guard: HASH_H_ */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "inputfiles.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <glob.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util/threadpool.h"
+
+namespace
+{
+
+bool is_directory(const std::string &path)
+{
+    struct stat status;
+    return stat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+bool exists(const std::string &path)
+{
+    struct stat status;
+    return stat(path.c_str(), &status) == 0;
+}
+
+//! True if the directory entry is a directory, without a stat call if the file system tells the type.
+bool entry_is_directory(const dirent &entry, const std::string &path)
+{
+    if (entry.d_type == DT_DIR)
+    {
+        return true;
+    }
+    if (entry.d_type == DT_REG)
+    {
+        return false;
+    }
+    // unknown types and symbolic links
+    return is_directory(path);
+}
+
+//! Rank of a path character, with the separator before all others.
+int path_rank(char c)
+{
+    return c == '/' ? 0 : int(static_cast<unsigned char>(c)) + 1;
+}
+
+//! Order of a sorted depth-first walk, e.g. a/b/c before a/b.mrc.
+bool depth_first_less(const std::string &a, const std::string &b)
+{
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                        [](char x, char y) { return path_rank(x) < path_rank(y); });
+}
+
+//! Collects the accepted files of a directory tree, with one task per directory.
+class DirectoryWalk
+{
+    public:
+        DirectoryWalk(const std::function<bool(const std::string &)> &accept, size_t numThreads) :
+            accept_(accept), pool_(numThreads) {}
+
+        //! Walk a directory tree and return the accepted files in the order of a sorted depth-first walk.
+        std::vector<std::string> walk_(const std::string &directory);
+
+    private:
+        void walk_directory_(const std::string &directory);
+
+        const std::function<bool(const std::string &)> &accept_;
+        ThreadPool               pool_;
+        std::mutex               filesMutex_;
+        std::vector<std::string> files_;
+};
+
+std::vector<std::string> DirectoryWalk::walk_(const std::string &directory)
+{
+    files_.clear();
+    pool_.submit([this, directory] { walk_directory_(directory); });
+    pool_.wait();
+    std::sort(files_.begin(), files_.end(), depth_first_less);
+    return std::move(files_);
+}
+
+void DirectoryWalk::walk_directory_(const std::string &directory)
+{
+    DIR * dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        throw std::runtime_error("Cannot read directory \"" + directory + "\".");
+    }
+    std::vector<std::string> accepted;
+    while (const dirent * entry = readdir(dir))
+    {
+        const std::string name(entry->d_name);
+        if (name == "." || name == "..")
+        {
+            continue;
+        }
+        const std::string path = directory + "/" + name;
+        if (entry_is_directory(*entry, path))
+        {
+            pool_.submit([this, path] { walk_directory_(path); });
+        }
+        else if (accept_(path))
+        {
+            accepted.push_back(path);
+        }
+    }
+    closedir(dir);
+
+    std::lock_guard<std::mutex> lock(filesMutex_);
+    files_.insert(files_.end(), accepted.begin(), accepted.end());
+}
+
+}   // namespace
+
+std::vector<std::string> findInputFiles(const std::vector<std::string> &arguments,
+                                        const std::function<bool(const std::string &)> &accept, size_t numThreads)
+{
+    std::vector<std::string>       files;
+    std::unique_ptr<DirectoryWalk> walk;
+    for (const std::string &argument : arguments)
+    {
+        if (is_directory(argument))
+        {
+            if (!walk)
+            {
+                walk.reset(new DirectoryWalk(accept, numThreads));
+            }
+            const std::vector<std::string> found = walk->walk_(argument);
+            files.insert(files.end(), found.begin(), found.end());
+        }
+        else if (exists(argument))
+        {
+            files.push_back(argument);
+        }
+        else if (argument.find_first_of("*?[") != std::string::npos)
+        {
+            glob_t matches;
+            if (glob(argument.c_str(), 0, nullptr, &matches) == 0)
+            {
+                for (size_t i = 0; i < matches.gl_pathc; ++i)
+                {
+                    const std::string match(matches.gl_pathv[i]);
+                    if (!is_directory(match) && accept(match))
+                    {
+                        files.push_back(match);
+                    }
+                }
+            }
+            globfree(&matches);
+        }
+        else
+        {
+            throw std::runtime_error("No such file or directory \"" + argument + "\".");
+        }
+    }
+    return files;
+}
+
+std::string absolutePath(const std::string &path)
+{
+    if (path.empty() || path[0] == '/')
+    {
+        return path;
+    }
+    char directory[4096];
+    if (getcwd(directory, sizeof(directory)) == nullptr)
+    {
+        throw std::runtime_error(std::string("Cannot determine the working directory: ") + std::strerror(errno));
+    }
+    return std::string(directory) + "/" + path;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Expansion of command line arguments to lists of input files.
+ */
+
+#ifndef INPUTFILES_H_
+#define INPUTFILES_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*! \brief Expand files, directories and glob patterns to a list of files.
+ *
+ * Plain files are taken as they are. Directories are walked recursively and
+ * glob patterns (e.g. "maps/emd_*.map", quoted to keep the shell from expanding them)
+ * are matched; from both, only files for which accept returns true are kept.
+ * Files are listed in the order of the arguments, directory entries sorted by name.
+ * Directories are read on numThreads threads, one task per directory, so walking large
+ * trees on network file systems overlaps the metadata requests; accept must be thread-safe.
+ * \param[in] numThreads number of threads walking directories, zero for all hardware threads
+ * \throws std::runtime_error if an argument is neither an existing path nor a glob pattern,
+ * or a directory cannot be read
+ */
+std::vector<std::string> findInputFiles(const std::vector<std::string> &arguments,
+                                        const std::function<bool(const std::string &)> &accept, size_t numThreads = 1);
+
+//! The path as seen from any working directory: relative paths are prefixed with the current one.
+std::string absolutePath(const std::string &path);
+
+#endif /* end of include guard: INPUTFILES_H_ */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Formatting of values for lines of JSON.
+ */
+
+#ifndef JSON_H_
+#define JSON_H_
+
+#include <string>
+
+/*! \brief A quoted JSON string.
+ *
+ * Escapes quotes, backslashes and control characters. Bytes above 127 are escaped as
+ * the Latin-1 characters they encode, so arbitrary bytes, e.g. of mrc labels, give valid JSON.
+ */
+std::string jsonString(const std::string & text);
+
+//! A JSON number with up to 9 significant digits, or null if value is not finite.
+std::string jsonNumber(double value);
+
+#endif /* end of include guard: JSON_H_ */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "util/threadpool.h"
+
+namespace
+{
+
+//! Budget of the innermost ThreadBudgetScope of the calling thread, zero for none.
+thread_local size_t currentBudget = 0;
+
+//! The indices of a parallelFor() call, shared with the pool tasks that help with them.
+struct ParallelLoop
+{
+    ParallelLoop(size_t numIndices, const std::function<void(size_t)> &loopBody) :
+        count(numIndices), budget(threadBudget()), body(&loopBody), next(0), finished(0), failed(false) {}
+
+    //! Run indices until none are left; after the first error the remaining ones are only counted.
+    void work()
+    {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            if (!failed)
+            {
+                try
+                {
+                    (*body)(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+            if (++finished == count)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                allFinished.notify_all();
+            }
+        }
+    }
+
+    const size_t                         count;
+    const size_t                         budget; //!< of the caller, for loops nested in body
+    //! valid until all indices are finished, which is before any helper can claim an index past count
+    const std::function<void(size_t)>  * body;
+    std::atomic<size_t>                  next;
+    std::atomic<size_t>                  finished;
+    std::atomic<bool>                    failed;
+    std::mutex                           mutex;
+    std::condition_variable              allFinished;
+    std::exception_ptr                   error;
+};
+
+//! Workers for parallelFor() calls from threads that belong to no pool.
+ThreadPool &shared_pool()
+{
+    static ThreadPool pool(hardwareThreads());
+    return pool;
+}
+
+}   // namespace
+
+size_t hardwareThreads()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+size_t threadBudget()
+{
+    return currentBudget > 0 ? currentBudget : hardwareThreads();
+}
+
+ThreadBudgetScope::ThreadBudgetScope(size_t numThreads) : previous_(currentBudget)
+{
+    if (numThreads > 0)
+    {
+        currentBudget = numThreads;
+    }
+}
+
+ThreadBudgetScope::~ThreadBudgetScope()
+{
+    currentBudget = previous_;
+}
+
+void parallelFor(size_t count, const std::function<void(size_t)> &body, size_t numThreads)
+{
+    if (numThreads == 0)
+    {
+        numThreads = threadBudget();
+    }
+    numThreads = std::min(numThreads, count);
+    if (numThreads <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    // helpers queued on the pool of the calling worker are stolen by idle workers of the same pool,
+    // so loops inside pool tasks share its threads instead of starting threads of their own
+    std::shared_ptr<ParallelLoop> loop = std::make_shared<ParallelLoop>(count, body);
+    ThreadPool                   *pool = ThreadPool::current();
+    if (pool == nullptr)
+    {
+        pool = &shared_pool();
+    }
+    for (size_t t = 1; t < numThreads; ++t)
+    {
+        pool->submit([loop] {
+                         ThreadBudgetScope scope(loop->budget);
+                         loop->work();
+                     });
+    }
+    // the calling thread works too, and finishes alone if all workers are busy, so waiting cannot deadlock
+    loop->work();
+    {
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->allFinished.wait(lock, [&loop] { return loop->finished == loop->count; });
+    }
+    if (loop->error)
+    {
+        std::rethrow_exception(loop->error);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Simple fork-join parallelism over index ranges.
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+//! Number of threads the hardware runs concurrently, at least one.
+size_t hardwareThreads();
+
+/*! \brief Threads of a parallelFor() on the calling thread that asks for all threads.
+ *
+ * The budget of the innermost ThreadBudgetScope, otherwise hardwareThreads().
+ */
+size_t threadBudget();
+
+/*! \brief Limits the threads of the parallel loops of the calling thread while in scope.
+ *
+ * Lets concurrent conversions share the hardware threads, e.g. the files of a batch.
+ * The tasks of a parallelFor() run with the budget of its caller, so nested loops stay within it too.
+ */
+class ThreadBudgetScope
+{
+public:
+    //! \param[in] numThreads threads of each loop, zero to keep the current budget
+    explicit ThreadBudgetScope(size_t numThreads);
+    ~ThreadBudgetScope();
+    ThreadBudgetScope(const ThreadBudgetScope &)            = delete;
+    ThreadBudgetScope &operator=(const ThreadBudgetScope &) = delete;
+
+private:
+    size_t previous_;
+};
+
+/*! \brief Call body(i) for all i in [0, count) on up to numThreads threads.
+ *
+ * The calling thread and up to numThreads - 1 tasks of a ThreadPool pick the next index from a
+ * shared counter, so uneven work balances out. The tasks go to the pool of the calling thread if
+ * it is a pool worker, otherwise to a pool shared by the process, so no threads are started per call
+ * and loops nested in pool tasks do not multiply the threads.
+ * Returns when all calls have finished and rethrows the first exception thrown by body.
+ * \param[in] numThreads number of threads to use, zero for threadBudget()
+ */
+void parallelFor(size_t count, const std::function<void(size_t)> &body, size_t numThreads = 0);
+
+#endif /* end of include guard: PARALLEL_H_ */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "posixfile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "util/stagereport.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+
+//! Bytes read and written at once when the kernel cannot copy between files.
+constexpr size_t copyBufferBytes_c = 32 << 20;
+
+}   // namespace
+
+PosixFile::PosixFile(const std::string & filename, Mode mode) : filename_(filename), fd_(-1), writeOffset_(0)
+{
+    if (mode == Mode::Read)
+    {
+        fd_ = open(filename.c_str(), O_RDONLY);
+    }
+    else if (mode == Mode::Update)
+    {
+        fd_ = open(filename.c_str(), O_RDWR);
+    }
+    else
+    {
+        fd_ = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    countSystemCalls();
+    if (fd_ < 0)
+    {
+        throw std::runtime_error("Cannot open \"" + filename + "\": " + std::strerror(errno));
+    }
+}
+
+PosixFile::~PosixFile()
+{
+    if (fd_ >= 0)
+    {
+        close(fd_);
+        countSystemCalls();
+    }
+}
+
+size_t PosixFile::size() const
+{
+    struct stat status;
+    countSystemCalls();
+    if (fstat(fd_, &status) != 0)
+    {
+        throw std::runtime_error("Cannot determine size of \"" + filename_ + "\": " + std::strerror(errno));
+    }
+    return status.st_size;
+}
+
+void PosixFile::readAt(void * buffer, size_t size, size_t offset) const
+{
+    if (readAtMost(buffer, size, offset) != size)
+    {
+        throw std::runtime_error("Unexpected end of file in \"" + filename_ + "\".");
+    }
+}
+
+size_t PosixFile::readAtMost(void * buffer, size_t size, size_t offset) const
+{
+    char * destination = static_cast<char *>(buffer);
+    size_t total       = 0;
+    while (total < size)
+    {
+        const ssize_t numRead = pread(fd_, destination + total, size - total, offset + total);
+        countSystemCalls();
+        if (numRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (numRead < 0)
+        {
+            throw std::runtime_error("Cannot read from \"" + filename_ + "\": " + std::strerror(errno));
+        }
+        if (numRead == 0)
+        {
+            break;
+        }
+        total += numRead;
+    }
+    return total;
+}
+
+void PosixFile::writeAt(const void * buffer, size_t size, size_t offset) const
+{
+    const char * source = static_cast<const char *>(buffer);
+    while (size > 0)
+    {
+        const ssize_t numWritten = pwrite(fd_, source, size, offset);
+        countSystemCalls();
+        if (numWritten < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (numWritten < 0)
+        {
+            throw std::runtime_error("Cannot write to \"" + filename_ + "\": " + std::strerror(errno));
+        }
+        source += numWritten;
+        offset += numWritten;
+        size   -= numWritten;
+    }
+}
+
+void PosixFile::write(const void * buffer, size_t size)
+{
+    writeAt(buffer, size, writeOffset_);
+    writeOffset_ += size;
+}
+
+void PosixFile::copyFrom(const PosixFile &source, size_t sourceOffset, size_t size)
+{
+#ifdef __linux__
+    while (size > 0)
+    {
+        loff_t        input     = sourceOffset;
+        loff_t        output    = writeOffset_;
+        const ssize_t numCopied = copy_file_range(source.fd_, &input, fd_, &output, size, 0);
+        countSystemCalls();
+        if (numCopied < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (numCopied < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP))
+        {
+            // e.g. old kernels, or files on different kinds of file systems
+            break;
+        }
+        if (numCopied < 0)
+        {
+            throw std::runtime_error("Cannot copy from \"" + source.filename_ + "\" to \"" + filename_ + "\": " + std::strerror(errno));
+        }
+        if (numCopied == 0)
+        {
+            throw std::runtime_error("Unexpected end of file in \"" + source.filename_ + "\".");
+        }
+        sourceOffset += numCopied;
+        writeOffset_ += numCopied;
+        size         -= numCopied;
+    }
+#endif
+    std::vector<char> buffer(std::min<size_t>(size, copyBufferBytes_c));
+    while (size > 0)
+    {
+        const size_t count = std::min(size, buffer.size());
+        source.readAt(buffer.data(), count, sourceOffset);
+        write(buffer.data(), count);
+        sourceOffset += count;
+        size         -= count;
+    }
+}
+
+void PosixFile::resize(size_t size) const
+{
+    countSystemCalls();
+    if (ftruncate(fd_, size) != 0)
+    {
+        throw std::runtime_error("Cannot resize \"" + filename_ + "\": " + std::strerror(errno));
+    }
+}
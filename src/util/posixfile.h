@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Thin owning wrapper around a POSIX file descriptor.
+ */
+
+#ifndef POSIXFILE_H_
+#define POSIXFILE_H_
+
+#include <cstddef>
+#include <string>
+
+#include "util/datasource.h"
+
+/*! \brief Owns a file descriptor and performs complete, positioned reads and writes.
+ *
+ * Short reads and writes are continued until all bytes are transferred.
+ * Failures throw std::runtime_error naming the file.
+ */
+class PosixFile : public DataSource
+{
+public:
+    enum class Mode
+    {
+        Read,  //!< open an existing file read-only
+        Write, //!< create or truncate a file for writing
+        Update //!< open an existing file for reading and writing in place
+    };
+    PosixFile(const std::string & filename, Mode mode);
+    ~PosixFile();
+    PosixFile(const PosixFile &)            = delete;
+    PosixFile &operator=(const PosixFile &) = delete;
+
+    //! Size of the file in bytes.
+    size_t size() const override;
+    //! Read exactly size bytes at offset; throws if the file ends before.
+    void readAt(void * buffer, size_t size, size_t offset) const override;
+    //! Read up to size bytes at offset; returns fewer only at the end of the file.
+    size_t readAtMost(void * buffer, size_t size, size_t offset) const;
+    //! Files allow reading at any offset.
+    bool isSequential() const override { return false; }
+    //! Write size bytes at offset.
+    void writeAt(const void * buffer, size_t size, size_t offset) const;
+    //! Append size bytes at the current end of the written data.
+    void write(const void * buffer, size_t size);
+    /*! \brief Append size bytes of source, starting at sourceOffset, at the current end of the written data.
+     *
+     * The kernel copies the bytes with copy_file_range() where available, which shares the extents
+     * of both files on file systems with reflinks if the offsets are aligned to their blocks.
+     * Falls back to reading and writing through a buffer.
+     */
+    void copyFrom(const PosixFile &source, size_t sourceOffset, size_t size);
+    //! Set the file size, e.g. before writing parts of it concurrently with writeAt().
+    void resize(size_t size) const;
+
+    int descriptor() const { return fd_; }
+    const std::string &filename() const override { return filename_; }
+
+private:
+    std::string filename_;
+    int         fd_;
+    size_t      writeOffset_;
+};
+
+#endif /* end of include guard: POSIXFILE_H_ */
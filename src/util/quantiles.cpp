@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "quantiles.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "util/parallel.h"
+
+namespace
+{
+
+//! Values other than float are converted in blocks that stay in the first level cache.
+constexpr size_t blockValues_c = 4096;
+
+//! Bits of the float representation that are dropped from the bin index.
+constexpr int droppedBits_c = 23 - QuantileHistogram::mantissaBits_c;
+
+//! Bits of a float, reordered so that unsigned comparison orders them like the values.
+uint32_t ordered_bits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+float from_ordered_bits(uint32_t ordered)
+{
+    const uint32_t bits = (ordered & 0x80000000u) ? (ordered & 0x7FFFFFFFu) : ~ordered;
+    float          value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+}   // namespace
+
+QuantileHistogram::QuantileHistogram() :
+    bins_(size_t(1) << (32 - droppedBits_c), 0), count_(0),
+    min_(std::numeric_limits<float>::infinity()), max_(-std::numeric_limits<float>::infinity())
+{
+}
+
+void QuantileHistogram::add(const void * values, DataFormat format, size_t count)
+{
+    if (format == DataFormat::FLOAT32)
+    {
+        add(static_cast<const float *>(values), count);
+        return;
+    }
+    const char * bytes = static_cast<const char *>(values);
+    float        block[blockValues_c];
+    for (size_t first = 0; first < count; first += blockValues_c)
+    {
+        const size_t blockCount = std::min(blockValues_c, count - first);
+        toFloat(bytes + first * formatBytes(format), format, block, blockCount);
+        add(block, blockCount);
+    }
+}
+
+void QuantileHistogram::add(const float * values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float value = values[i];
+        // infinity and NaN compare false to the finite limits
+        if (!(value >= -std::numeric_limits<float>::max() && value <= std::numeric_limits<float>::max()))
+        {
+            continue;
+        }
+        ++bins_[ordered_bits(value) >> droppedBits_c];
+        ++count_;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+}
+
+void QuantileHistogram::merge(const QuantileHistogram &other)
+{
+    for (size_t i = 0; i < bins_.size(); ++i)
+    {
+        bins_[i] += other.bins_[i];
+    }
+    count_ += other.count_;
+    min_    = std::min(min_, other.min_);
+    max_    = std::max(max_, other.max_);
+}
+
+double QuantileHistogram::quantile(double fraction) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    const double target = std::min(std::max(fraction, 0.0), 1.0) * double(count_);
+    double       below  = 0;
+    for (size_t i = 0; i < bins_.size(); ++i)
+    {
+        if (bins_[i] != 0 && below + double(bins_[i]) >= target)
+        {
+            // values are assumed to spread evenly over the bin
+            const double lower = from_ordered_bits(uint32_t(i) << droppedBits_c);
+            const double upper = from_ordered_bits(((uint32_t(i) + 1) << droppedBits_c) - 1);
+            const double value = lower + (upper - lower) * (target - below) / double(bins_[i]);
+            return std::min(std::max(value, double(min_)), double(max_));
+        }
+        below += double(bins_[i]);
+    }
+    return max_;
+}
+
+QuantileHistogram computeQuantiles(const void * values, DataFormat format, size_t count, size_t numThreads)
+{
+    // one histogram per thread, as histograms are large
+    const size_t                   numParts = std::max<size_t>(std::min(numThreads == 0 ? threadBudget() : numThreads, count), 1);
+    const char                   * bytes    = static_cast<const char *>(values);
+    std::vector<QuantileHistogram> partial(numParts);
+    parallelFor(numParts, [&](size_t part) {
+            const size_t first = count * part / numParts;
+            const size_t last  = count * (part + 1) / numParts;
+            partial[part].add(bytes + first * formatBytes(format), format, last - first);
+        }, numThreads);
+
+    QuantileHistogram result;
+    for (const QuantileHistogram &part : partial)
+    {
+        result.merge(part);
+    }
+    return result;
+}
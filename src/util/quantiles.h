@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Approximate quantiles of large numbers of values in a single pass.
+ */
+
+#ifndef QUANTILES_H_
+#define QUANTILES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "util/dataformat.h"
+
+/*! \brief Counts values seen in any order in bins that are narrow relative to the values they hold.
+ *
+ * A value's bin is given by the sign, exponent and leading mantissaBits_c mantissa bits of
+ * its float representation, so quantiles are accurate to 2^-mantissaBits_c of their magnitude,
+ * no matter how far outliers lie. Values that are not finite are ignored.
+ */
+class QuantileHistogram
+{
+public:
+    static const int mantissaBits_c = 7;
+
+    QuantileHistogram();
+
+    //! Count count native-endian values of the given format.
+    void add(const void * values, DataFormat format, size_t count);
+    //! Count count float values.
+    void add(const float * values, size_t count);
+    //! Count the values seen by other.
+    void merge(const QuantileHistogram &other);
+
+    //! Number of finite values seen.
+    uint64_t count() const { return count_; }
+    /*! \brief Value below which the given fraction of the finite values lie, e.g. 0.5 for the median.
+     *
+     * Interpolated linearly within a bin; zero if no finite values were seen.
+     */
+    double quantile(double fraction) const;
+
+private:
+    std::vector<uint64_t> bins_;
+    uint64_t              count_;
+    float                 min_;
+    float                 max_;
+};
+
+/*! \brief Quantile histogram of count values of the given format, counted in parallel.
+ *
+ * \param[in] numThreads number of threads to use, zero for threadBudget()
+ */
+QuantileHistogram computeQuantiles(const void * values, DataFormat format, size_t count, size_t numThreads = 0);
+
+#endif /* end of include guard: QUANTILES_H_ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "quantize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "util/parallel.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define QUANTIZE_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+//! Values other than float are converted in blocks that stay in the first level cache.
+constexpr size_t blockValues_c = 4096;
+
+//! Values per task when quantizing in parallel.
+constexpr size_t chunkValues_c = 1 << 20;
+
+//! Parameters of the kernels, (value - lower) * factor + 0.5 truncates to the nearest stored value.
+struct Mapping
+{
+    float lower;
+    float factor;
+    float maxStored;
+};
+
+template <typename T>
+void quantize_scalar(const float * values, size_t count, const Mapping &mapping, T * result)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        float stored = (values[i] - mapping.lower) * mapping.factor + 0.5f;
+        // comparisons with NaN are false, so NaN ends up as zero
+        stored    = stored > 0 ? stored : 0;
+        stored    = stored < mapping.maxStored ? stored : mapping.maxStored;
+        result[i] = T(stored);
+    }
+}
+
+#ifdef QUANTIZE_HAVE_X86_SIMD
+
+//! Eight values to stored values in 32 bit lanes; max returns its second operand for NaN.
+__attribute__((target("avx2")))
+inline __m256i quantize_eight(const float * values, __m256 lower, __m256 factor, __m256 half, __m256 maxStored)
+{
+    const __m256 stored = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(values), lower), factor), half);
+    return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(stored, _mm256_setzero_ps()), maxStored));
+}
+
+__attribute__((target("avx2")))
+void quantize_uint8_avx2(const float * values, size_t count, const Mapping &mapping, uint8_t * result)
+{
+    const __m256  lower     = _mm256_set1_ps(mapping.lower);
+    const __m256  factor    = _mm256_set1_ps(mapping.factor);
+    const __m256  half      = _mm256_set1_ps(0.5f);
+    const __m256  maxStored = _mm256_set1_ps(mapping.maxStored);
+    // packing interleaves the 128 bit lanes, this permutation restores the order
+    const __m256i order     = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t        i         = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i a     = quantize_eight(values + i, lower, factor, half, maxStored);
+        const __m256i b     = quantize_eight(values + i + 8, lower, factor, half, maxStored);
+        const __m256i c     = quantize_eight(values + i + 16, lower, factor, half, maxStored);
+        const __m256i d     = quantize_eight(values + i + 24, lower, factor, half, maxStored);
+        const __m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), _mm256_permutevar8x32_epi32(bytes, order));
+    }
+    quantize_scalar(values + i, count - i, mapping, result + i);
+}
+
+__attribute__((target("avx2")))
+void quantize_uint16_avx2(const float * values, size_t count, const Mapping &mapping, uint16_t * result)
+{
+    const __m256 lower     = _mm256_set1_ps(mapping.lower);
+    const __m256 factor    = _mm256_set1_ps(mapping.factor);
+    const __m256 half      = _mm256_set1_ps(0.5f);
+    const __m256 maxStored = _mm256_set1_ps(mapping.maxStored);
+    size_t       i         = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i a     = quantize_eight(values + i, lower, factor, half, maxStored);
+        const __m256i b     = quantize_eight(values + i + 8, lower, factor, half, maxStored);
+        const __m256i words = _mm256_packus_epi32(a, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), _mm256_permute4x64_epi64(words, 0xD8));
+    }
+    quantize_scalar(values + i, count - i, mapping, result + i);
+}
+
+#endif
+
+typedef void (*Uint8Kernel)(const float *, size_t, const Mapping &, uint8_t *);
+typedef void (*Uint16Kernel)(const float *, size_t, const Mapping &, uint16_t *);
+
+Uint8Kernel select_uint8_kernel()
+{
+#ifdef QUANTIZE_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return &quantize_uint8_avx2;
+    }
+#endif
+    return &quantize_scalar<uint8_t>;
+}
+
+Uint16Kernel select_uint16_kernel()
+{
+#ifdef QUANTIZE_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return &quantize_uint16_avx2;
+    }
+#endif
+    return &quantize_scalar<uint16_t>;
+}
+
+void quantize_floats(const float * values, size_t count, const Mapping &mapping, DataFormat format, void * result)
+{
+    static const Uint8Kernel  uint8Kernel  = select_uint8_kernel();
+    static const Uint16Kernel uint16Kernel = select_uint16_kernel();
+    if (format == DataFormat::UINT8)
+    {
+        uint8Kernel(values, count, mapping, static_cast<uint8_t *>(result));
+    }
+    else
+    {
+        uint16Kernel(values, count, mapping, static_cast<uint16_t *>(result));
+    }
+}
+
+void quantize_chunk(const char * values, DataFormat format, const Mapping &mapping, DataFormat target, char * result, size_t count)
+{
+    if (format == DataFormat::FLOAT32)
+    {
+        quantize_floats(reinterpret_cast<const float *>(values), count, mapping, target, result);
+        return;
+    }
+    float block[blockValues_c];
+    for (size_t first = 0; first < count; first += blockValues_c)
+    {
+        const size_t blockCount = std::min(blockValues_c, count - first);
+        toFloat(values + first * formatBytes(format), format, block, blockCount);
+        quantize_floats(block, blockCount, mapping, target, result + first * formatBytes(target));
+    }
+}
+
+}   // namespace
+
+Quantization::Quantization(DataFormat format, double lower, double upper) : format_(format), lower_(lower), upper_(upper)
+{
+    if (format != DataFormat::UINT8 && format != DataFormat::UINT16)
+    {
+        throw std::invalid_argument(std::string("Cannot quantize to ") + formatName(format) + ", only to UINT8 or UINT16.");
+    }
+    if (!std::isfinite(lower) || !std::isfinite(upper))
+    {
+        throw std::invalid_argument("The range of quantized values must be finite.");
+    }
+    upper_ = std::max(lower_, upper_);
+}
+
+unsigned Quantization::maxStored() const
+{
+    return format_ == DataFormat::UINT8 ? 0xFF : 0xFFFF;
+}
+
+double Quantization::scale() const
+{
+    return (upper_ - lower_) / maxStored();
+}
+
+void quantize(const void * values, DataFormat format, const Quantization &quantization, void * result, size_t count,
+              size_t numThreads)
+{
+    // a range of a single value stores everything as zero
+    const double range   = quantization.upper() - quantization.lower();
+    const Mapping mapping = { float(quantization.lower()), range > 0 ? float(quantization.maxStored() / range) : 0.0f,
+                              float(quantization.maxStored()) };
+    const char  * input     = static_cast<const char *>(values);
+    char        * output    = static_cast<char *>(result);
+    const size_t  numChunks = (count + chunkValues_c - 1) / chunkValues_c;
+    parallelFor(numChunks, [&](size_t chunk) {
+            const size_t first = chunk * chunkValues_c;
+            quantize_chunk(input + first * formatBytes(format), format, mapping, quantization.format(),
+                           output + first * formatBytes(quantization.format()), std::min(chunkValues_c, count - first));
+        }, numThreads);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Linear quantization of voxel values to unsigned integers.
+ */
+
+#ifndef QUANTIZE_H_
+#define QUANTIZE_H_
+
+#include <cstddef>
+
+#include "util/dataformat.h"
+
+/*! \brief Maps values in [lower, upper] linearly to the whole range of an unsigned integer format.
+ *
+ * A stored value q stands for offset() + q * scale(). Values outside the range clamp
+ * to its ends; NaN is stored as zero.
+ */
+class Quantization
+{
+public:
+    /*! \brief Quantize [lower, upper] to format.
+     *
+     * \throws std::invalid_argument if format is not UINT8 or UINT16, or the range is not finite
+     */
+    Quantization(DataFormat format, double lower, double upper);
+
+    DataFormat format() const { return format_; }
+    double lower() const { return lower_; }
+    double upper() const { return upper_; }
+    //! Largest stored value.
+    unsigned maxStored() const;
+    //! Value step between consecutive stored values.
+    double scale() const;
+    //! Value of stored zero.
+    double offset() const { return lower_; }
+
+private:
+    DataFormat format_;
+    double     lower_;
+    double     upper_;
+};
+
+/*! \brief Quantize count native-endian values of the given format, rounding to the nearest stored value.
+ *
+ * \param[in] numThreads number of threads to use, zero for threadBudget()
+ */
+void quantize(const void * values, DataFormat format, const Quantization &quantization, void * result, size_t count,
+              size_t numThreads = 0);
+
+#endif /* end of include guard: QUANTIZE_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "stagereport.h"
+
+#include <sstream>
+
+#include <sys/resource.h>
+
+#include "util/json.h"
+
+namespace
+{
+
+thread_local StageReport * currentReport = nullptr;
+
+const char * stage_name(size_t stage)
+{
+    static const char * names[] = {"open", "header", "read", "decode", "reorder", "statistics", "quantize", "write", "derived"};
+    return names[stage];
+}
+
+//! Peak resident set size of the process in KiB, zero if unknown.
+long peak_rss_kib()
+{
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : 0;
+}
+
+}   // namespace
+
+/*******************************************************************************
+ * StageReport
+ */
+
+StageReport::StageReport() : systemCalls_(0), start_(std::chrono::steady_clock::now())
+{
+    for (size_t stage = 0; stage < numStages_c; ++stage)
+    {
+        nanoseconds_[stage] = 0;
+        bytes_[stage]       = 0;
+    }
+}
+
+void StageReport::add(Stage stage, std::chrono::nanoseconds duration, uint64_t bytes)
+{
+    nanoseconds_[size_t(stage)] += duration.count();
+    bytes_[size_t(stage)]       += bytes;
+}
+
+void StageReport::addSystemCalls(uint64_t count)
+{
+    systemCalls_ += count;
+}
+
+double StageReport::seconds(Stage stage) const
+{
+    return nanoseconds_[size_t(stage)] * 1e-9;
+}
+
+uint64_t StageReport::bytes(Stage stage) const
+{
+    return bytes_[size_t(stage)];
+}
+
+uint64_t StageReport::systemCalls() const
+{
+    return systemCalls_;
+}
+
+double StageReport::elapsedSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+}
+
+std::string StageReport::json(const std::string & filename) const
+{
+    std::ostringstream text;
+    text << "{\"file\":" << jsonString(filename) << ",\"elapsed_s\":" << elapsedSeconds()
+         << ",\"peak_rss_kib\":" << peak_rss_kib() << ",\"syscalls\":" << systemCalls() << ",\"stages\":{";
+    for (size_t stage = 0; stage < numStages_c; ++stage)
+    {
+        const double   stageSeconds = seconds(Stage(stage));
+        const uint64_t stageBytes   = bytes(Stage(stage));
+        text << (stage > 0 ? "," : "") << "\"" << stage_name(stage) << "\":{\"s\":" << stageSeconds
+             << ",\"bytes\":" << stageBytes << ",\"mb_per_s\":" << (stageSeconds > 0 ? stageBytes / stageSeconds * 1e-6 : 0) << "}";
+    }
+    text << "}}";
+    return text.str();
+}
+
+StageReport * StageReport::current()
+{
+    return currentReport;
+}
+
+/*******************************************************************************
+ * ReportScope
+ */
+
+ReportScope::ReportScope(StageReport * report) : previous_(currentReport)
+{
+    currentReport = report;
+}
+
+ReportScope::~ReportScope()
+{
+    currentReport = previous_;
+}
+
+/*******************************************************************************
+ * ScopedStage
+ */
+
+ScopedStage::ScopedStage(Stage stage, uint64_t bytes) : report_(currentReport), stage_(stage), bytes_(bytes)
+{
+    if (report_ != nullptr)
+    {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedStage::~ScopedStage()
+{
+    if (report_ != nullptr)
+    {
+        report_->add(stage_, std::chrono::steady_clock::now() - start_, bytes_);
+    }
+}
+
+void countSystemCalls(uint64_t count)
+{
+    if (currentReport != nullptr)
+    {
+        currentReport->addSystemCalls(count);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Durations, bytes and system calls of the stages of a conversion.
+ */
+
+#ifndef STAGEREPORT_H_
+#define STAGEREPORT_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//! The stages a conversion spends its time in.
+enum class Stage
+{
+    Open,       //!< opening the input file and reading its first bytes
+    Header,     //!< reading and parsing the mrc header
+    Read,       //!< reading or mapping voxel data
+    Decode,     //!< swapping bytes and widening values
+    Reorder,    //!< reordering axes to x, y, z
+    Statistics, //!< measuring value statistics
+    Quantize,   //!< quantizing values to integers
+    Write,      //!< writing the raw and dat files
+    Derived     //!< building pyramid levels and bricks
+};
+
+/*! \brief Collects how long each stage of converting one file takes and how many bytes it moves.
+ *
+ * Stages record into the report that is current on their thread, see ReportScope, so
+ * threads working on the same file share one report. Stages that overlap on different
+ * threads, e.g. reading and writing while streaming, each count their full duration,
+ * so the stage durations may add up to more than the elapsed time.
+ */
+class StageReport
+{
+public:
+    StageReport();
+    StageReport(const StageReport &)            = delete;
+    StageReport &operator=(const StageReport &) = delete;
+
+    void add(Stage stage, std::chrono::nanoseconds duration, uint64_t bytes);
+    void addSystemCalls(uint64_t count);
+
+    double seconds(Stage stage) const;
+    uint64_t bytes(Stage stage) const;
+    //! Number of system calls that opened, sized, read, wrote, mapped or closed files.
+    uint64_t systemCalls() const;
+    //! Seconds since the report was created.
+    double elapsedSeconds() const;
+
+    /*! \brief The report as a single line of JSON.
+     *
+     * Lists duration, bytes and MB/s per stage, the elapsed time, the system calls and
+     * the peak resident set size of the process so far.
+     */
+    std::string json(const std::string & filename) const;
+
+    //! The report stages on the calling thread record into, nullptr if there is none.
+    static StageReport * current();
+
+private:
+    static constexpr size_t numStages_c = size_t(Stage::Derived) + 1;
+    std::array<std::atomic<uint64_t>, numStages_c> nanoseconds_;
+    std::array<std::atomic<uint64_t>, numStages_c> bytes_;
+    std::atomic<uint64_t>                          systemCalls_;
+    std::chrono::steady_clock::time_point          start_;
+};
+
+/*! \brief Makes a report current on the calling thread while in scope.
+ *
+ * Threads that work for a file, e.g. those of a streaming pipeline, open a scope with
+ * the report that was current where they were started. A null report records nothing.
+ */
+class ReportScope
+{
+public:
+    explicit ReportScope(StageReport * report);
+    ~ReportScope();
+    ReportScope(const ReportScope &)            = delete;
+    ReportScope &operator=(const ReportScope &) = delete;
+
+private:
+    StageReport * previous_;
+};
+
+/*! \brief Times a stage from construction to destruction for the current report.
+ *
+ * Costs a single thread-local lookup when no report is current.
+ */
+class ScopedStage
+{
+public:
+    explicit ScopedStage(Stage stage, uint64_t bytes = 0);
+    ~ScopedStage();
+    ScopedStage(const ScopedStage &)            = delete;
+    ScopedStage &operator=(const ScopedStage &) = delete;
+
+    //! Count bytes moved by the stage in addition to the ones given on construction.
+    void addBytes(uint64_t bytes) { bytes_ += bytes; }
+
+private:
+    StageReport                         * report_;
+    Stage                                 stage_;
+    uint64_t                              bytes_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+//! Count file system calls for the current report, if any.
+void countSystemCalls(uint64_t count = 1);
+
+#endif /* end of include guard: STAGEREPORT_H_ */
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ */
+#include "threadpool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util/parallel.h"
+
+/*******************************************************************************
+ * ThreadPool::Impl
+ */
+class ThreadPool::Impl
+{
+    public:
+        explicit Impl(size_t numThreads);
+        ~Impl();
+
+        struct Worker
+        {
+            std::mutex       mutex;
+            std::deque<Task> tasks;
+        };
+
+        void work_(size_t self);
+        bool pop_own_(size_t self, Task * task);
+        bool steal_(size_t self, Task * task);
+        void push_(size_t worker, Task task);
+        void finish_task_();
+
+        std::vector<std::unique_ptr<Worker> > workers_;
+        std::vector<std::thread>              threads_;
+
+        //! tasks sitting in some deque, guarded by sleepMutex_ when incremented
+        std::atomic<size_t>                   queued_;
+        //! tasks submitted but not finished
+        std::atomic<size_t>                   pending_;
+        std::atomic<size_t>                   nextWorker_;
+        bool                                  stop_;
+        std::mutex                            sleepMutex_;
+        std::condition_variable               workAvailable_;
+        std::mutex                            doneMutex_;
+        std::condition_variable               allDone_;
+
+        std::mutex                            errorMutex_;
+        std::exception_ptr                    error_;
+        //! the pool that owns this, set before any task is submitted
+        ThreadPool                          * owner_;
+};
+
+namespace
+{
+
+//! The pool and worker index of the calling thread, if it is a worker.
+thread_local const void * currentPool   = nullptr;
+thread_local size_t       currentWorker = 0;
+
+}   // namespace
+
+ThreadPool::Impl::Impl(size_t numThreads) : queued_(0), pending_(0), nextWorker_(0), stop_(false), owner_(nullptr)
+{
+    if (numThreads == 0)
+    {
+        numThreads = hardwareThreads();
+    }
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        workers_.emplace_back(new Worker);
+    }
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        threads_.emplace_back(&Impl::work_, this, i);
+    }
+}
+
+ThreadPool::Impl::~Impl()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    workAvailable_.notify_all();
+    for (std::thread &thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::Impl::push_(size_t worker, Task task)
+{
+    ++pending_;
+    {
+        std::lock_guard<std::mutex> lock(workers_[worker]->mutex);
+        workers_[worker]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++queued_;
+    }
+    workAvailable_.notify_one();
+}
+
+bool ThreadPool::Impl::pop_own_(size_t self, Task * task)
+{
+    Worker                     &worker = *workers_[self];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+    *task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::Impl::steal_(size_t self, Task * task)
+{
+    for (size_t i = 1; i < workers_.size(); ++i)
+    {
+        Worker                     &victim = *workers_[(self + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            *task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Impl::finish_task_()
+{
+    if (--pending_ == 0)
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        allDone_.notify_all();
+    }
+}
+
+void ThreadPool::Impl::work_(size_t self)
+{
+    currentPool   = this;
+    currentWorker = self;
+    while (true)
+    {
+        Task task;
+        if (pop_own_(self, &task) || steal_(self, &task))
+        {
+            --queued_;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+            }
+            finish_task_();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        workAvailable_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0)
+        {
+            return;
+        }
+    }
+}
+
+/*******************************************************************************
+ * ThreadPool
+ */
+
+ThreadPool::ThreadPool(size_t numThreads) : impl_(new Impl(numThreads))
+{
+    impl_->owner_ = this;
+}
+
+ThreadPool::~ThreadPool()
+{
+    // finish all work before Impl stops the workers, errors can no longer be reported
+    std::unique_lock<std::mutex> lock(impl_->doneMutex_);
+    impl_->allDone_.wait(lock, [this] { return impl_->pending_ == 0; });
+}
+
+void ThreadPool::submit(Task task)
+{
+    Impl &impl = *impl_;
+    if (currentPool == &impl)
+    {
+        impl.push_(currentWorker, std::move(task));
+    }
+    else
+    {
+        impl.push_(impl.nextWorker_++ % impl.workers_.size(), std::move(task));
+    }
+}
+
+void ThreadPool::wait()
+{
+    {
+        std::unique_lock<std::mutex> lock(impl_->doneMutex_);
+        impl_->allDone_.wait(lock, [this] { return impl_->pending_ == 0; });
+    }
+    std::lock_guard<std::mutex> lock(impl_->errorMutex_);
+    if (impl_->error_)
+    {
+        std::exception_ptr error = impl_->error_;
+        impl_->error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+size_t ThreadPool::numThreads() const
+{
+    return impl_->workers_.size();
+}
+
+ThreadPool * ThreadPool::current()
+{
+    return currentPool != nullptr ? static_cast<const Impl *>(currentPool)->owner_ : nullptr;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Work-stealing thread pool.
+ */
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+/*! \brief Runs tasks on a fixed set of worker threads that steal work from each other.
+ *
+ * Every worker owns a task deque. Tasks submitted from a worker, e.g. the slab tasks
+ * a file task splits into, go to that worker's deque and are run newest first, which
+ * keeps their data in cache. Idle workers steal the oldest tasks of other workers,
+ * so large tasks get split across all threads instead of leaving cores idle.
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    //! Start numThreads workers, zero for all hardware threads.
+    explicit ThreadPool(size_t numThreads = 0);
+    //! Wait for all tasks, then stop the workers.
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &)            = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    //! Queue a task; may be called from within tasks.
+    void submit(Task task);
+    /*! \brief Block until all submitted tasks, including the ones they submit, have finished.
+     *
+     * Rethrows the first exception that escaped a task.
+     */
+    void wait();
+    size_t numThreads() const;
+    //! The pool of which the calling thread is a worker, null on other threads.
+    static ThreadPool * current();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif /* end of include guard: THREADPOOL_H_ */
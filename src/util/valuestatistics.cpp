@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Implements the statistics pass with a vectorized block summary and runtime CPU dispatch.
+ */
+#include "valuestatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "util/parallel.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VALUESTATISTICS_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+//! Values are summarized and binned in blocks that stay in the first level cache.
+constexpr size_t blockValues_c = 4096;
+
+//! Values per task when accumulating in parallel.
+constexpr size_t chunkValues_c = 1 << 20;
+
+//! Number of interleaved copies of the histogram.
+constexpr size_t binCopies_c = 4;
+
+struct BlockSummary
+{
+    size_t count; //!< number of finite values
+    float  min;
+    float  max;
+    double sum;
+    double sumSquares;
+};
+
+void summarize_scalar(const float * values, size_t count, BlockSummary * summary)
+{
+    BlockSummary result = { 0, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0, 0 };
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float value = values[i];
+        if (!std::isfinite(value))
+        {
+            continue;
+        }
+        ++result.count;
+        result.min         = std::min(result.min, value);
+        result.max         = std::max(result.max, value);
+        result.sum        += value;
+        result.sumSquares += double(value) * value;
+    }
+    *summary = result;
+}
+
+#ifdef VALUESTATISTICS_HAVE_X86_SIMD
+
+/*! \brief Summarize a block of finite values eight at a time, sums in double precision.
+ *
+ * \returns false if the block holds values that are not finite, which the scalar kernel then skips
+ */
+__attribute__((target("avx2")))
+bool summarize_avx2(const float * values, size_t count, BlockSummary * summary)
+{
+    const __m256 absMask   = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 infinity  = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256       minimum   = infinity;
+    __m256       maximum   = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    __m256       nonFinite = _mm256_setzero_ps();
+    __m256d      sumLow    = _mm256_setzero_pd();
+    __m256d      sumHigh   = _mm256_setzero_pd();
+    __m256d      squaresLow  = _mm256_setzero_pd();
+    __m256d      squaresHigh = _mm256_setzero_pd();
+    size_t       i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256  v    = _mm256_loadu_ps(values + i);
+        // NaN compares unordered, so it is caught together with infinity
+        nonFinite = _mm256_or_ps(nonFinite, _mm256_cmp_ps(_mm256_and_ps(v, absMask), infinity, _CMP_NLT_UQ));
+        minimum   = _mm256_min_ps(minimum, v);
+        maximum   = _mm256_max_ps(maximum, v);
+        const __m256d low  = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        const __m256d high = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        sumLow      = _mm256_add_pd(sumLow, low);
+        sumHigh     = _mm256_add_pd(sumHigh, high);
+        squaresLow  = _mm256_add_pd(squaresLow, _mm256_mul_pd(low, low));
+        squaresHigh = _mm256_add_pd(squaresHigh, _mm256_mul_pd(high, high));
+    }
+    if (_mm256_movemask_ps(nonFinite) != 0)
+    {
+        return false;
+    }
+
+    alignas(32) float  minima[8];
+    alignas(32) float  maxima[8];
+    alignas(32) double sums[4];
+    alignas(32) double squares[4];
+    _mm256_store_ps(minima, minimum);
+    _mm256_store_ps(maxima, maximum);
+    _mm256_store_pd(sums, _mm256_add_pd(sumLow, sumHigh));
+    _mm256_store_pd(squares, _mm256_add_pd(squaresLow, squaresHigh));
+
+    BlockSummary result = { count, minima[0], maxima[0], 0, 0 };
+    for (size_t lane = 0; lane < 8; ++lane)
+    {
+        result.min = std::min(result.min, minima[lane]);
+        result.max = std::max(result.max, maxima[lane]);
+    }
+    for (size_t lane = 0; lane < 4; ++lane)
+    {
+        result.sum        += sums[lane];
+        result.sumSquares += squares[lane];
+    }
+    for (; i < count; ++i)
+    {
+        const float value = values[i];
+        if (!std::isfinite(value))
+        {
+            return false;
+        }
+        result.min         = std::min(result.min, value);
+        result.max         = std::max(result.max, value);
+        result.sum        += value;
+        result.sumSquares += double(value) * value;
+    }
+    *summary = result;
+    return true;
+}
+
+/*! \brief Histogram bin indices of count finite values, four at a time in double precision.
+ *
+ * Values lie above the first bin edge, so truncation rounds down.
+ */
+__attribute__((target("avx2")))
+void bin_indices_avx2(const float * values, size_t count, double scale, double firstBin, int32_t lastBin, int32_t * indices)
+{
+    const __m256d scales  = _mm256_set1_pd(scale);
+    const __m256d offsets = _mm256_set1_pd(firstBin);
+    const __m128i last    = _mm_set1_epi32(lastBin);
+    size_t        i       = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d bins = _mm256_sub_pd(_mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(values + i)), scales), offsets);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices + i), _mm_min_epi32(_mm256_cvttpd_epi32(bins), last));
+    }
+    for (; i < count; ++i)
+    {
+        indices[i] = std::min(int32_t(values[i] * scale - firstBin), lastBin);
+    }
+}
+
+#endif
+
+void bin_indices_scalar(const float * values, size_t count, double scale, double firstBin, int32_t lastBin, int32_t * indices)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        indices[i] = std::min(int32_t(values[i] * scale - firstBin), lastBin);
+    }
+}
+
+typedef bool (*SummaryKernel)(const float *, size_t, BlockSummary *);
+
+SummaryKernel select_kernel()
+{
+#ifdef VALUESTATISTICS_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return &summarize_avx2;
+    }
+#endif
+    return nullptr;
+}
+
+void summarize_block(const float * values, size_t count, BlockSummary * summary)
+{
+    static const SummaryKernel kernel = select_kernel();
+    if (kernel == nullptr || !kernel(values, count, summary))
+    {
+        summarize_scalar(values, count, summary);
+    }
+}
+
+typedef void (*BinKernel)(const float *, size_t, double, double, int32_t, int32_t *);
+
+BinKernel select_bin_kernel()
+{
+#ifdef VALUESTATISTICS_HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return &bin_indices_avx2;
+    }
+#endif
+    return &bin_indices_scalar;
+}
+
+//! Bin indices of count finite values, clamped to lastBin against rounding at the upper edge.
+void bin_indices(const float * values, size_t count, double scale, double firstBin, int32_t lastBin, int32_t * indices)
+{
+    static const BinKernel kernel = select_bin_kernel();
+    kernel(values, count, scale, firstBin, lastBin, indices);
+}
+
+/*! \brief Bin width exponent for a first block of values in [lower, upper].
+ *
+ * Bins are at least a 2^-40th of the largest magnitude, so bin indices stay exact in double precision.
+ */
+int initial_bin_exponent(float lower, float upper, bool integerValues)
+{
+    const double range     = double(upper) - double(lower);
+    const double magnitude = std::max(std::fabs(double(lower)), std::fabs(double(upper)));
+    int          exponent  = 0;
+    if (range > 0)
+    {
+        exponent = std::ilogb(range / ValueStatistics::histogramBins_c);
+    }
+    else if (magnitude > 0)
+    {
+        exponent = std::ilogb(magnitude) - 10;
+    }
+    if (magnitude > 0)
+    {
+        exponent = std::max(exponent, std::ilogb(magnitude) - 40);
+    }
+    if (integerValues)
+    {
+        exponent = std::max(exponent, 0);
+    }
+    return exponent;
+}
+
+}   // namespace
+
+const size_t ValueStatistics::histogramBins_c;
+
+ValueStatistics::ValueStatistics(bool integerValues) :
+    integerValues_(integerValues), count_(0), numNonFinite_(0),
+    min_(std::numeric_limits<float>::infinity()), max_(-std::numeric_limits<float>::infinity()),
+    mean_(0), m2_(0), binExponent_(0), firstBin_(0), bins_(binCopies_c * histogramBins_c, 0)
+{
+}
+
+void ValueStatistics::add(const void * values, DataFormat format, size_t count)
+{
+    if (format == DataFormat::FLOAT32)
+    {
+        add(static_cast<const float *>(values), count);
+        return;
+    }
+    const char * bytes      = static_cast<const char *>(values);
+    const size_t valueBytes = formatBytes(format);
+    float        block[blockValues_c];
+    for (size_t first = 0; first < count; first += blockValues_c)
+    {
+        const size_t blockCount = std::min(blockValues_c, count - first);
+        toFloat(bytes + first * valueBytes, format, block, blockCount);
+        add_block_(block, blockCount);
+    }
+}
+
+void ValueStatistics::add(const float * values, size_t count)
+{
+    for (size_t first = 0; first < count; first += blockValues_c)
+    {
+        add_block_(values + first, std::min(blockValues_c, count - first));
+    }
+}
+
+void ValueStatistics::add_block_(const float * values, size_t count)
+{
+    BlockSummary summary;
+    summarize_block(values, count, &summary);
+    numNonFinite_ += count - summary.count;
+    if (summary.count == 0)
+    {
+        return;
+    }
+
+    cover_(summary.min, summary.max, std::numeric_limits<int>::min());
+    const double scale   = std::ldexp(1.0, -binExponent_);
+    const int32_t lastBin = int32_t(histogramBins_c - 1);
+    if (summary.count == count)
+    {
+        int32_t indices[blockValues_c];
+        bin_indices(values, count, scale, firstBin_, lastBin, indices);
+        // consecutive values count into different copies of the histogram, so equal values do not wait on each other
+        size_t i = 0;
+        for (; i + binCopies_c <= count; i += binCopies_c)
+        {
+            for (size_t copy = 0; copy < binCopies_c; ++copy)
+            {
+                ++bins_[copy * histogramBins_c + indices[i + copy]];
+            }
+        }
+        for (; i < count; ++i)
+        {
+            ++bins_[indices[i]];
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (std::isfinite(values[i]))
+            {
+                int32_t bin;
+                bin_indices(values + i, 1, scale, firstBin_, lastBin, &bin);
+                ++bins_[bin];
+            }
+        }
+    }
+
+    // combine mean and squared deviations as in Chan et al.
+    const double blockCount = double(summary.count);
+    const double blockMean  = summary.sum / blockCount;
+    const double blockM2    = std::max(summary.sumSquares - summary.sum * blockMean, 0.0);
+    const double total      = double(count_) + blockCount;
+    const double delta      = blockMean - mean_;
+    mean_   += delta * blockCount / total;
+    m2_     += blockM2 + delta * delta * double(count_) * blockCount / total;
+    count_  += summary.count;
+    min_     = std::min(min_, summary.min);
+    max_     = std::max(max_, summary.max);
+}
+
+void ValueStatistics::merge(const ValueStatistics &other)
+{
+    if (other.count_ == 0)
+    {
+        numNonFinite_ += other.numNonFinite_;
+        return;
+    }
+    if (count_ == 0)
+    {
+        const uint64_t numNonFinite = numNonFinite_ + other.numNonFinite_;
+        *this         = other;
+        numNonFinite_ = numNonFinite;
+        return;
+    }
+
+    cover_(other.min_, other.max_, other.binExponent_);
+    const std::vector<uint64_t> otherBins = other.merged_bins_();
+    const double                scale     = std::ldexp(1.0, other.binExponent_ - binExponent_);
+    for (size_t i = 0; i < histogramBins_c; ++i)
+    {
+        if (otherBins[i] != 0)
+        {
+            const size_t bin = size_t(std::floor((other.firstBin_ + i) * scale) - firstBin_);
+            bins_[std::min(bin, histogramBins_c - 1)] += otherBins[i];
+        }
+    }
+
+    const double total = double(count_) + double(other.count_);
+    const double delta = other.mean_ - mean_;
+    mean_         += delta * double(other.count_) / total;
+    m2_           += other.m2_ + delta * delta * double(count_) * double(other.count_) / total;
+    count_        += other.count_;
+    numNonFinite_ += other.numNonFinite_;
+    min_           = std::min(min_, other.min_);
+    max_           = std::max(max_, other.max_);
+}
+
+void ValueStatistics::cover_(float lower, float upper, int minExponent)
+{
+    int exponent;
+    if (count_ > 0)
+    {
+        lower    = std::min(lower, min_);
+        upper    = std::max(upper, max_);
+        exponent = std::max(binExponent_, minExponent);
+    }
+    else
+    {
+        exponent = std::max(initial_bin_exponent(lower, upper, integerValues_), minExponent);
+    }
+    while (std::floor(std::ldexp(double(upper), -exponent)) - std::floor(std::ldexp(double(lower), -exponent)) >= histogramBins_c)
+    {
+        ++exponent;
+    }
+    const double firstBin = std::floor(std::ldexp(double(lower), -exponent));
+    if (count_ == 0)
+    {
+        binExponent_ = exponent;
+        firstBin_    = firstBin;
+    }
+    else if (exponent != binExponent_ || firstBin != firstBin_)
+    {
+        rebin_(exponent, firstBin);
+    }
+}
+
+void ValueStatistics::rebin_(int exponent, double firstBin)
+{
+    const std::vector<uint64_t> merged = merged_bins_();
+    std::vector<uint64_t>       bins(binCopies_c * histogramBins_c, 0);
+    const double                scale = std::ldexp(1.0, binExponent_ - exponent);
+    for (size_t i = 0; i < histogramBins_c; ++i)
+    {
+        if (merged[i] != 0)
+        {
+            const size_t bin = size_t(std::floor((firstBin_ + i) * scale) - firstBin);
+            bins[std::min(bin, histogramBins_c - 1)] += merged[i];
+        }
+    }
+    bins_.swap(bins);
+    binExponent_ = exponent;
+    firstBin_    = firstBin;
+}
+
+std::vector<uint64_t> ValueStatistics::merged_bins_() const
+{
+    std::vector<uint64_t> merged(bins_.begin(), bins_.begin() + histogramBins_c);
+    for (size_t copy = 1; copy < binCopies_c; ++copy)
+    {
+        for (size_t i = 0; i < histogramBins_c; ++i)
+        {
+            merged[i] += bins_[copy * histogramBins_c + i];
+        }
+    }
+    return merged;
+}
+
+double ValueStatistics::rms() const
+{
+    return count_ > 0 ? std::sqrt(m2_ / double(count_)) : 0;
+}
+
+double ValueStatistics::binWidth() const
+{
+    return std::ldexp(1.0, binExponent_);
+}
+
+double ValueStatistics::histogramLower() const
+{
+    const std::vector<uint64_t> bins  = merged_bins_();
+    const size_t                first = std::find_if(bins.begin(), bins.end(), [](uint64_t n) { return n != 0; }) - bins.begin();
+    return (firstBin_ + double(first)) * binWidth();
+}
+
+std::vector<uint64_t> ValueStatistics::histogram() const
+{
+    const std::vector<uint64_t> bins     = merged_bins_();
+    auto                        occupied = [](uint64_t n) { return n != 0; };
+    auto                        first    = std::find_if(bins.begin(), bins.end(), occupied);
+    if (first == bins.end())
+    {
+        return std::vector<uint64_t>();
+    }
+    auto last = std::find_if(bins.rbegin(), bins.rend(), occupied).base();
+    return std::vector<uint64_t>(first, last);
+}
+
+ValueStatistics computeStatistics(const void * values, DataFormat format, size_t count, size_t numThreads)
+{
+    const bool                   integerValues = isIntegerFormat(format);
+    const char                 * bytes         = static_cast<const char *>(values);
+    const size_t                 numChunks     = (count + chunkValues_c - 1) / chunkValues_c;
+    std::vector<ValueStatistics> partial(numChunks, ValueStatistics(integerValues));
+    parallelFor(numChunks, [&](size_t chunk) {
+            const size_t first = chunk * chunkValues_c;
+            partial[chunk].add(bytes + first * formatBytes(format), format, std::min(chunkValues_c, count - first));
+        }, numThreads);
+
+    ValueStatistics result(integerValues);
+    for (const ValueStatistics &part : partial)
+    {
+        result.merge(part);
+    }
+    return result;
+}
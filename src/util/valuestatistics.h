@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \file
+ * \brief
+ * Single-pass statistics and histogram of voxel values.
+ */
+
+#ifndef VALUESTATISTICS_H_
+#define VALUESTATISTICS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "util/dataformat.h"
+
+/*! \brief Minimum, maximum, mean, rms deviation and histogram of values seen in any order.
+ *
+ * Statistics of parts of a volume merge exactly, so parts may be accumulated on different threads.
+ * Values that are not finite are counted but otherwise ignored.
+ *
+ * The histogram has histogramBins_c bins whose width is a power of two and whose edges
+ * are multiples of the width. When new values fall outside, the width doubles and pairs
+ * of bins merge, so the histogram never needs a second pass and stays exact for the
+ * final bin width.
+ */
+class ValueStatistics
+{
+public:
+    static const size_t histogramBins_c = 1024;
+
+    //! Values of integer formats get bins at least one wide.
+    explicit ValueStatistics(bool integerValues = false);
+
+    //! Accumulate count native-endian values of the given format.
+    void add(const void * values, DataFormat format, size_t count);
+    //! Accumulate count float values.
+    void add(const float * values, size_t count);
+    //! Accumulate the values seen by other.
+    void merge(const ValueStatistics &other);
+
+    //! Number of finite values seen.
+    uint64_t count() const { return count_; }
+    //! Number of infinite or NaN values seen.
+    uint64_t numNonFinite() const { return numNonFinite_; }
+    float min() const { return min_; }
+    float max() const { return max_; }
+    double mean() const { return mean_; }
+    //! Root mean square deviation from the mean, the rms of the mrc header.
+    double rms() const;
+
+    //! Width of the histogram bins.
+    double binWidth() const;
+    //! Lower edge of the first occupied bin.
+    double histogramLower() const;
+    //! Counts from the first to the last occupied bin.
+    std::vector<uint64_t> histogram() const;
+
+private:
+    //! Accumulate up to blockValues_c finite or non-finite values.
+    void add_block_(const float * values, size_t count);
+    //! Widen and shift the histogram so it covers all values in [lower, upper] with bins at least 2^minExponent wide.
+    void cover_(float lower, float upper, int minExponent);
+    //! Move the counts to bins of width 2^exponent starting at bin firstBin of that width.
+    void rebin_(int exponent, double firstBin);
+    //! Sum of the interleaved copies of the histogram.
+    std::vector<uint64_t> merged_bins_() const;
+
+    bool                  integerValues_;
+    uint64_t              count_;
+    uint64_t              numNonFinite_;
+    float                 min_;
+    float                 max_;
+    double                mean_;
+    double                m2_;         //!< sum of squared deviations from the mean
+    int                   binExponent_;
+    double                firstBin_;   //!< lower edge of the first bin in multiples of the bin width
+    std::vector<uint64_t> bins_;       //!< interleaved copies of the histogram, summed when read
+};
+
+/*! \brief Statistics of count values of the given format, accumulated in parallel.
+ *
+ * \param[in] numThreads number of threads to use, zero for threadBudget()
+ */
+ValueStatistics computeStatistics(const void * values, DataFormat format, size_t count, size_t numThreads = 0);
+
+#endif /* end of include guard: VALUESTATISTICS_H_ */
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Checks the reordering of column, row, section data to x, y, z order for all MAPC, MAPR, MAPS permutations.
+ *
+ * Each voxel is moved one by one to its x, y, z position as a reference. Grids with unequal, odd
+ * sizes are reordered with every value size on one and on several threads, small ones within a
+ * single tile and larger ones spanning several tiles. Exits with 1 if any result differs.
+ */
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "convert/axisorder.h"
+
+namespace
+{
+
+//! The axes along columns, rows and sections, 0 = x, 1 = y, 2 = z.
+const std::array<std::array<int, 3>, 6> permutations_c = {{
+    {{ 0, 1, 2 }}, {{ 0, 2, 1 }}, {{ 1, 0, 2 }}, {{ 1, 2, 0 }}, {{ 2, 0, 1 }}, {{ 2, 1, 0 }}
+}};
+
+//! Copy every voxel from its column, row, section position to its x, y, z position.
+void reference_reorder(const char * crsData, char * xyzData, const std::array<size_t, 3> &numCrs,
+                       const std::array<int, 3> &crsToXyz, size_t valueBytes)
+{
+    std::array<size_t, 3> gridSize;
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        gridSize[crsToXyz[crs]] = numCrs[crs];
+    }
+    size_t stored = 0;
+    for (size_t s = 0; s < numCrs[2]; ++s)
+    {
+        for (size_t r = 0; r < numCrs[1]; ++r)
+        {
+            for (size_t c = 0; c < numCrs[0]; ++c, ++stored)
+            {
+                std::array<size_t, 3> xyz;
+                xyz[crsToXyz[0]] = c;
+                xyz[crsToXyz[1]] = r;
+                xyz[crsToXyz[2]] = s;
+                const size_t index = xyz[0] + gridSize[0] * (xyz[1] + gridSize[1] * xyz[2]);
+                std::memcpy(xyzData + index * valueBytes, crsData + stored * valueBytes, valueBytes);
+            }
+        }
+    }
+}
+
+//! The number of permutations for which reorderToXyz() differs from the reference.
+size_t check_grid(const std::array<size_t, 3> &numCrs, size_t valueBytes, size_t numThreads)
+{
+    const size_t      numBytes = numCrs[0] * numCrs[1] * numCrs[2] * valueBytes;
+    std::vector<char> crsData(numBytes);
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        // distinct bytes within each value, so swapped or misplaced bytes show
+        crsData[i] = char(i * 131 + i / 251);
+    }
+    size_t numFailed = 0;
+    for (const std::array<int, 3> &crsToXyz : permutations_c)
+    {
+        std::vector<char> expected(numBytes);
+        std::vector<char> reordered(numBytes);
+        reference_reorder(crsData.data(), expected.data(), numCrs, crsToXyz, valueBytes);
+        reorderToXyz(crsData.data(), reordered.data(), numCrs, crsToXyz, valueBytes, numThreads);
+        if (reordered != expected)
+        {
+            fprintf(stderr, "%zu x %zu x %zu grid of %zu-byte values with MAPC, MAPR, MAPS %d, %d, %d differs on %zu threads\n",
+                    numCrs[0], numCrs[1], numCrs[2], valueBytes, crsToXyz[0] + 1, crsToXyz[1] + 1, crsToXyz[2] + 1, numThreads);
+            ++numFailed;
+        }
+    }
+    return numFailed;
+}
+
+}   // namespace
+
+int main()
+{
+    const std::array<std::array<size_t, 3>, 3> grids = {{ {{ 5, 3, 4 }}, {{ 1, 7, 2 }}, {{ 131, 67, 9 }} }};
+    size_t numFailed = 0;
+    for (const std::array<size_t, 3> &numCrs : grids)
+    {
+        size_t failed = 0;
+        for (size_t valueBytes : { 1, 2, 4, 8 })
+        {
+            for (size_t numThreads : { 1, 3 })
+            {
+                failed += check_grid(numCrs, valueBytes, numThreads);
+            }
+        }
+        printf("%zu x %zu x %zu grids in all axis orders: %s\n", numCrs[0], numCrs[1], numCrs[2], failed == 0 ? "ok" : "FAILED");
+        numFailed += failed;
+    }
+    return numFailed == 0 ? 0 : 1;
+}
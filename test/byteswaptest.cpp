@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Checks the byte swap kernels bit for bit against a reference swap.
+ *
+ * Every kernel the machine supports swaps 2, 4 and 8 byte values starting at unaligned
+ * addresses, in lengths that leave tails shorter than a vector register. Kernels the
+ * machine lacks are reported as skipped. Exits with 1 if any result differs.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "util/byteswap.h"
+
+namespace
+{
+
+//! Values per case, up to beyond two 64-byte iterations of the widest kernel for every value size.
+constexpr size_t maxCount_c = 70;
+//! Start addresses up to this many bytes past a 32-byte boundary.
+constexpr size_t maxShift_c = 33;
+
+const char * kernel_name(SwapKernel kernel)
+{
+    switch (kernel)
+    {
+        case SwapKernel::Scalar: return "scalar";
+        case SwapKernel::Ssse3: return "ssse3";
+        case SwapKernel::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+//! Reverse the bytes of each value one by one.
+void reference_swap(unsigned char * data, size_t count, size_t valueSize)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        unsigned char * value = data + i * valueSize;
+        for (size_t b = 0; b < valueSize / 2; ++b)
+        {
+            std::swap(value[b], value[valueSize - 1 - b]);
+        }
+    }
+}
+
+//! The number of cases in which the kernel differs from the reference swap.
+size_t check_kernel(SwapKernel kernel, size_t valueSize)
+{
+    size_t numFailed = 0;
+    // guard bytes around the values show writes past either end
+    std::vector<unsigned char> buffer(maxShift_c + maxCount_c * 8 + 64);
+    std::vector<unsigned char> expected(buffer.size());
+    for (size_t shift = 0; shift <= maxShift_c; ++shift)
+    {
+        for (size_t count = 0; count <= maxCount_c; ++count)
+        {
+            for (size_t i = 0; i < buffer.size(); ++i)
+            {
+                buffer[i] = static_cast<unsigned char>(i * 131 + shift * 7 + count);
+            }
+            // align the start of the buffer to 32 bytes, then shift it
+            const size_t misalignment = reinterpret_cast<uintptr_t>(buffer.data()) % 32;
+            const size_t start        = (32 - misalignment) % 32 + shift;
+            expected = buffer;
+            reference_swap(expected.data() + start, count, valueSize);
+            swapBytesWith(kernel, buffer.data() + start, count, valueSize);
+            if (buffer != expected)
+            {
+                fprintf(stderr, "%s kernel differs for %zu values of %zu bytes starting %zu bytes past a 32-byte boundary\n",
+                        kernel_name(kernel), count, valueSize, shift);
+                ++numFailed;
+            }
+        }
+    }
+    return numFailed;
+}
+
+}   // namespace
+
+int main()
+{
+    size_t numFailed = 0;
+    for (SwapKernel kernel : { SwapKernel::Scalar, SwapKernel::Ssse3, SwapKernel::Avx2 })
+    {
+        if (!swapKernelSupported(kernel))
+        {
+            printf("%s kernel not supported on this machine, skipped\n", kernel_name(kernel));
+            continue;
+        }
+        for (size_t valueSize : { 2, 4, 8 })
+        {
+            const size_t failed = check_kernel(kernel, valueSize);
+            printf("%s kernel, %zu-byte values: %s\n", kernel_name(kernel), valueSize, failed == 0 ? "ok" : "FAILED");
+            numFailed += failed;
+        }
+    }
+    return numFailed == 0 ? 0 : 1;
+}
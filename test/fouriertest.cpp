@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Checks the expansion of Fourier maps to the centered frequency grid against a direct transform.
+ *
+ * The discrete Fourier transform of a small real volume is computed term by term and stored
+ * half-complex, with only the non-negative x frequencies, and in full, as complex floats (mode 4)
+ * and complex 16-bit integers (mode 3). Each expanded voxel must hold the component of the
+ * transform at its frequency, so the negative x frequencies of half-complex maps check the
+ * conjugate symmetry. Exits with 1 if any result differs.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "convert/fourier.h"
+#include "mrc/mrcfilewriter.h"
+#include "mrc/mrcheader.h"
+#include "util/posixfile.h"
+
+namespace
+{
+
+typedef std::complex<double> Complex;
+
+//! Voxels along x, y and z of the real volume, even along x as assumed for half-complex maps.
+const std::array<size_t, 3> volumeSize_c = {{ 6, 4, 3 }};
+//! Scale of the values stored as 16-bit integers.
+constexpr double integerScale_c = 100;
+
+long wrapped(long frequency, size_t size)
+{
+    return ((frequency % long(size)) + long(size)) % long(size);
+}
+
+//! A real volume with values in [-1, 1] that have no symmetry.
+std::vector<double> real_volume()
+{
+    std::vector<double> volume(volumeSize_c[0] * volumeSize_c[1] * volumeSize_c[2]);
+    for (size_t i = 0; i < volume.size(); ++i)
+    {
+        volume[i] = std::sin(double(i * i) * 0.7 + 0.3);
+    }
+    return volume;
+}
+
+//! The transform of the volume at frequency kx, ky, kz, summed term by term.
+Complex transform(const std::vector<double> &volume, long kx, long ky, long kz)
+{
+    Complex sum = 0;
+    size_t  i   = 0;
+    for (size_t z = 0; z < volumeSize_c[2]; ++z)
+    {
+        for (size_t y = 0; y < volumeSize_c[1]; ++y)
+        {
+            for (size_t x = 0; x < volumeSize_c[0]; ++x, ++i)
+            {
+                const double turns = double(kx) * x / volumeSize_c[0] + double(ky) * y / volumeSize_c[1] + double(kz) * z / volumeSize_c[2];
+                sum += volume[i] * std::polar(1.0, -2 * M_PI * turns);
+            }
+        }
+    }
+    return sum;
+}
+
+//! Write the transform as stored by real-to-complex transforms, or in full, zero frequency first.
+void write_map(const std::string &filename, const std::vector<double> &volume, MrcHeader::MrcDataMode mode, bool halfComplex)
+{
+    const size_t numColumns = halfComplex ? volumeSize_c[0] / 2 + 1 : volumeSize_c[0];
+    MrcHeader    header;
+    header.setEMDBDefaults();
+    header.mrc_data_mode = int(mode);
+    header.num_crs       = {{ int(numColumns), int(volumeSize_c[1]), int(volumeSize_c[2]) }};
+    header.extend        = header.num_crs;
+    header.cell_length   = {{ float(numColumns), float(volumeSize_c[1]), float(volumeSize_c[2]) }};
+    header.cell_angles   = {{ 90, 90, 90 }};
+    std::vector<float>   floats;
+    std::vector<int16_t> integers;
+    for (size_t kz = 0; kz < volumeSize_c[2]; ++kz)
+    {
+        for (size_t ky = 0; ky < volumeSize_c[1]; ++ky)
+        {
+            for (size_t kx = 0; kx < numColumns; ++kx)
+            {
+                const Complex value = transform(volume, long(kx), long(ky), long(kz));
+                floats.push_back(float(value.real()));
+                floats.push_back(float(value.imag()));
+                integers.push_back(int16_t(std::lround(value.real() * integerScale_c)));
+                integers.push_back(int16_t(std::lround(value.imag() * integerScale_c)));
+            }
+        }
+    }
+    PosixFile               file(filename, PosixFile::Mode::Write);
+    const std::vector<char> headerBytes = mrcHeaderBytes(header, false);
+    file.write(headerBytes.data(), headerBytes.size());
+    if (mode == MrcHeader::MrcDataMode::complexInt32)
+    {
+        file.write(integers.data(), integers.size() * sizeof(int16_t));
+    }
+    else
+    {
+        file.write(floats.data(), floats.size() * sizeof(float));
+    }
+}
+
+//! Collects the streamed values.
+class CollectingSink : public SlabSink
+{
+public:
+    void consume(const Slab & slab) override
+    {
+        const float * data = reinterpret_cast<const float *>(slab.data.data());
+        values.insert(values.end(), data, data + slab.data.size() / sizeof(float));
+    }
+    std::vector<float> values;
+};
+
+//! The expected value of a voxel with the transform value at its frequency.
+double component(const Complex &value, FourierComponent which)
+{
+    switch (which)
+    {
+        case FourierComponent::Amplitude: return std::abs(value);
+        case FourierComponent::Phase: return std::arg(value);
+        case FourierComponent::LogPower: return std::log1p(std::norm(value));
+    }
+    return 0;
+}
+
+//! Equal up to the precision of the float values.
+bool close(double value, double expected, FourierComponent which)
+{
+    const double tolerance = 1e-4;
+    if (which == FourierComponent::Phase)
+    {
+        // phases of -pi and pi are the same
+        return std::abs(std::remainder(value - expected, 2 * M_PI)) <= tolerance;
+    }
+    return std::abs(value - expected) <= tolerance * std::max(1.0, std::abs(expected));
+}
+
+//! The number of voxels of the expanded map that differ from the transform at their frequency.
+size_t check_map(const std::vector<double> &volume, MrcHeader::MrcDataMode mode, bool halfComplex, FourierComponent which)
+{
+    const std::string filename = "fouriertest.mrc";
+    write_map(filename, volume, mode, halfComplex);
+    FourierOptions options;
+    options.component   = which;
+    options.halfComplex = halfComplex;
+    CollectingSink sink;
+    streamFourierMap(filename, options, { &sink }, 2);
+    std::remove(filename.c_str());
+    if (sink.values.size() != volumeSize_c[0] * volumeSize_c[1] * volumeSize_c[2])
+    {
+        return sink.values.size() + 1;
+    }
+
+    size_t numFailed = 0;
+    size_t i         = 0;
+    for (size_t z = 0; z < volumeSize_c[2]; ++z)
+    {
+        for (size_t y = 0; y < volumeSize_c[1]; ++y)
+        {
+            for (size_t x = 0; x < volumeSize_c[0]; ++x, ++i)
+            {
+                // the zero frequency lies at voxel size / 2
+                const long kx = long(x) - long(volumeSize_c[0] / 2);
+                const long ky = long(y) - long(volumeSize_c[1] / 2);
+                const long kz = long(z) - long(volumeSize_c[2] / 2);
+                Complex    value = transform(volume, wrapped(kx, volumeSize_c[0]), wrapped(ky, volumeSize_c[1]), wrapped(kz, volumeSize_c[2]));
+                if (mode == MrcHeader::MrcDataMode::complexInt32)
+                {
+                    // the stored integers are expanded as they are
+                    value = Complex(std::round(value.real() * integerScale_c), std::round(value.imag() * integerScale_c));
+                }
+                if (!close(sink.values[i], component(value, which), which))
+                {
+                    fprintf(stderr, "frequency %ld, %ld, %ld holds %g instead of %g\n", kx, ky, kz, sink.values[i], component(value, which));
+                    ++numFailed;
+                }
+            }
+        }
+    }
+    return numFailed;
+}
+
+}   // namespace
+
+int main()
+{
+    const std::vector<double> volume = real_volume();
+    size_t                    numFailed = 0;
+    for (MrcHeader::MrcDataMode mode : { MrcHeader::MrcDataMode::complexFloat64, MrcHeader::MrcDataMode::complexInt32 })
+    {
+        for (bool halfComplex : { true, false })
+        {
+            for (FourierComponent which : { FourierComponent::Amplitude, FourierComponent::Phase, FourierComponent::LogPower })
+            {
+                const size_t failed = check_map(volume, mode, halfComplex, which);
+                printf("mode %d, %s, %s: %s\n", int(mode), halfComplex ? "half-complex" : "full", fourierComponentName(which),
+                       failed == 0 ? "ok" : "FAILED");
+                numFailed += failed;
+            }
+        }
+    }
+    return numFailed == 0 ? 0 : 1;
+}
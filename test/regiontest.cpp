@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Checks regions of interest: their voxels, the values read for them and the placement of their .dat files.
+ *
+ * Writes small INT16 maps whose values encode their x, y, z position, in standard and permuted axis
+ * order with a nonzero grid start, selects regions in voxels and in Aangstrom and compares the voxels,
+ * the extracted values and the offset and spacing of the description with the values computed by hand.
+ * Exits with 1 if any result differs.
+ */
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "convert/converter.h"
+#include "convert/region.h"
+#include "inviwo/datfile.h"
+#include "mrc/mrcfilewriter.h"
+#include "mrc/mrcgrid.h"
+#include "mrc/mrcheader.h"
+
+namespace
+{
+
+//! Voxels along x, y and z of the test maps.
+const std::array<size_t, 3> gridSize_c = {{ 6, 5, 4 }};
+//! Unit cell of the test maps, for voxel sizes 2, 1 and 2 Aangstrom.
+const std::array<float, 3> cellLength_c = {{ 12, 5, 8 }};
+//! Grid start along x, y and z, placing the first voxel at -2, 2 and 6 Aangstrom.
+const std::array<int, 3> gridStart_c = {{ -1, 2, 3 }};
+
+int16_t value_at(size_t x, size_t y, size_t z)
+{
+    return int16_t(x + 100 * y + 10000 * z);
+}
+
+//! Write a map of gridSize_c voxels with columns, rows and sections along crsToXyz.
+MrcHeader write_map(const std::string &filename, const std::array<int, 3> &crsToXyz)
+{
+    MrcHeader header;
+    header.setEMDBDefaults();
+    header.crs_to_xyz  = crsToXyz;
+    header.cell_length = cellLength_c;
+    header.cell_angles = {{ 90, 90, 90 }};
+    for (size_t crs = 0; crs < 3; ++crs)
+    {
+        header.num_crs[crs]   = int(gridSize_c[crsToXyz[crs]]);
+        header.crs_start[crs] = gridStart_c[crsToXyz[crs]];
+    }
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        header.extend[dim] = int(gridSize_c[dim]);
+    }
+    std::vector<int16_t> values;
+    std::array<size_t, 3> crs;
+    for (crs[2] = 0; crs[2] < size_t(header.num_crs[2]); ++crs[2])
+    {
+        for (crs[1] = 0; crs[1] < size_t(header.num_crs[1]); ++crs[1])
+        {
+            for (crs[0] = 0; crs[0] < size_t(header.num_crs[0]); ++crs[0])
+            {
+                std::array<size_t, 3> xyz;
+                for (size_t axis = 0; axis < 3; ++axis)
+                {
+                    xyz[crsToXyz[axis]] = crs[axis];
+                }
+                values.push_back(value_at(xyz[0], xyz[1], xyz[2]));
+            }
+        }
+    }
+    MrcFileWriter writer(filename, header, DataFormat::INT16);
+    writer.write(values.data(), values.size());
+    writer.finish();
+    return header;
+}
+
+bool same_region(const GridRegion &region, const std::array<size_t, 3> &begin, const std::array<size_t, 3> &size)
+{
+    return region.begin == begin && region.size == size;
+}
+
+//! The number of values of the region that differ from the values encoding their position.
+size_t check_values(const std::string &filename, const GridRegion &region, bool widenToFloat)
+{
+    DataFormat              format;
+    const std::vector<char> data = extractRegion(filename, region, widenToFloat, &format);
+    if (format != (widenToFloat ? DataFormat::FLOAT32 : DataFormat::INT16)
+        || data.size() != region.size[0] * region.size[1] * region.size[2] * formatBytes(format))
+    {
+        return 1;
+    }
+    size_t numFailed = 0;
+    size_t index     = 0;
+    for (size_t z = 0; z < region.size[2]; ++z)
+    {
+        for (size_t y = 0; y < region.size[1]; ++y)
+        {
+            for (size_t x = 0; x < region.size[0]; ++x, ++index)
+            {
+                const double expected = value_at(region.begin[0] + x, region.begin[1] + y, region.begin[2] + z);
+                const double value    = widenToFloat ? reinterpret_cast<const float *>(data.data())[index]
+                                                     : reinterpret_cast<const int16_t *>(data.data())[index];
+                numFailed += value != expected;
+            }
+        }
+    }
+    return numFailed;
+}
+
+//! The number of axes along which the .dat file of the region is sized or placed wrongly.
+size_t check_placement(const MrcHeader &header, const GridRegion &region)
+{
+    // voxel sizes 2, 1, 2 and the first voxel center at -2, 2, 6; the volume corner lies half a voxel before the first center
+    const std::array<float, 3> voxelSize  = {{ 2, 1, 2 }};
+    const std::array<float, 3> firstVoxel = {{ -2, 2, 6 }};
+    const DatFile              datFile    = mrcDatFile(header, DataFormat::FLOAT32, "region.raw", region);
+    size_t                     numFailed  = 0;
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        const float offset = firstVoxel[dim] + (float(region.begin[dim]) - 0.5f) * voxelSize[dim];
+        const float extent = voxelSize[dim] * float(region.size[dim]);
+        numFailed += datFile.resolution[dim] != int(region.size[dim]) || std::abs(datFile.offset[dim] - offset) > 1e-5f
+                     || std::abs(datFile.basis[dim][dim] - extent) > 1e-5f;
+    }
+    return numFailed;
+}
+
+//! The number of failed checks for a map with the given axis order.
+size_t check_map(const std::array<int, 3> &crsToXyz)
+{
+    const std::string filename = "regiontest-" + std::to_string(crsToXyz[0] + 1) + std::to_string(crsToXyz[1] + 1)
+                                 + std::to_string(crsToXyz[2] + 1) + ".mrc";
+    const MrcHeader   header   = write_map(filename, crsToXyz);
+    size_t            numFailed = 0;
+
+    // voxel indices, the upper corner exclusive and clipped to the grid
+    RegionOfInterest voxels;
+    voxels.lower = {{ 1, 2, 1 }};
+    voxels.upper = {{ 4, 100, 3 }};
+    const GridRegion voxelRegion = regionToGrid(voxels, header);
+    if (!same_region(voxelRegion, {{ 1, 2, 1 }}, {{ 3, 3, 2 }}))
+    {
+        fprintf(stderr, "%s: region in voxels selects the wrong voxels\n", filename.c_str());
+        ++numFailed;
+    }
+
+    // voxels with centers inside the box: x centers -2, 0, 2, ..., y centers 2, 3, ..., z centers 6, 8, ...
+    RegionOfInterest angstrom;
+    angstrom.units = RegionOfInterest::Units::Angstrom;
+    angstrom.lower = {{ -1, 3.5f, 5 }};
+    angstrom.upper = {{ 4, 4, 100 }};
+    const GridRegion angstromRegion = regionToGrid(angstrom, header);
+    if (!same_region(angstromRegion, {{ 1, 2, 0 }}, {{ 3, 1, 4 }}))
+    {
+        fprintf(stderr, "%s: region in Aangstrom selects the wrong voxels\n", filename.c_str());
+        ++numFailed;
+    }
+
+    RegionOfInterest outside;
+    outside.lower = {{ 10, 0, 0 }};
+    outside.upper = {{ 20, 1, 1 }};
+    try
+    {
+        regionToGrid(outside, header);
+        fprintf(stderr, "%s: region outside the grid is not rejected\n", filename.c_str());
+        ++numFailed;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+
+    for (const GridRegion &region : { voxelRegion, angstromRegion, mrcFullGrid(header) })
+    {
+        for (bool widenToFloat : { false, true })
+        {
+            if (check_values(filename, region, widenToFloat) != 0)
+            {
+                fprintf(stderr, "%s: wrong values extracted from voxels %zu,%zu,%zu up to %zu,%zu,%zu%s\n", filename.c_str(),
+                        region.begin[0], region.begin[1], region.begin[2], region.begin[0] + region.size[0],
+                        region.begin[1] + region.size[1], region.begin[2] + region.size[2], widenToFloat ? " as float" : "");
+                ++numFailed;
+            }
+        }
+        if (check_placement(header, region) != 0)
+        {
+            fprintf(stderr, "%s: .dat file of voxels %zu,%zu,%zu is sized or placed wrongly\n", filename.c_str(),
+                    region.begin[0], region.begin[1], region.begin[2]);
+            ++numFailed;
+        }
+    }
+    std::remove(filename.c_str());
+    return numFailed;
+}
+
+}   // namespace
+
+int main()
+{
+    size_t numFailed = 0;
+    for (const std::array<int, 3> &crsToXyz : { std::array<int, 3>{{ 0, 1, 2 }}, std::array<int, 3>{{ 2, 0, 1 }},
+                                                std::array<int, 3>{{ 1, 2, 0 }} })
+    {
+        const size_t failed = check_map(crsToXyz);
+        printf("regions of a map with MAPC, MAPR, MAPS %d, %d, %d: %s\n", crsToXyz[0] + 1, crsToXyz[1] + 1, crsToXyz[2] + 1,
+               failed == 0 ? "ok" : "FAILED");
+        numFailed += failed;
+    }
+    return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Checks trilinear resampling of a linear ramp, its size and the placement of its .dat file.
+ *
+ * Linear interpolation reproduces a ramp exactly, and voxels at the border repeat outwards,
+ * so every resampled voxel holds the ramp at its center clamped to the centers of the input.
+ * A region of a larger grid is resampled to a coarser size along x and z and a finer one
+ * along y, and the spacing and offset of its .dat file are compared with the values computed
+ * by hand. Exits with 1 if any result differs.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "convert/resample.h"
+#include "inviwo/datfile.h"
+#include "mrc/mrcheader.h"
+#include "util/posixfile.h"
+
+namespace
+{
+
+//! Voxels along x, y and z of the mrc grid, and the region of it that is resampled.
+const std::array<size_t, 3> gridSize_c    = {{ 16, 11, 12 }};
+const GridRegion            region_c      = {{{ 2, 1, 3 }}, {{ 12, 9, 7 }}};
+//! Input voxel sizes 1.5, 1 and 2 Aangstrom.
+const std::array<float, 3>  inputSize_c   = {{ 1.5f, 1.0f, 2.0f }};
+//! Grid start, which places the first voxel of the grid at 3, -3 and 2 Aangstrom.
+const std::array<int, 3>    gridStart_c   = {{ 2, -3, 1 }};
+//! Target voxel sizes, coarser along x and z and finer along y.
+const std::array<float, 3>  outputSize_c  = {{ 2.25f, 0.75f, 3.0f }};
+//! Resampled voxels, as many of the target size as fit the region best.
+const std::array<size_t, 3> expectedSize_c = {{ 8, 12, 5 }};
+
+//! The ramp at voxel index x, y, z of the region, fractional between voxels.
+double ramp(double x, double y, double z)
+{
+    return 0.5 + 1.25 * x - 0.75 * y + 2.0 * z;
+}
+
+MrcHeader grid_header()
+{
+    MrcHeader header;
+    header.setEMDBDefaults();
+    header.cell_angles = {{ 90, 90, 90 }};
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        header.num_crs[dim]     = int(gridSize_c[dim]);
+        header.extend[dim]      = int(gridSize_c[dim]);
+        header.cell_length[dim] = inputSize_c[dim] * float(gridSize_c[dim]);
+        header.crs_start[dim]   = gridStart_c[dim];
+    }
+    return header;
+}
+
+//! Hand the ramp over the region to the writer in slabs of two sections.
+void feed_ramp(ResampleWriter * writer)
+{
+    const std::array<size_t, 3> &size = region_c.size;
+    Slab                         slab;
+    slab.index  = 0;
+    slab.format = DataFormat::FLOAT32;
+    for (size_t first = 0; first < size[2]; first += 2, ++slab.index)
+    {
+        slab.firstSection = first;
+        slab.numSections  = std::min<size_t>(2, size[2] - first);
+        std::vector<float> values;
+        for (size_t z = first; z < first + slab.numSections; ++z)
+        {
+            for (size_t y = 0; y < size[1]; ++y)
+            {
+                for (size_t x = 0; x < size[0]; ++x)
+                {
+                    values.push_back(float(ramp(double(x), double(y), double(z))));
+                }
+            }
+        }
+        slab.data.assign(reinterpret_cast<const char *>(values.data()), reinterpret_cast<const char *>(values.data() + values.size()));
+        writer->consume(slab);
+    }
+    writer->finish();
+}
+
+//! Center of resampled voxel j in input voxel indices, clamped to the input voxels.
+double input_position(size_t j, size_t dim)
+{
+    const double center = (double(j) + 0.5) * outputSize_c[dim] / inputSize_c[dim] - 0.5;
+    return std::min(std::max(center, 0.0), double(region_c.size[dim] - 1));
+}
+
+//! The number of resampled voxels that differ from the ramp at their center.
+size_t check_values(const std::string &rawFileName)
+{
+    const size_t       numVoxels = expectedSize_c[0] * expectedSize_c[1] * expectedSize_c[2];
+    const PosixFile    file(rawFileName, PosixFile::Mode::Read);
+    std::vector<float> values(numVoxels);
+    if (file.size() != numVoxels * sizeof(float))
+    {
+        fprintf(stderr, "%s holds %zu bytes instead of %zu\n", rawFileName.c_str(), file.size(), numVoxels * sizeof(float));
+        return 1;
+    }
+    file.readAt(values.data(), file.size(), 0);
+    size_t numFailed = 0;
+    size_t i         = 0;
+    for (size_t z = 0; z < expectedSize_c[2]; ++z)
+    {
+        for (size_t y = 0; y < expectedSize_c[1]; ++y)
+        {
+            for (size_t x = 0; x < expectedSize_c[0]; ++x, ++i)
+            {
+                const double expected = ramp(input_position(x, 0), input_position(y, 1), input_position(z, 2));
+                if (std::abs(values[i] - expected) > 1e-4 * std::max(1.0, std::abs(expected)))
+                {
+                    fprintf(stderr, "resampled voxel %zu, %zu, %zu holds %g instead of %g\n", x, y, z, values[i], expected);
+                    ++numFailed;
+                }
+            }
+        }
+    }
+    return numFailed;
+}
+
+//! The number of axes along which the .dat file is sized or placed wrongly.
+size_t check_description(const std::string &datFileName)
+{
+    // the first voxel of the grid is centered at 3, -3, 2; the resampled box starts at the corner of the region
+    const std::array<float, 3> firstVoxel = {{ 3, -3, 2 }};
+    const DatFile              datFile    = DatFile::read(datFileName);
+    size_t                     numFailed  = datFile.format != "FLOAT32";
+    for (size_t dim = 0; dim < 3; ++dim)
+    {
+        const float offset = firstVoxel[dim] + (float(region_c.begin[dim]) - 0.5f) * inputSize_c[dim];
+        const float extent = outputSize_c[dim] * float(expectedSize_c[dim]);
+        if (datFile.resolution[dim] != int(expectedSize_c[dim]) || std::abs(datFile.offset[dim] - offset) > 1e-4f
+            || std::abs(datFile.basis[dim][dim] - extent) > 1e-4f)
+        {
+            fprintf(stderr, "axis %zu of %s: %d voxels spanning %g from %g instead of %zu spanning %g from %g\n", dim,
+                    datFileName.c_str(), datFile.resolution[dim], datFile.basis[dim][dim], datFile.offset[dim], expectedSize_c[dim],
+                    extent, offset);
+            ++numFailed;
+        }
+    }
+    return numFailed;
+}
+
+}   // namespace
+
+int main()
+{
+    const std::string baseName = "resampletest";
+    size_t            numFailed = 0;
+    {
+        ResampleWriter writer(grid_header(), region_c, DataFormat::FLOAT32, baseName, outputSize_c, ResampleWriter::Filter::Trilinear);
+        numFailed += writer.size() != expectedSize_c;
+        printf("size of the resampled volume: %s\n", writer.size() == expectedSize_c ? "ok" : "FAILED");
+        feed_ramp(&writer);
+    }
+    const size_t failedValues = check_values(baseName + ".resampled.raw");
+    printf("trilinear resampling of a ramp: %s\n", failedValues == 0 ? "ok" : "FAILED");
+    const size_t failedDescription = check_description(baseName + ".resampled.dat");
+    printf("spacing and offset of the .dat file: %s\n", failedDescription == 0 ? "ok" : "FAILED");
+    std::remove((baseName + ".resampled.raw").c_str());
+    std::remove((baseName + ".resampled.dat").c_str());
+    return numFailed + failedValues + failedDescription == 0 ? 0 : 1;
+}
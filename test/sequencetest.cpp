@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026
+ * inviwo-convert is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * inviwo-convert is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with inviwo-convert; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ */
+/*! \internal \file
+ * \brief
+ * Checks how the sections of image stacks, volume stacks and single volumes divide into sequences.
+ *
+ * Covers explicit volume counts and sizes, the split taken from the space group and MZ of the
+ * header, the rejection of uneven splits and of single volumes without a count or size, and the
+ * names of the volume files. Exits with 1 if any result differs.
+ */
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "convert/sequence.h"
+#include "mrc/mrcheader.h"
+
+namespace
+{
+
+//! Sentinel for splits that must be rejected.
+constexpr size_t rejected_c = 0;
+
+MrcHeader stack_header(int spaceGroup, int numSections, int mz)
+{
+    MrcHeader header;
+    header.setEMDBDefaults();
+    header.space_group = spaceGroup;
+    header.num_crs     = {{ 8, 8, numSections }};
+    header.extend      = {{ 8, 8, mz }};
+    return header;
+}
+
+//! True if the split has the expected sections per volume, or is rejected if rejected_c is expected.
+bool check_split(const char * description, const MrcHeader &header, size_t numVolumes, size_t sectionsPerVolume, size_t expected)
+{
+    SequenceOptions options;
+    options.numVolumes        = numVolumes;
+    options.sectionsPerVolume = sectionsPerVolume;
+    size_t result = rejected_c;
+    try
+    {
+        const SequenceLayout layout = sequenceLayout(header, options);
+        result = layout.sectionsPerVolume;
+        if (layout.numSections != size_t(header.num_crs[2]) || layout.numVolumes() * layout.sectionsPerVolume != layout.numSections)
+        {
+            fprintf(stderr, "%s: the volumes do not cover the sections\n", description);
+            return false;
+        }
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    const bool ok = result == expected;
+    printf("%s: %s\n", description, ok ? "ok" : "FAILED");
+    if (!ok)
+    {
+        fprintf(stderr, "%s: %zu sections per volume instead of %zu (0 = rejected)\n", description, result, expected);
+    }
+    return ok;
+}
+
+bool check_name(const SequenceLayout &layout, size_t volume, const std::string &expected)
+{
+    const std::string name = sequenceVolumeName("base", layout, volume);
+    const bool        ok   = name == expected;
+    printf("name of volume %zu of %zu: %s\n", volume, layout.numVolumes(), ok ? "ok" : "FAILED");
+    if (!ok)
+    {
+        fprintf(stderr, "volume %zu of %zu is named %s instead of %s\n", volume, layout.numVolumes(), name.c_str(), expected.c_str());
+    }
+    return ok;
+}
+
+}   // namespace
+
+int main()
+{
+    const MrcHeader imageStack  = stack_header(0, 12, 1);
+    const MrcHeader volumeStack = stack_header(401, 12, 4);
+    const MrcHeader volume      = stack_header(1, 12, 12);
+    size_t          numFailed   = 0;
+
+    numFailed += !check_split("image stack, auto", imageStack, 0, 0, 1);
+    numFailed += !check_split("volume stack, auto", volumeStack, 0, 0, 4);
+    numFailed += !check_split("volume stack with MZ beyond its sections, auto", stack_header(401, 12, 20), 0, 0, 12);
+    numFailed += !check_split("volume stack with MZ not dividing its sections, auto", stack_header(401, 12, 5), 0, 0, rejected_c);
+    numFailed += !check_split("volume stack without MZ, auto", stack_header(401, 12, 0), 0, 0, 12);
+    numFailed += !check_split("single volume, auto", volume, 0, 0, rejected_c);
+    numFailed += !check_split("single volume with MZ below its sections, auto", stack_header(1, 12, 3), 0, 0, rejected_c);
+    numFailed += !check_split("single volume, 3 volumes", volume, 3, 0, 4);
+    numFailed += !check_split("single volume, 5 volumes", volume, 5, 0, rejected_c);
+    numFailed += !check_split("single volume, 6 sections each", volume, 0, 6, 6);
+    numFailed += !check_split("single volume, 5 sections each", volume, 0, 5, rejected_c);
+    numFailed += !check_split("single volume, more sections than it holds", volume, 0, 20, 12);
+    numFailed += !check_split("volume stack, sections overriding MZ", volumeStack, 0, 2, 2);
+    numFailed += !check_split("file without sections", stack_header(0, 0, 0), 0, 0, rejected_c);
+
+    SequenceLayout layout;
+    layout.numSections       = 12;
+    layout.sectionsPerVolume = 1;
+    numFailed += !check_name(layout, 7, "base.007");
+    layout.numSections = 1500;
+    numFailed += !check_name(layout, 42, "base.0042");
+    return numFailed == 0 ? 0 : 1;
+}